@@ -0,0 +1,901 @@
+//
+//  AssociationMultiplexer.swift
+//  Dicom
+//
+//  Created by hanjongwoo on 10/19/26.
+//
+
+import Foundation
+import Darwin
+
+enum SocketError: Error {
+    case system(String, Int32)
+}
+
+enum Sockets {
+    static func setNonBlocking(_ fd: Int32) {
+        _ = fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK)
+        var on: Int32 = 1
+        setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &on, socklen_t(MemoryLayout<Int32>.size))
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, socklen_t(MemoryLayout<Int32>.size))
+    }
+
+    static func listen(port: Int) throws -> Int32 {
+        let fd = socket(AF_INET, SOCK_STREAM, 0)
+        guard fd >= 0 else {
+            throw SocketError.system("socket", errno)
+        }
+        var on: Int32 = 1
+        setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, socklen_t(MemoryLayout<Int32>.size))
+        var address = sockaddr_in()
+        address.sin_len = UInt8(MemoryLayout<sockaddr_in>.size)
+        address.sin_family = sa_family_t(AF_INET)
+        address.sin_port = in_port_t(UInt16(port).bigEndian)
+        address.sin_addr = in_addr(s_addr: INADDR_ANY)
+        let bound = withUnsafePointer(to: &address) {
+            $0.withMemoryRebound(to: sockaddr.self, capacity: 1) { bind(fd, $0, socklen_t(MemoryLayout<sockaddr_in>.size)) }
+        }
+        guard bound == 0, Darwin.listen(fd, SOMAXCONN) == 0 else {
+            let error = errno
+            close(fd)
+            throw SocketError.system("bind/listen", error)
+        }
+        setNonBlocking(fd)
+        return fd
+    }
+
+    // 블로킹 연결 (벤치마크 클라이언트용)
+    static func connect(node: String, port: Int) throws -> Int32 {
+        let fd = socket(AF_INET, SOCK_STREAM, 0)
+        guard fd >= 0 else {
+            throw SocketError.system("socket", errno)
+        }
+        var address = sockaddr_in()
+        address.sin_len = UInt8(MemoryLayout<sockaddr_in>.size)
+        address.sin_family = sa_family_t(AF_INET)
+        address.sin_port = in_port_t(UInt16(port).bigEndian)
+        inet_pton(AF_INET, node, &address.sin_addr)
+        let connected = withUnsafePointer(to: &address) {
+            $0.withMemoryRebound(to: sockaddr.self, capacity: 1) { Darwin.connect(fd, $0, socklen_t(MemoryLayout<sockaddr_in>.size)) }
+        }
+        guard connected == 0 else {
+            let error = errno
+            close(fd)
+            throw SocketError.system("connect", error)
+        }
+        var on: Int32 = 1
+        setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &on, socklen_t(MemoryLayout<Int32>.size))
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, socklen_t(MemoryLayout<Int32>.size))
+        return fd
+    }
+
+    static let maxVectors = 1024 // IOV_MAX
+
+    // 블로킹 소켓에 iovec 묶음을 모두 씀 (부분 쓰기면 남은 곳부터 다시). 부른 writev 횟수를 돌려줌
+    static func writeAll(_ fd: Int32, _ vectors: UnsafeMutableBufferPointer<iovec>) throws -> Int {
+        var index = 0, calls = 0
+        while index < vectors.count {
+            let count = Darwin.writev(fd, vectors.baseAddress! + index, Int32(min(vectors.count - index, maxVectors)))
+            calls += 1
+            if count < 0 {
+                if errno == EINTR { continue }
+                throw SocketError.system("writev", errno)
+            }
+            var written = count
+            while index < vectors.count && written >= vectors[index].iov_len {
+                written -= vectors[index].iov_len
+                index += 1
+            }
+            if written > 0 {
+                vectors[index].iov_base = vectors[index].iov_base.map { $0 + written }
+                vectors[index].iov_len -= written
+            }
+        }
+        return calls
+    }
+}
+
+// 연결마다 스레드를 두지 않고, 적은 수의 kqueue 이벤트 루프가 많은 연결을 함께 처리하는 SCP
+// 루프 스레드는 소켓 읽기/쓰기, PDU 파싱, 연결 협상만 하고 완성된 DIMSE 메시지는 워커 큐로 넘김
+// 대부분 놀고 있는 장비 연결 수백 개를 스레드 몇 개로 유지하기 위한 것
+final class AssociationMultiplexer {
+    struct Configuration {
+        var aeTitle = "DICOM"
+        var port = 11113
+        var eventLoops = 2
+        var workers = 4
+        var maxPDULength: UInt32 = 65536
+        var maxPerformedOperations: UInt16 = 16 // 한 연결에서 응답 전에 받아 둘 수 있는 요청 수
+        var maxBufferedPayloadBytes = 4 << 20   // 스트리밍 수신 시 디스크에 아직 쓰지 못한 바이트가 이보다 많으면 읽기를 멈춤
+        var abstractSyntaxes = StorageSCP.storageSOPClasses + [WellKnownUID.string(for: WellKnownUID.verification)]
+        var transferSyntaxes = StorageSCP.transferSyntaxes
+    }
+
+    struct NegotiatedContext {
+        let abstractSyntax: String
+        let transferSyntax: String
+        let callingAET: String
+    }
+
+    struct Statistics {
+        var acceptedConnections = 0
+        var activeConnections = 0
+        var dispatchedMessages = 0
+    }
+
+    // 워커 큐에서 호출됨: 요청 메시지를 처리하고 응답 명령(과 데이터셋)을 돌려줌
+    typealias Handler = (DimseMessage, NegotiatedContext) -> (command: DimseCommandSet, dataSet: [UInt8]?)
+
+    // 데이터셋을 메모리에 모으지 않고 받는 쪽 (append/finish/abort는 연결의 워커 큐에서 순서대로 호출됨)
+    struct PayloadStream {
+        let append: (ArraySlice<UInt8>) -> Void
+        let finish: () -> UInt16 // 응답 상태
+        let abort: () -> Void
+    }
+
+    // 데이터셋이 따라오는 명령마다 루프에서 호출됨. nil이면 그 데이터셋은 기존처럼 모아서 handler로 넘김
+    typealias PayloadStreamFactory = (DimseCommandSet, NegotiatedContext) -> PayloadStream?
+
+    // C-ECHO에 응답하고 C-STORE는 onStore가 돌려준 상태로 응답하는 기본 처리기
+    static func storageHandler(onStore: @escaping (DimseMessage, NegotiatedContext) -> UInt16 = { _, _ in 0 }) -> Handler {
+        return { message, context in
+            switch message.command.command {
+            case DimseCommandSet.cEchoRequest:
+                return (DimseCommandSet.response(to: message.command, status: 0), nil)
+            case DimseCommandSet.cStoreRequest:
+                return (DimseCommandSet.response(to: message.command, status: onStore(message, context)), nil)
+            default:
+                return (DimseCommandSet.response(to: message.command, status: 0x0211), nil) // 인식할 수 없는 연산
+            }
+        }
+    }
+
+    let configuration: Configuration
+    let handler: Handler
+    let payloadStreams: PayloadStreamFactory?
+    // 협상 때 문자열 대신 비교하는 공유 UID 테이블 핸들
+    let abstractSyntaxHandles: Set<UIDHandle>
+    let transferSyntaxHandles: [UIDHandle]
+    // 한 연결의 메시지는 항상 같은 워커 큐로 가므로 응답 순서가 요청 순서와 같음
+    private let workers: [DispatchQueue]
+    private var loops: [EventLoop] = []
+    private var listenFD: Int32 = -1
+    private let lock = NSLock()
+    private var statistics = Statistics()
+    private var nextConnectionID: UInt64 = 0
+
+    init(configuration: Configuration, handler: @escaping Handler = AssociationMultiplexer.storageHandler(),
+         payloadStreams: PayloadStreamFactory? = nil) {
+        self.configuration = configuration
+        self.handler = handler
+        self.payloadStreams = payloadStreams
+        abstractSyntaxHandles = Set(configuration.abstractSyntaxes.map { UIDTable.shared.intern($0) })
+        transferSyntaxHandles = configuration.transferSyntaxes.map { UIDTable.shared.intern($0) }
+        workers = (0..<max(1, configuration.workers)).map {
+            DispatchQueue(label: "AssociationMultiplexer.worker.\($0)", qos: .userInitiated)
+        }
+    }
+
+    var currentStatistics: Statistics {
+        lock.lock()
+        defer { lock.unlock() }
+        return statistics
+    }
+
+    func start() throws {
+        listenFD = try Sockets.listen(port: configuration.port)
+        loops = try (0..<max(1, configuration.eventLoops)).map { try EventLoop(owner: self, index: $0) }
+        loops.forEach { $0.start() }
+        let fd = listenFD, first = loops[0]
+        first.execute {
+            first.watchListener(fd)
+        }
+    }
+
+    // 루프 스레드가 모두 끝날 때까지 기다림 (처리기나 스트림 콜백 안에서 부르면 안 됨)
+    func stop() {
+        loops.forEach { $0.stop() }
+        loops.forEach { $0.join() }
+        loops = []
+        if listenFD >= 0 {
+            close(listenFD)
+            listenFD = -1
+        }
+    }
+
+    // 받아들인 소켓을 루프들에 돌아가며 배정
+    fileprivate func adopt(_ fd: Int32) {
+        let (id, loop) = locked { () -> (UInt64, EventLoop) in
+            nextConnectionID += 1
+            statistics.acceptedConnections += 1
+            statistics.activeConnections += 1
+            return (nextConnectionID, loops[Int(nextConnectionID % UInt64(loops.count))])
+        }
+        loop.execute {
+            loop.register(Connection(fd: fd, id: id, configuration: self.configuration,
+                                     worker: self.workers[Int(id % UInt64(self.workers.count))]))
+        }
+    }
+
+    fileprivate func update(_ body: (inout Statistics) -> Void) {
+        locked { body(&statistics) }
+    }
+
+    private func locked<Result>(_ body: () -> Result) -> Result {
+        lock.lock()
+        defer { lock.unlock() }
+        return body()
+    }
+}
+
+// 루프 스레드에서만 접근하는 연결 상태
+private final class Connection {
+    let fd: Int32
+    let id: UInt64
+    let worker: DispatchQueue
+    var parser: PDUParser
+    var assembler = DimseAssembler()
+    var output: [UInt8] = []
+    var outputOffset = 0
+    var writeArmed = false
+    var associated = false
+    var contexts: [UInt8: AssociationMultiplexer.NegotiatedContext] = [:]
+    var peerMaxPDULength = 16384
+    var inFlight = 0
+    var maxOperations = 1 // 협상한 비동기 연산 창 (제안이 없으면 동기: 1)
+    var stream: (stream: AssociationMultiplexer.PayloadStream, command: DimseCommandSet, contextID: UInt8)?
+    var bufferedPayloadBytes = 0
+    var payloadBackpressure = false // 쓰지 못한 바이트가 상한을 넘어 읽기를 멈춘 상태 (절반 아래로 내려가면 풂)
+    var readPaused = false
+    var releaseRequested = false
+    var closeAfterFlush = false
+    var closed = false
+
+    init(fd: Int32, id: UInt64, configuration: AssociationMultiplexer.Configuration, worker: DispatchQueue) {
+        self.fd = fd
+        self.id = id
+        self.worker = worker
+        parser = PDUParser(maxBodyLength: Int(configuration.maxPDULength) + 1024)
+    }
+}
+
+// 다중화기가 해제되는 중에도 루프가 안전하도록 다중화기는 약하게 잡고, 설정과 처리기는 복사해 둠
+private final class EventLoop {
+    weak var owner: AssociationMultiplexer?
+    let index: Int
+    private let configuration: AssociationMultiplexer.Configuration
+    private let handler: AssociationMultiplexer.Handler
+    private let payloadStreams: AssociationMultiplexer.PayloadStreamFactory?
+    private let abstractSyntaxHandles: Set<UIDHandle>
+    private let transferSyntaxHandles: [UIDHandle]
+    private let queue: Int32
+    private let lock = NSLock()
+    private let finished = DispatchSemaphore(value: 0)
+    private var tasks: [() -> Void] = []
+    private var running = true
+    private var queueClosed = false // run()이 kqueue를 닫은 뒤 (lock으로 보호)
+    private var listenFD: Int32 = -1
+    private var connections: [Int32: Connection] = [:]
+    private var readBuffer = [UInt8](repeating: 0, count: 64 << 10)
+
+    // 파일 디스크립터가 모자라 accept가 실패하면 이 시간만큼 리스너 감시를 멈춤 (그동안 루프가 헛돌지 않게)
+    private static let acceptRetryMilliseconds = 100
+    private static let acceptRetryTimer: UInt = 1
+
+    init(owner: AssociationMultiplexer, index: Int) throws {
+        self.owner = owner
+        self.index = index
+        configuration = owner.configuration
+        handler = owner.handler
+        payloadStreams = owner.payloadStreams
+        abstractSyntaxHandles = owner.abstractSyntaxHandles
+        transferSyntaxHandles = owner.transferSyntaxHandles
+        queue = kqueue()
+        guard queue >= 0 else {
+            throw SocketError.system("kqueue", errno)
+        }
+        // 다른 스레드에서 작업을 넣을 때 루프를 깨우는 사용자 이벤트
+        change(ident: 0, filter: EVFILT_USER, flags: EV_ADD | EV_CLEAR)
+    }
+
+    func start() {
+        let thread = Thread { [self] in
+            self.run()
+        }
+        thread.name = "AssociationMultiplexer.loop.\(index)"
+        thread.qualityOfService = .userInitiated
+        thread.start()
+    }
+
+    func stop() {
+        execute { [unowned self] in
+            self.running = false
+        }
+    }
+
+    // run()이 끝날 때까지 대기
+    func join() {
+        finished.wait()
+    }
+
+    // 루프 스레드에서 실행할 작업을 넣고 루프를 깨움
+    // 깨우는 kevent는 잠금 안에서 부르므로 run()이 kqueue를 닫는 동안에는 들어오지 않음
+    // 닫은 뒤에 들어온 작업은 버림 (닫힌 번호가 이미 다른 파일에 쓰였을 수 있음)
+    func execute(_ task: @escaping () -> Void) {
+        lock.lock()
+        defer { lock.unlock() }
+        guard !queueClosed else { return }
+        tasks.append(task)
+        change(ident: 0, filter: EVFILT_USER, flags: 0, fflags: NOTE_TRIGGER)
+    }
+
+    func watchListener(_ fd: Int32) {
+        listenFD = fd
+        change(ident: UInt(fd), filter: EVFILT_READ, flags: EV_ADD)
+    }
+
+    func register(_ connection: Connection) {
+        Sockets.setNonBlocking(connection.fd)
+        connections[connection.fd] = connection
+        change(ident: UInt(connection.fd), filter: EVFILT_READ, flags: EV_ADD)
+    }
+
+    private func change(ident: UInt, filter: Int32, flags: Int32, fflags: Int32 = 0, data: Int = 0) {
+        var event = kevent(ident: ident, filter: Int16(filter), flags: UInt16(flags), fflags: UInt32(fflags), data: data, udata: nil)
+        _ = kevent(queue, &event, 1, nil, 0, nil)
+    }
+
+    private func run() {
+        var events = [kevent](repeating: kevent(), count: 64)
+        while running {
+            let count = kevent(queue, nil, 0, &events, Int32(events.count), nil)
+            if count < 0 {
+                if errno == EINTR { continue }
+                break
+            }
+            for event in events[0..<Int(count)] {
+                let fd = Int32(event.ident)
+                switch Int32(event.filter) {
+                case EVFILT_USER:
+                    runTasks()
+                case EVFILT_TIMER where event.ident == EventLoop.acceptRetryTimer:
+                    change(ident: UInt(listenFD), filter: EVFILT_READ, flags: EV_ENABLE)
+                case EVFILT_READ where fd == listenFD:
+                    acceptConnections()
+                case EVFILT_READ:
+                    if let connection = connections[fd] { readable(connection) }
+                case EVFILT_WRITE:
+                    if let connection = connections[fd] {
+                        connection.writeArmed = false
+                        flush(connection)
+                    }
+                default:
+                    break
+                }
+            }
+        }
+        connections.values.forEach { close($0) }
+        lock.lock()
+        queueClosed = true
+        tasks = []
+        Darwin.close(queue)
+        lock.unlock()
+        finished.signal()
+    }
+
+    private func runTasks() {
+        lock.lock()
+        let pending = tasks
+        tasks = []
+        lock.unlock()
+        pending.forEach { $0() }
+    }
+
+    private func acceptConnections() {
+        while true {
+            let fd = accept(listenFD, nil, nil)
+            guard fd >= 0 else {
+                switch errno {
+                case EINTR, ECONNABORTED:
+                    continue
+                case EMFILE, ENFILE, ENOBUFS, ENOMEM:
+                    // 대기 중인 연결이 남아 있어 리스너가 계속 읽기 가능으로 보이므로 잠시 감시를 멈췄다가 다시 시도
+                    change(ident: UInt(listenFD), filter: EVFILT_READ, flags: EV_DISABLE)
+                    change(ident: EventLoop.acceptRetryTimer, filter: EVFILT_TIMER, flags: EV_ADD | EV_ONESHOT,
+                           data: EventLoop.acceptRetryMilliseconds)
+                    return
+                default:
+                    return // EAGAIN: 대기 중인 연결 없음
+                }
+            }
+            guard let owner else {
+                Darwin.close(fd)
+                return
+            }
+            owner.adopt(fd)
+        }
+    }
+
+    private func readable(_ connection: Connection) {
+        // 한 연결이 루프를 독차지하지 않도록 한 번에 몇 번만 읽음 (나머지는 다음 이벤트에서)
+        for _ in 0..<16 {
+            let count = readBuffer.withUnsafeMutableBytes { Darwin.read(connection.fd, $0.baseAddress, $0.count) }
+            if count > 0 {
+                readBuffer.withUnsafeBytes { connection.parser.append(UnsafeRawBufferPointer(rebasing: $0[0..<count])) }
+                if count < readBuffer.count { break }
+            } else if count == 0 {
+                close(connection)
+                return
+            } else if errno == EINTR {
+                continue
+            } else if errno == EAGAIN || errno == EWOULDBLOCK {
+                break
+            } else {
+                close(connection)
+                return
+            }
+        }
+        processPDUs(connection)
+    }
+
+    // 받아 둔 PDU를 처리하되 연산 창이 차면 멈춤 (응답이 나가면 respond에서 이어서 처리)
+    // PDU 하나에 메시지가 여러 개 끝날 수 있으므로 창은 PDU 단위로 확인함
+    private func processPDUs(_ connection: Connection) {
+        do {
+            while !connection.closed && connection.inFlight < connection.maxOperations, let pdu = try connection.parser.next() {
+                try handle(pdu, connection)
+            }
+        } catch {
+            send(AssociationPDU.abort(), to: connection)
+            connection.closeAfterFlush = true
+            flush(connection)
+        }
+        updateReading(connection)
+    }
+
+    // 쓰지 못한 바이트가 너무 많거나 연산 창이 가득 찼으면 소켓 읽기를 멈추고, 둘 다 풀리면 다시 읽음
+    private func updateReading(_ connection: Connection) {
+        let pause = connection.payloadBackpressure || connection.inFlight >= connection.maxOperations
+        guard !connection.closed && pause != connection.readPaused else {
+            return
+        }
+        connection.readPaused = pause
+        change(ident: UInt(connection.fd), filter: EVFILT_READ, flags: pause ? EV_DISABLE : EV_ENABLE)
+    }
+
+    private func handle(_ pdu: PDU, _ connection: Connection) throws {
+        switch pdu.type {
+        case .associateRequest where !connection.associated:
+            negotiate(try AssociationPDU(parsing: pdu.body), connection)
+        case .dataTransfer where connection.associated:
+            for pdv in try PDataTransfer.pdvs(in: pdu.body) {
+                switch try connection.assembler.next(pdv) {
+                case .message(let message)?:
+                    try dispatch(message, connection)
+                case .dataSetCommand(let contextID, let command)?:
+                    if let factory = payloadStreams, let context = connection.contexts[contextID],
+                       let stream = factory(command, context) {
+                        connection.assembler.streamDataSet()
+                        connection.stream = (stream, command, contextID)
+                    }
+                case .dataSetFragment(let bytes, let isLast)?:
+                    streamFragment(bytes, isLast: isLast, connection)
+                case nil:
+                    break
+                }
+            }
+        case .releaseRequest where connection.associated:
+            connection.releaseRequested = true
+            finishReleaseIfIdle(connection)
+        case .abort:
+            close(connection)
+        default:
+            throw PDUError.malformed("unexpected PDU \(pdu.type)")
+        }
+    }
+
+    private func negotiate(_ request: AssociationPDU, _ connection: Connection) {
+        guard request.calledAET == configuration.aeTitle || configuration.aeTitle.isEmpty else {
+            send(AssociationPDU.reject(result: 1, source: 1, reason: 7), to: connection) // 호출된 AE 타이틀 인식 불가
+            connection.closeAfterFlush = true
+            flush(connection)
+            return
+        }
+        // PDV에 데이터를 한 바이트도 실을 수 없는 최대 PDU 길이(1~6)로는 응답을 보낼 수 없으므로 거절함
+        guard PDataTransfer.canFragment(maxPDULength: Int(request.maxPDULength)) else {
+            send(AssociationPDU.reject(result: 1, source: 1, reason: 1), to: connection)
+            connection.closeAfterFlush = true
+            flush(connection)
+            return
+        }
+        var accept = AssociationPDU(calledAET: request.calledAET, callingAET: request.callingAET)
+        accept.maxPDULength = configuration.maxPDULength
+        // 상대가 보낸 UID는 테이블을 늘리지 않고 핸들만 찾아 정수로 비교 (모르는 UID는 받아들이지 않음)
+        let table = UIDTable.shared
+        for proposed in request.presentationContexts {
+            var item = PresentationContextItem(id: proposed.id)
+            if !(table.handle(for: proposed.abstractSyntax).map(abstractSyntaxHandles.contains) ?? false) {
+                item.result = 3
+            } else if let transferSyntax = proposed.transferSyntaxes.first(where: {
+                table.handle(for: $0).map(transferSyntaxHandles.contains) ?? false
+            }) {
+                item.transferSyntaxes = [transferSyntax]
+                connection.contexts[proposed.id] = AssociationMultiplexer.NegotiatedContext(
+                    abstractSyntax: proposed.abstractSyntax, transferSyntax: transferSyntax, callingAET: request.callingAET)
+            } else {
+                item.result = 4
+            }
+            accept.presentationContexts.append(item)
+        }
+        // 상대가 비동기 연산 창을 제안하면 우리가 처리할 수 있는 만큼으로 줄여 돌려줌 (우리는 요청을 보내지 않음)
+        // 제안이 없으면 동기 연산이므로 응답 전에는 다음 요청을 처리하지 않음
+        if let window = request.asyncOperationsWindow {
+            let performed = max(1, window.invoked == 0 ? configuration.maxPerformedOperations
+                                                       : min(window.invoked, configuration.maxPerformedOperations))
+            accept.asyncOperationsWindow = (invoked: 1, performed: performed)
+            connection.maxOperations = Int(performed)
+        }
+        connection.peerMaxPDULength = Int(request.maxPDULength)
+        connection.associated = true
+        send(accept.encoded(as: .associateAccept), to: connection)
+    }
+
+    private func dispatch(_ message: DimseMessage, _ connection: Connection) throws {
+        guard let context = connection.contexts[message.contextID] else {
+            throw PDUError.malformed("unknown presentation context \(message.contextID)")
+        }
+        let handler = self.handler
+        respond(on: message.contextID, connection) {
+            handler(message, context)
+        }
+    }
+
+    // 스트리밍 중인 데이터셋 조각을 워커 큐에서 쓰게 하고, 마지막 조각이면 완료 상태로 응답함
+    // 아직 쓰지 못한 바이트가 상한을 넘으면 쓰기가 따라올 때까지 이 연결의 소켓 읽기를 멈춤
+    private func streamFragment(_ bytes: ArraySlice<UInt8>, isLast: Bool, _ connection: Connection) {
+        guard let active = connection.stream else { return }
+        let count = bytes.count
+        connection.bufferedPayloadBytes += count
+        connection.worker.async { [self] in
+            active.stream.append(bytes)
+            self.execute {
+                connection.bufferedPayloadBytes -= count
+                if connection.payloadBackpressure
+                    && connection.bufferedPayloadBytes <= self.configuration.maxBufferedPayloadBytes / 2 {
+                    connection.payloadBackpressure = false
+                    self.updateReading(connection)
+                }
+            }
+        }
+        if connection.bufferedPayloadBytes > configuration.maxBufferedPayloadBytes && !connection.payloadBackpressure {
+            connection.payloadBackpressure = true
+            updateReading(connection)
+        }
+        if isLast {
+            connection.stream = nil
+            respond(on: active.contextID, connection) {
+                (DimseCommandSet.response(to: active.command, status: active.stream.finish()), nil)
+            }
+        }
+    }
+
+    // 워커 큐에서 응답을 만들고 루프에서 보냄
+    private func respond(on contextID: UInt8, _ connection: Connection,
+                         _ work: @escaping () -> (command: DimseCommandSet, dataSet: [UInt8]?)) {
+        connection.inFlight += 1
+        owner?.update { $0.dispatchedMessages += 1 }
+        let maxPDULength = connection.peerMaxPDULength
+        connection.worker.async { [self] in
+            let response = work()
+            var pdus: [[UInt8]]?
+            do {
+                pdus = try PDataTransfer.encode(contextID: contextID, command: response.command.encoded(),
+                                                dataSet: response.dataSet, maxPDULength: maxPDULength)
+            } catch {
+                print("caught: \(error)")
+            }
+            self.execute {
+                connection.inFlight -= 1
+                guard !connection.closed else { return }
+                guard let pdus else {
+                    self.close(connection)
+                    return
+                }
+                pdus.forEach { self.send($0, to: connection) }
+                // 창에 자리가 났으므로 받아 둔 PDU를 이어서 처리
+                self.processPDUs(connection)
+                self.finishReleaseIfIdle(connection)
+            }
+        }
+    }
+
+    // 해제 요청을 받았고 처리 중인 메시지가 없으면 A-RELEASE-RP를 보내고 닫음
+    private func finishReleaseIfIdle(_ connection: Connection) {
+        guard connection.releaseRequested && connection.inFlight == 0 && !connection.closeAfterFlush else {
+            return
+        }
+        send(AssociationPDU.releaseResponse(), to: connection)
+        connection.closeAfterFlush = true
+        flush(connection)
+    }
+
+    private func send(_ bytes: [UInt8], to connection: Connection) {
+        connection.output.append(contentsOf: bytes)
+        if !connection.writeArmed {
+            flush(connection)
+        }
+    }
+
+    private func flush(_ connection: Connection) {
+        while connection.outputOffset < connection.output.count {
+            let count = connection.output.withUnsafeBytes {
+                Darwin.write(connection.fd, $0.baseAddress! + connection.outputOffset, $0.count - connection.outputOffset)
+            }
+            if count > 0 {
+                connection.outputOffset += count
+            } else if count < 0 && errno == EINTR {
+                continue
+            } else if count < 0 && (errno == EAGAIN || errno == EWOULDBLOCK) {
+                // 소켓 버퍼가 찼으면 쓸 수 있을 때 다시 시도
+                connection.writeArmed = true
+                change(ident: UInt(connection.fd), filter: EVFILT_WRITE, flags: EV_ADD | EV_ONESHOT)
+                return
+            } else {
+                close(connection)
+                return
+            }
+        }
+        connection.output.removeAll(keepingCapacity: false)
+        connection.outputOffset = 0
+        if connection.closeAfterFlush {
+            close(connection)
+        }
+    }
+
+    private func close(_ connection: Connection) {
+        guard !connection.closed else { return }
+        connection.closed = true
+        if let active = connection.stream {
+            connection.stream = nil
+            connection.worker.async { active.stream.abort() } // 받다 만 데이터셋은 버림
+        }
+        connections[connection.fd] = nil
+        Darwin.close(connection.fd) // 닫힌 소켓의 kqueue 등록은 자동으로 사라짐
+        owner?.update { $0.activeConnections -= 1 }
+    }
+}
+
+// 벤치마크에서 쓰는 블로킹 소켓 SCU (PDU 계층을 직접 사용하므로 라이브러리 스레드/객체가 끼지 않음)
+final class SimpleAssociationClient {
+    let fd: Int32 // 모아 쓰기(writev)는 DataSetPDVStream이 이 소켓에 직접 함
+    private var parser = PDUParser(maxBodyLength: 1 << 26)
+    private var assembler = DimseAssembler()
+    private var received: [DimseMessage] = []
+    private var buffer = [UInt8](repeating: 0, count: 16 << 10)
+    private(set) var accepted: AssociationPDU?
+    private var nextMessageID: UInt16 = 0
+
+    init(node: String = "127.0.0.1", port: Int) throws {
+        fd = try Sockets.connect(node: node, port: port)
+    }
+
+    deinit {
+        close(fd)
+    }
+
+    // 추상 구문마다 표현 컨텍스트를 하나씩 제안 (ID는 1, 3, 5, ...)
+    func associate(callingAET: String, calledAET: String, abstractSyntaxes: [String],
+                   transferSyntaxes: [String] = [WellKnownUID.string(for: WellKnownUID.implicitVRLittleEndian)],
+                   maxPDULength: UInt32 = 16384, asyncOperationsWindow: (invoked: UInt16, performed: UInt16)? = nil) throws {
+        var request = AssociationPDU(calledAET: calledAET, callingAET: callingAET)
+        request.maxPDULength = maxPDULength
+        request.asyncOperationsWindow = asyncOperationsWindow
+        request.presentationContexts = abstractSyntaxes.enumerated().map {
+            PresentationContextItem(id: UInt8($0.offset * 2 + 1), abstractSyntax: $0.element, transferSyntaxes: transferSyntaxes)
+        }
+        try write(request.encoded(as: .associateRequest))
+        let pdu = try receivePDU()
+        guard pdu.type == .associateAccept else {
+            throw PDUError.malformed("association rejected")
+        }
+        let accepted = try AssociationPDU(parsing: pdu.body)
+        guard PDataTransfer.canFragment(maxPDULength: Int(accepted.maxPDULength)) else {
+            throw PDUError.malformed("maximum PDU length \(accepted.maxPDULength) too small")
+        }
+        self.accepted = accepted
+    }
+
+    func contextID(for abstractSyntax: String, proposed abstractSyntaxes: [String]) -> UInt8? {
+        guard let index = abstractSyntaxes.firstIndex(of: abstractSyntax) else { return nil }
+        let id = UInt8(index * 2 + 1)
+        return accepted?.presentationContexts.first(where: { $0.id == id && $0.result == 0 })?.id
+    }
+
+    func send(contextID: UInt8, command: DimseCommandSet, dataSet: [UInt8]? = nil) throws {
+        let maxPDULength = Int(accepted?.maxPDULength ?? 16384)
+        for pdu in try PDataTransfer.encode(contextID: contextID, command: command.encoded(), dataSet: dataSet, maxPDULength: maxPDULength) {
+            try write(pdu)
+        }
+    }
+
+    func receive() throws -> DimseMessage {
+        while received.isEmpty {
+            let pdu = try receivePDU()
+            guard pdu.type == .dataTransfer else {
+                throw PDUError.malformed("unexpected PDU \(pdu.type)")
+            }
+            for pdv in try PDataTransfer.pdvs(in: pdu.body) {
+                if let message = try assembler.append(pdv) {
+                    received.append(message)
+                }
+            }
+        }
+        return received.removeFirst()
+    }
+
+    func makeMessageID() -> UInt16 {
+        nextMessageID &+= 1
+        return nextMessageID
+    }
+
+    // C-ECHO 한 번 (응답 상태를 돌려줌)
+    func echo(contextID: UInt8) throws -> UInt16 {
+        let verification = WellKnownUID.string(for: WellKnownUID.verification)
+        try send(contextID: contextID, command: DimseCommandSet.request(
+            DimseCommandSet.cEchoRequest, messageID: makeMessageID(), sopClassUID: verification, hasDataSet: false))
+        return try receive().command.uint16(DimseCommandSet.status) ?? 0xFFFF
+    }
+
+    func release() throws {
+        try write(AssociationPDU.releaseRequest())
+        _ = try receivePDU()
+    }
+
+    func write(_ bytes: [UInt8]) throws {
+        var offset = 0
+        while offset < bytes.count {
+            let count = bytes.withUnsafeBytes { Darwin.write(fd, $0.baseAddress! + offset, $0.count - offset) }
+            if count < 0 {
+                if errno == EINTR { continue }
+                throw SocketError.system("write", errno)
+            }
+            offset += count
+        }
+    }
+
+    func receivePDU() throws -> PDU {
+        while true {
+            if let pdu = try parser.next() {
+                return pdu
+            }
+            let count = buffer.withUnsafeMutableBytes { Darwin.read(fd, $0.baseAddress, $0.count) }
+            if count < 0 && errno == EINTR {
+                continue
+            }
+            guard count > 0 else {
+                throw SocketError.system("read", count == 0 ? ECONNRESET : errno)
+            }
+            buffer.withUnsafeBytes { parser.append(UnsafeRawBufferPointer(rebasing: $0[0..<count])) }
+        }
+    }
+}
+
+// 연결 처리 방식별 연결당 메모리와 C-ECHO 응답 시간 분포
+struct MultiplexerMeasurement {
+    var model = ""
+    var idleAssociations = 0
+    var threadsPerConnection = 0.0
+    var bytesPerConnection = 0.0
+    var echoes = 0
+    var p50Milliseconds = 0.0
+    var p99Milliseconds = 0.0
+    var maxMilliseconds = 0.0
+}
+
+enum MultiplexerBenchmark {
+    // 놀고 있는 연결 idleAssociations개를 열어 둔 채로, probeClients개의 연결이 C-ECHO를 반복해 응답 시간을 잼
+    // 연결당 메모리는 연결을 열기 전후의 phys_footprint 차이 (클라이언트는 소켓만 쓰므로 대부분 서버 몫)
+    static func run(idleAssociations: [Int] = [16, 64, 256], probeClients: Int = 4, echoesPerClient: Int = 500,
+                    port: Int = 11114) -> [MultiplexerMeasurement] {
+        var results: [MultiplexerMeasurement] = []
+        for idle in idleAssociations {
+            let directory = FileManager.default.temporaryDirectory
+            let blocking = StorageSCP(configuration: StorageSCP.Configuration(
+                port: port, directory: directory, maxAssociations: idle + probeClients))
+            results.append(measure(model: "thread-per-association", idle: idle, probeClients: probeClients,
+                                   echoes: echoesPerClient, port: port,
+                                   start: { try blocking.start() }, stop: { blocking.stop() }))
+
+            let multiplexer = AssociationMultiplexer(configuration: AssociationMultiplexer.Configuration(port: port + 1))
+            results.append(measure(model: "kqueue multiplexer", idle: idle, probeClients: probeClients,
+                                   echoes: echoesPerClient, port: port + 1,
+                                   start: { try multiplexer.start() }, stop: { multiplexer.stop() }))
+        }
+        return results
+    }
+
+    private static func measure(model: String, idle: Int, probeClients: Int, echoes: Int, port: Int,
+                                start: () throws -> Void, stop: () -> Void) -> MultiplexerMeasurement {
+        var result = MultiplexerMeasurement(model: model, idleAssociations: idle)
+        let verification = WellKnownUID.string(for: WellKnownUID.verification)
+        do {
+            try start()
+        } catch {
+            print("caught: \(error)")
+            return result
+        }
+        defer { stop() }
+
+        let footprintBefore = physicalFootprint()
+        let threadsBefore = threadCount()
+        var idleClients: [SimpleAssociationClient] = []
+        for i in 0..<idle {
+            do {
+                let client = try SimpleAssociationClient(port: port)
+                try client.associate(callingAET: "IDLE\(i)", calledAET: "DICOM", abstractSyntaxes: [verification])
+                idleClients.append(client)
+            } catch {
+                print("caught: \(error)")
+            }
+        }
+        Thread.sleep(forTimeInterval: 0.2) // 서버 쪽 스레드/버퍼가 자리잡을 때까지
+        if !idleClients.isEmpty {
+            result.bytesPerConnection = Double(physicalFootprint() - footprintBefore) / Double(idleClients.count)
+            result.threadsPerConnection = Double(threadCount() - threadsBefore) / Double(idleClients.count)
+        }
+
+        let lock = NSLock()
+        var latencies: [Double] = []
+        DispatchQueue.concurrentPerform(iterations: probeClients) { index in
+            var local: [Double] = []
+            do {
+                let client = try SimpleAssociationClient(port: port)
+                try client.associate(callingAET: "PROBE\(index)", calledAET: "DICOM", abstractSyntaxes: [verification])
+                guard let contextID = client.contextID(for: verification, proposed: [verification]) else { return }
+                for _ in 0..<echoes {
+                    let begin = DispatchTime.now().uptimeNanoseconds
+                    _ = try client.echo(contextID: contextID)
+                    local.append(Double(DispatchTime.now().uptimeNanoseconds - begin) / 1e6)
+                }
+                try client.release()
+            } catch {
+                print("caught: \(error)")
+            }
+            lock.lock()
+            latencies += local
+            lock.unlock()
+        }
+        idleClients.forEach { try? $0.release() }
+
+        latencies.sort()
+        result.echoes = latencies.count
+        if !latencies.isEmpty {
+            result.p50Milliseconds = latencies[latencies.count / 2]
+            result.p99Milliseconds = latencies[min(latencies.count - 1, latencies.count * 99 / 100)]
+            result.maxMilliseconds = latencies[latencies.count - 1]
+        }
+        return result
+    }
+
+    static func physicalFootprint() -> Int {
+        var info = task_vm_info_data_t()
+        var count = mach_msg_type_number_t(MemoryLayout<task_vm_info_data_t>.size / MemoryLayout<natural_t>.size)
+        let result = withUnsafeMutablePointer(to: &info) {
+            $0.withMemoryRebound(to: integer_t.self, capacity: Int(count)) {
+                task_info(mach_task_self_, task_flavor_t(TASK_VM_INFO), $0, &count)
+            }
+        }
+        return result == KERN_SUCCESS ? Int(info.phys_footprint) : 0
+    }
+
+    private static func threadCount() -> Int {
+        var threads: thread_act_array_t?
+        var count: mach_msg_type_number_t = 0
+        guard task_threads(mach_task_self_, &threads, &count) == KERN_SUCCESS, let threads else {
+            return 0
+        }
+        vm_deallocate(mach_task_self_, vm_address_t(UInt(bitPattern: threads)),
+                      vm_size_t(Int(count) * MemoryLayout<thread_t>.stride))
+        return Int(count)
+    }
+}
@@ -0,0 +1,292 @@
+//
+//  AssociationPool.swift
+//  Dicom
+//
+//  Created by hanjongwoo on 10/19/26.
+//
+
+import Foundation
+
+// 연결할 상대와 제안할 표현 컨텍스트 묶음 (풀의 키)
+struct AssociationTarget: Hashable {
+    var node = "127.0.0.1"
+    var port = 11112
+    var callingAET = "DICOMAPP"
+    var calledAET = "DICOM"
+    var abstractSyntaxes = StorageSCP.storageSOPClasses
+    var transferSyntaxes = StorageSCP.transferSyntaxes
+    var maxInvokedOperations: UInt32 = 1
+    var dimseTimeoutSeconds: UInt32 = 30
+
+    // C-ECHO 검사를 위해 Verification은 항상 넣음
+    func presentationContexts() -> DicomheroPresentationContexts {
+        let contexts = DicomheroPresentationContexts()
+        let verification = WellKnownUID.string(for: WellKnownUID.verification)
+        for abstractSyntax in abstractSyntaxes + (abstractSyntaxes.contains(verification) ? [] : [verification]) {
+            let context = DicomheroPresentationContext(abstractSyntax: abstractSyntax)
+            transferSyntaxes.forEach { context.addTransferSyntax($0) }
+            contexts.addPresentationContext(context)
+        }
+        return contexts
+    }
+}
+
+// 풀에서 빌려 쓰는 연결 하나 (스트림, 연결, DIMSE 서비스를 함께 들고 있음)
+final class PooledAssociation {
+    let target: AssociationTarget
+    let association: DicomheroAssociationSCU
+    let service: DicomheroDimseService
+    private let stream: DicomheroTCPStream
+    fileprivate var idleSince: UInt64 = 0
+
+    fileprivate init(target: AssociationTarget) throws {
+        self.target = target
+        stream = try DicomheroTCPStream(address: DicomheroTCPActiveAddress(node: target.node, service: String(target.port)))
+        association = try DicomheroAssociationSCU(
+            thisAET: target.callingAET, otherAET: target.calledAET,
+            maxInvokedOperations: target.maxInvokedOperations, maxPerformedOperations: 1,
+            presentationContexts: target.presentationContexts(),
+            reader: DicomheroStreamReader(inputStream: stream.getStreamInput()),
+            writer: DicomheroStreamWriter(outputStream: stream.getStreamOutput()),
+            dimseTimeoutSeconds: target.dimseTimeoutSeconds)
+        service = DicomheroDimseService(association: association)
+    }
+
+    fileprivate func echo() -> Bool {
+        let verification = WellKnownUID.string(for: WellKnownUID.verification)
+        let command = DicomheroCEchoCommand(abstractSyntax: verification, messageID: service.getNextCommandID(),
+                                            priority: .medium, affectedSopClassUid: verification)
+        do {
+            try service.sendCommandOrResponse(command)
+            return try service.getCEchoResponse(command).status == .success
+        } catch {
+            return false
+        }
+    }
+
+    fileprivate func release() {
+        do {
+            try association.release()
+        } catch {
+            try? association.abort()
+        }
+    }
+}
+
+// SCU 연결 풀: 상대/AE/표현 컨텍스트가 같은 요청에는 놀고 있는 연결을 다시 내줌
+// 한동안 놀던 연결은 내주기 전에 C-ECHO로 살아 있는지 확인하고, idleTimeout이 지나면 해제함
+final class AssociationPool {
+    struct Configuration {
+        var idleTimeout: TimeInterval = 30
+        var validateAfter: TimeInterval = 5 // 이보다 오래 놀던 연결만 C-ECHO로 확인
+        var maxIdlePerTarget = 8
+    }
+
+    struct Statistics {
+        var opened = 0
+        var reused = 0
+        var validations = 0
+        var validationFailures = 0
+        var expired = 0
+        var discarded = 0
+    }
+
+    let configuration: Configuration
+    private let lock = NSLock()
+    private var idle: [AssociationTarget: [PooledAssociation]] = [:]
+    private var statistics = Statistics()
+    private let reaper: DispatchSourceTimer
+
+    init(configuration: Configuration = Configuration()) {
+        self.configuration = configuration
+        reaper = DispatchSource.makeTimerSource(queue: DispatchQueue(label: "AssociationPool.reaper", qos: .utility))
+        let interval = max(1, configuration.idleTimeout / 2)
+        reaper.schedule(deadline: .now() + interval, repeating: interval)
+        reaper.setEventHandler { [weak self] in
+            self?.releaseExpired()
+        }
+        reaper.resume()
+    }
+
+    deinit {
+        reaper.cancel()
+        idle.values.joined().forEach { $0.release() }
+    }
+
+    var currentStatistics: Statistics {
+        lock.lock()
+        defer { lock.unlock() }
+        return statistics
+    }
+
+    // 가장 최근에 돌려받은 연결부터 내줌 (오래 논 연결은 확인하거나 만료되게 둠)
+    func checkout(_ target: AssociationTarget) throws -> PooledAssociation {
+        while let candidate = takeIdle(target) {
+            let idleSeconds = Double(DispatchTime.now().uptimeNanoseconds - candidate.idleSince) / 1e9
+            if idleSeconds < configuration.validateAfter {
+                update { $0.reused += 1 }
+                return candidate
+            }
+            let alive = candidate.echo()
+            update {
+                $0.validations += 1
+                if alive {
+                    $0.reused += 1
+                } else {
+                    $0.validationFailures += 1
+                }
+            }
+            if alive {
+                return candidate
+            }
+            candidate.release()
+        }
+        let association = try PooledAssociation(target: target)
+        update { $0.opened += 1 }
+        return association
+    }
+
+    // 오류가 났던 연결은 healthy: false로 돌려주면 풀에 넣지 않고 끊음
+    func checkin(_ association: PooledAssociation, healthy: Bool = true) {
+        association.idleSince = DispatchTime.now().uptimeNanoseconds
+        lock.lock()
+        var list = idle[association.target, default: []]
+        let keep = healthy && list.count < configuration.maxIdlePerTarget
+        if keep {
+            list.append(association)
+            idle[association.target] = list
+        } else {
+            statistics.discarded += 1
+        }
+        lock.unlock()
+        if !keep {
+            association.release()
+        }
+    }
+
+    // 빌려서 body를 실행하고 돌려줌 (body가 던지면 그 연결은 버림)
+    func with<Result>(_ target: AssociationTarget, _ body: (PooledAssociation) throws -> Result) throws -> Result {
+        let association = try checkout(target)
+        do {
+            let result = try body(association)
+            checkin(association)
+            return result
+        } catch {
+            checkin(association, healthy: false)
+            throw error
+        }
+    }
+
+    // 놀고 있는 연결을 모두 해제
+    func drain() {
+        lock.lock()
+        let all = idle.values.joined()
+        idle.removeAll()
+        lock.unlock()
+        all.forEach { $0.release() }
+    }
+
+    private func takeIdle(_ target: AssociationTarget) -> PooledAssociation? {
+        lock.lock()
+        defer { lock.unlock() }
+        return idle[target]?.popLast()
+    }
+
+    private func releaseExpired() {
+        let now = DispatchTime.now().uptimeNanoseconds, timeout = UInt64(configuration.idleTimeout * 1e9)
+        guard now > timeout else { return }
+        let deadline = now - timeout
+        var expired: [PooledAssociation] = []
+        lock.lock()
+        for (target, list) in idle {
+            expired += list.filter { $0.idleSince < deadline }
+            idle[target] = list.filter { $0.idleSince >= deadline }
+        }
+        statistics.expired += expired.count
+        lock.unlock()
+        expired.forEach { $0.release() }
+    }
+
+    private func update(_ body: (inout Statistics) -> Void) {
+        lock.lock()
+        body(&statistics)
+        lock.unlock()
+    }
+}
+
+struct AssociationPoolMeasurement {
+    var model = ""
+    var studies = 0
+    var stored = 0
+    var seconds = 0.0
+    var statistics = AssociationPool.Statistics()
+
+    var studiesPerSecond: Double { seconds > 0 ? Double(studies) / seconds : 0 }
+}
+
+enum AssociationPoolBenchmark {
+    // 작은 검사(instancesPerStudy장) studies개를 검사마다 새 연결로 보낼 때와 풀의 연결로 보낼 때를 비교
+    static func run(urls: [URL], studies: Int = 500, instancesPerStudy: Int = 3, clients: Int = 4,
+                    port: Int = 11122) -> [AssociationPoolMeasurement] {
+        let instances = StorageLoadGenerator.load(urls: urls)
+        guard !instances.isEmpty else { return [] }
+        let scp = AssociationMultiplexer(configuration: AssociationMultiplexer.Configuration(port: port))
+        do {
+            try scp.start()
+        } catch {
+            print("caught: \(error)")
+            return []
+        }
+        defer { scp.stop() }
+        let target = AssociationTarget(port: port, calledAET: scp.configuration.aeTitle)
+
+        func measure(model: String, pool: AssociationPool?) -> AssociationPoolMeasurement {
+            var measurement = AssociationPoolMeasurement(model: model, studies: studies)
+            let lock = NSLock()
+            let start = DispatchTime.now().uptimeNanoseconds
+            DispatchQueue.concurrentPerform(iterations: clients) { client in
+                let localPool = pool ?? AssociationPool()
+                var stored = 0
+                for study in stride(from: client, to: studies, by: clients) {
+                    do {
+                        stored += try localPool.with(target) { association in
+                            try (0..<instancesPerStudy).reduce(0) { count, i in
+                                try count + (send(instances[(study * instancesPerStudy + i) % instances.count], association) ? 1 : 0)
+                            }
+                        }
+                    } catch {
+                        print("caught: \(error)")
+                    }
+                    if pool == nil {
+                        localPool.drain() // 검사마다 연결을 새로 여는 기존 방식
+                    }
+                }
+                lock.lock()
+                measurement.stored += stored
+                if pool == nil {
+                    measurement.statistics.opened += localPool.currentStatistics.opened
+                }
+                lock.unlock()
+            }
+            measurement.seconds = Double(DispatchTime.now().uptimeNanoseconds - start) / 1e9
+            if let pool {
+                measurement.statistics = pool.currentStatistics
+                pool.drain()
+            }
+            return measurement
+        }
+
+        return [measure(model: "association per study", pool: nil),
+                measure(model: "pooled associations", pool: AssociationPool())]
+    }
+
+    private static func send(_ instance: StorageLoadGenerator.Instance, _ association: PooledAssociation) throws -> Bool {
+        let service = association.service
+        let command = DicomheroCStoreCommand(
+            abstractSyntax: instance.sopClassUID, messageID: service.getNextCommandID(), priority: .medium,
+            affectedSopClassUid: instance.sopClassUID, affectedSopInstanceUid: instance.sopInstanceUID,
+            originatorAET: "", originatorMessageID: 0, payload: instance.dataSet)
+        try service.sendCommandOrResponse(command)
+        return try service.getCStoreResponse(command).status == .success
+    }
+}
@@ -0,0 +1,304 @@
+//
+//  BulkStoreSender.swift
+//  Dicom
+//
+//  Created by hanjongwoo on 10/19/26.
+//
+
+import Foundation
+
+// 생산자가 채우고 소비자가 꺼내는 크기 제한 버퍼
+// 가득 차면 put이, 비어 있으면 take가 기다림. finish 뒤에는 남은 항목을 다 꺼내면 take가 nil을 돌려줌
+final class BoundedBuffer<Element> {
+    private let condition = NSCondition()
+    private let capacity: Int
+    private var items: [Element] = []
+    private var finished = false
+    private var cancelled = false
+
+    init(capacity: Int) {
+        self.capacity = max(1, capacity)
+    }
+
+    func put(_ item: Element) {
+        condition.lock()
+        defer { condition.unlock() }
+        while items.count >= capacity && !cancelled {
+            condition.wait()
+        }
+        guard !cancelled else { return }
+        items.append(item)
+        condition.broadcast()
+    }
+
+    func take() -> Element? {
+        condition.lock()
+        defer { condition.unlock() }
+        while items.isEmpty && !finished && !cancelled {
+            condition.wait()
+        }
+        guard !items.isEmpty && !cancelled else {
+            return nil
+        }
+        condition.broadcast()
+        return items.removeFirst()
+    }
+
+    // 생산 종료
+    func finish() {
+        condition.lock()
+        finished = true
+        condition.broadcast()
+        condition.unlock()
+    }
+
+    // 소비자가 모두 사라졌을 때: 기다리는 생산자를 풀고 이후 항목은 버림
+    func cancel() {
+        condition.lock()
+        cancelled = true
+        items.removeAll()
+        condition.broadcast()
+        condition.unlock()
+    }
+}
+
+// 하위 연산 하나의 결과 (C-MOVE/C-GET 진행 응답의 completed/warning/failed 수)
+enum SubOperationOutcome {
+    case completed
+    case warning
+    case failed
+
+    init(status: DicomheroDimseStatusCode) {
+        switch status.rawValue {
+        case 0:
+            self = .completed
+        case 0x0001, 0xB000...0xBFFF:
+            self = .warning
+        default:
+            self = .failed
+        }
+    }
+}
+
+// 여러 연결로 나눠, 연결마다 응답을 기다리지 않고 여러 C-STORE를 겹쳐 보내는 대량 전송기
+// 파일 읽기는 별도 reader들이 앞서 읽어 버퍼에 채우므로 디스크 읽기와 네트워크 쓰기가 겹침
+final class BulkStoreSender {
+    struct Configuration {
+        var node = "127.0.0.1"
+        var port = 11112
+        var callingAET = "DICOMAPP"
+        var calledAET = "DICOM"
+        var associations = 4
+        // 연결당 응답 전에 보낼 수 있는 C-STORE 수 (비동기 연산 창으로 제안함)
+        // DicomheroAssociationSCU는 A-ASSOCIATE-AC에서 상대가 받아들인 창을 알려 주지 않으므로 확인할 수 없음.
+        // 상대가 받아들이는 값을 알 때만 1보다 크게 설정 (기본은 동기 연산)
+        var window = 1
+        var readers = 2
+        var prefetch = 32  // 미리 읽어 둘 인스턴스 수
+        var dimseTimeoutSeconds: UInt32 = 30
+    }
+
+    struct Result {
+        var requested = 0
+        var stored = 0
+        var warnings = 0
+        var bytes = 0
+        var seconds = 0.0
+
+        var failed: Int { requested - stored - warnings }
+        var instancesPerSecond: Double { seconds > 0 ? Double(stored) / seconds : 0 }
+        var megabytesPerSecond: Double { seconds > 0 ? Double(bytes) / seconds / 1_048_576 : 0 }
+    }
+
+    struct Item {
+        let dataSet: DicomheroDataSet
+        let sopClassUID: String
+        let sopInstanceUID: String
+        let bytes: Int
+    }
+
+    let configuration: Configuration
+    // 인스턴스마다 결과가 정해지는 대로 호출됨 (여러 스레드에서 호출될 수 있음)
+    var onOutcome: ((SubOperationOutcome) -> Void)?
+
+    init(configuration: Configuration) {
+        self.configuration = configuration
+    }
+
+    // count를 주면 urls를 돌려 가며 그 수만큼 보냄 (되풀이한 인스턴스는 SOP Instance UID에 순번을 붙임)
+    func send(urls: [URL], count: Int? = nil) -> Result {
+        var result = Result(requested: urls.isEmpty ? 0 : count ?? urls.count)
+        guard result.requested > 0 else { return result }
+        let buffer = BoundedBuffer<Item>(capacity: configuration.prefetch)
+        let start = DispatchTime.now().uptimeNanoseconds
+
+        let requested = result.requested
+        let readers = max(1, configuration.readers)
+        DispatchQueue.global(qos: .userInitiated).async {
+            let next = NSLock()
+            var index = 0
+            DispatchQueue.concurrentPerform(iterations: readers) { _ in
+                while true {
+                    next.lock()
+                    let i = index
+                    index += 1
+                    next.unlock()
+                    guard i < requested else { return }
+                    if let item = BulkStoreSender.read(urls[i % urls.count], repetition: i / urls.count) {
+                        buffer.put(item)
+                    } else {
+                        self.onOutcome?(.failed)
+                    }
+                }
+            }
+            buffer.finish()
+        }
+
+        let window = max(1, configuration.window)
+        let group = DispatchGroup()
+        let lock = NSLock()
+        var alive = configuration.associations
+        for index in 0..<configuration.associations {
+            group.enter()
+            let thread = Thread { [self] in
+                let partial = self.run(association: index, buffer: buffer, window: window)
+                lock.lock()
+                result.stored += partial.stored
+                result.warnings += partial.warnings
+                result.bytes += partial.bytes
+                alive -= 1
+                if alive == 0 {
+                    buffer.cancel() // 모든 연결이 끝났으면 남은 reader가 막히지 않게 함
+                }
+                lock.unlock()
+                group.leave()
+            }
+            thread.name = "BulkStoreSender.\(index)"
+            thread.start()
+        }
+        group.wait()
+        result.seconds = Double(DispatchTime.now().uptimeNanoseconds - start) / 1e9
+        return result
+    }
+
+    // 되풀이한 인스턴스는 명령과 데이터셋의 SOP Instance UID를 같은 값으로 바꿈 (인스턴스마다 새로 읽은 데이터셋이라 고쳐도 됨)
+    static func read(_ url: URL, repetition: Int) -> Item? {
+        do {
+            let dataSet = try DicomheroCodecFactory.load(fromFile: url.path)
+            let uidTag = DicomheroTagId(id: .enumSOPInstanceUID_0008_0018)
+            var instanceUID = try dataSet.getString(uidTag, elementNumber: 0)
+            if repetition > 0 {
+                instanceUID += ".\(repetition)"
+                try dataSet.setString(uidTag, newValue: instanceUID)
+            }
+            return Item(
+                dataSet: dataSet,
+                sopClassUID: try dataSet.getString(DicomheroTagId(id: .enumSOPClassUID_0008_0016), elementNumber: 0),
+                sopInstanceUID: instanceUID,
+                bytes: (try? url.resourceValues(forKeys: [.fileSizeKey]).fileSize) ?? 0)
+        } catch {
+            print("caught: \(error)")
+            return nil
+        }
+    }
+
+    // 한 연결: 창이 찰 때까지 보내고, 차면 가장 오래된 요청의 응답을 받은 뒤 다음을 보냄
+    private func run(association index: Int, buffer: BoundedBuffer<Item>, window: Int) -> Result {
+        var result = Result()
+        var outstanding: [(command: DicomheroCStoreCommand, bytes: Int)] = []
+        do {
+            let stream = try DicomheroTCPStream(address: DicomheroTCPActiveAddress(
+                node: configuration.node, service: String(configuration.port)))
+            let association = try DicomheroAssociationSCU(
+                thisAET: configuration.callingAET, otherAET: configuration.calledAET,
+                maxInvokedOperations: UInt32(window), maxPerformedOperations: 1,
+                presentationContexts: StorageSCP.presentationContexts(),
+                reader: DicomheroStreamReader(inputStream: stream.getStreamInput()),
+                writer: DicomheroStreamWriter(outputStream: stream.getStreamOutput()),
+                dimseTimeoutSeconds: configuration.dimseTimeoutSeconds)
+            let service = DicomheroDimseService(association: association)
+
+            func collectOldest() throws {
+                let (command, bytes) = outstanding.removeFirst()
+                let outcome = SubOperationOutcome(status: try service.getCStoreResponse(command).status)
+                switch outcome {
+                case .completed:
+                    result.stored += 1
+                    result.bytes += bytes
+                case .warning:
+                    result.warnings += 1
+                    result.bytes += bytes
+                case .failed:
+                    break
+                }
+                onOutcome?(outcome)
+            }
+
+            while let item = buffer.take() {
+                try autoreleasepool {
+                    // 상대가 원본 전송 구문을 받아들이지 않았으면 협상된 구문으로 바꿔 보냄
+                    do {
+                        _ = try DataSetTranscoder.conform(item.dataSet, to: service.getTransferSyntax(item.sopClassUID))
+                    } catch {
+                        print("caught: \(error)")
+                        onOutcome?(.failed)
+                        return
+                    }
+                    let command = DicomheroCStoreCommand(
+                        abstractSyntax: item.sopClassUID,
+                        messageID: service.getNextCommandID(),
+                        priority: .medium,
+                        affectedSopClassUid: item.sopClassUID,
+                        affectedSopInstanceUid: item.sopInstanceUID,
+                        originatorAET: "", originatorMessageID: 0,
+                        payload: item.dataSet)
+                    try service.sendCommandOrResponse(command)
+                    outstanding.append((command, item.bytes))
+                    if outstanding.count >= window {
+                        try collectOldest()
+                    }
+                }
+            }
+            while !outstanding.isEmpty {
+                try collectOldest()
+            }
+            try association.release()
+        } catch {
+            print("caught: \(error)")
+            outstanding.forEach { _ in onOutcome?(.failed) }
+        }
+        return result
+    }
+}
+
+struct BulkStoreMeasurement {
+    var associations = 0
+    var window = 0
+    var result = BulkStoreSender.Result()
+}
+
+enum BulkStoreBenchmark {
+    // 루프백 비동기 SCP(받은 인스턴스는 버림)로 5,000개를 보내며 연결 수와 창 크기에 따른 처리량을 잼
+    // (1, 1)이 sendCommandOrResponse 뒤 getCStoreResponse를 기다리는 기존 방식에 해당
+    static func run(urls: [URL], instanceCount: Int = 5000,
+                    settings: [(associations: Int, window: Int)] = [(1, 1), (1, 8), (4, 8), (8, 16)],
+                    port: Int = 11115) -> [BulkStoreMeasurement] {
+        let scp = AssociationMultiplexer(configuration: AssociationMultiplexer.Configuration(
+            port: port, maxPDULength: 1 << 20, maxPerformedOperations: 64))
+        do {
+            try scp.start()
+        } catch {
+            print("caught: \(error)")
+            return []
+        }
+        defer { scp.stop() }
+
+        return settings.map { setting in
+            let sender = BulkStoreSender(configuration: BulkStoreSender.Configuration(
+                port: port, calledAET: scp.configuration.aeTitle,
+                associations: setting.associations, window: setting.window))
+            return BulkStoreMeasurement(associations: setting.associations, window: setting.window,
+                                        result: sender.send(urls: urls, count: instanceCount))
+        }
+    }
+}
@@ -0,0 +1,432 @@
+//
+//  CompactDataSet.swift
+//  Dicom
+//
+//  Created by hanjongwoo on 10/19/26.
+//
+
+import Foundation
+
+// 두 글자 VR 코드 (DicomheroTagType 원시 값과 같음)
+enum ValueRepresentation {
+    static let sq: UInt16 = 0x5351
+    static let us: UInt16 = 0x5553
+    static let ss: UInt16 = 0x5353
+    static let ul: UInt16 = 0x554C
+    static let sl: UInt16 = 0x534C
+    static let uv: UInt16 = 0x5556
+    static let sv: UInt16 = 0x5356
+    static let fl: UInt16 = 0x464C
+    static let fd: UInt16 = 0x4644
+    static let ds: UInt16 = 0x4453
+    static let `is`: UInt16 = 0x4953
+}
+
+// 태그 하나를 나타내는 32바이트 레코드
+// 값이 16바이트 이하(CS, SH, AS, DA, TM, US, UL 등 대부분의 짧은 VR)이면 레코드 안에 바로 저장하고
+// 더 긴 값만 데이터셋 공용 힙에 이어 붙임
+struct CompactTagRecord {
+    static let inlineCapacity = 16
+
+    let tag: UInt32     // (group << 16) | element
+    let vr: UInt16      // DicomheroTagType 원시 값 (두 글자 VR 코드)
+    let isInline: Bool
+    let length: UInt32  // 값 길이(바이트). SQ는 항목 수
+    let offset: UInt32  // 힙 안의 시작 위치. SQ는 첫 항목의 번호
+    var inline: (UInt64, UInt64) = (0, 0)
+
+    init(tag: UInt32, vr: UInt16, isInline: Bool, length: UInt32, offset: UInt32) {
+        self.tag = tag
+        self.vr = vr
+        self.isInline = isInline
+        self.length = length
+        self.offset = offset
+    }
+
+    var isSequence: Bool { vr == ValueRepresentation.sq }
+}
+
+enum CompactDataSetError: Error {
+    case notDicom
+    case unsupportedTransferSyntax(String)
+    case truncated
+}
+
+// 메타데이터만 필요한 경우를 위한 압축된 데이터셋 표현
+// 라이브러리 데이터셋을 만들지 않고 Part 10 파일 바이트를 직접 훑어 정렬된 레코드 배열 하나와 힙 하나만 채움
+// 읽기는 이진 탐색 후 레코드의 바이트를 바로 해석하므로 라이브러리 호출이나 추가 할당이 없음
+// 리틀 엔디언(암시적/명시적)만 다루며, 빅 엔디언과 deflate는 unsupportedTransferSyntax로 거절
+final class CompactDataSet {
+    private(set) var records: [CompactTagRecord] = []
+    private(set) var heap: [UInt8] = []
+    private(set) var items: [CompactDataSet] = [] // 시퀀스 항목 (SQ 레코드가 범위를 가리킴)
+    // 문자열 VR을 해석할 문자 집합 (항목은 자기 값이 없으면 상위 데이터셋을 따름)
+    private(set) var characterSet: SpecificCharacterSet
+    // 길이가 정해진(비압축) 픽셀 데이터 값의 파일 내 바이트 범위 (stopAfter가 픽셀 데이터를 포함할 때만 채움)
+    private(set) var pixelDataRange: Range<Int>?
+
+    // 픽셀 데이터처럼 메타데이터가 아닌 큰 값은 건너뜀
+    static let skippedTags: Set<UInt32> = [0x7FE0_0010, 0x7FE0_0008, 0x7FE0_0009]
+
+    private static let undefinedLength: UInt32 = 0xFFFF_FFFF
+
+    // 파일을 메모리 매핑해 stopAfter 태그까지의 최상위 요소를 읽음 (기본값은 픽셀 데이터 앞까지)
+    convenience init(url: URL, stopAfter: UInt32 = 0x7FDF_FFFF) throws {
+        let data = try Data(contentsOf: url, options: .alwaysMapped)
+        try self.init(part10: data, stopAfter: stopAfter)
+    }
+
+    init(part10 data: Data, stopAfter: UInt32 = 0x7FDF_FFFF) throws {
+        characterSet = .default
+        try data.withUnsafeBytes { bytes in
+            guard bytes.count >= 132, bytes[128] == 0x44, bytes[129] == 0x49, bytes[130] == 0x43, bytes[131] == 0x4D else {
+                throw CompactDataSetError.notDicom
+            }
+            var cursor = Cursor(bytes: bytes, position: 132)
+            // 파일 메타 정보(그룹 0002)는 항상 명시적 VR 리틀 엔디언
+            try parse(&cursor, end: bytes.count, explicitVR: true, stopAfter: 0x0002_FFFF)
+            let transferSyntax = string(.enumTransferSyntaxUID_0002_0010) ?? ""
+            guard TransferSyntaxKind.isSupported(transferSyntax) else {
+                throw CompactDataSetError.unsupportedTransferSyntax(transferSyntax)
+            }
+            try parse(&cursor, end: bytes.count, explicitVR: transferSyntax != TransferSyntaxKind.implicitLittleEndian,
+                      stopAfter: stopAfter)
+        }
+    }
+
+    private init(characterSet: SpecificCharacterSet) {
+        self.characterSet = characterSet
+    }
+
+    // 파일 바이트 위의 읽기 위치
+    private struct Cursor {
+        let bytes: UnsafeRawBufferPointer
+        var position: Int
+
+        func uint16(at offset: Int) -> UInt16 {
+            UInt16(littleEndian: bytes.loadUnaligned(fromByteOffset: position + offset, as: UInt16.self))
+        }
+
+        func uint32(at offset: Int) -> UInt32 {
+            UInt32(littleEndian: bytes.loadUnaligned(fromByteOffset: position + offset, as: UInt32.self))
+        }
+
+        func has(_ count: Int, before end: Int) -> Bool {
+            end - position >= count
+        }
+    }
+
+    // end 또는 항목 끝 구분자까지 요소를 읽어 레코드로 추가 (stopAfter보다 큰 태그를 만나면 멈춤)
+    private func parse(_ cursor: inout Cursor, end: Int, explicitVR: Bool, stopAfter: UInt32) throws {
+        while cursor.has(8, before: end) {
+            let group = cursor.uint16(at: 0), element = cursor.uint16(at: 2)
+            let tag = UInt32(group) << 16 | UInt32(element)
+            if group == 0xFFFE {
+                // 정의되지 않은 길이 항목의 끝
+                cursor.position += 8
+                break
+            }
+            if tag > stopAfter {
+                break
+            }
+            var vr: UInt16
+            let length: UInt32
+            if explicitVR {
+                vr = UInt16(cursor.bytes[cursor.position + 4]) << 8 | UInt16(cursor.bytes[cursor.position + 5])
+                if DataSetReencoder.hasLongLength(vr) {
+                    guard cursor.has(12, before: end) else { throw CompactDataSetError.truncated }
+                    length = cursor.uint32(at: 8)
+                    cursor.position += 12
+                } else {
+                    length = UInt32(cursor.uint16(at: 6))
+                    cursor.position += 8
+                }
+            } else {
+                length = cursor.uint32(at: 4)
+                vr = length == CompactDataSet.undefinedLength ? ValueRepresentation.sq : DataSetReencoder.dictionaryVR(tag)
+                cursor.position += 8
+            }
+            if length == CompactDataSet.undefinedLength && vr >> 8 == 0x4F {
+                // 캡슐화된 픽셀 데이터 등 조각으로 나뉜 값은 구분자까지 건너뜀
+                try skipFragments(&cursor, end: end)
+                continue
+            }
+            // 정의되지 않은 길이의 UN은 암시적 VR로 인코딩된 시퀀스
+            let sequenceExplicitVR = explicitVR && vr != DataSetReencoder.un
+            if length == CompactDataSet.undefinedLength {
+                vr = ValueRepresentation.sq
+            }
+            if vr == ValueRepresentation.sq {
+                try appendSequence(tag: tag, cursor: &cursor, end: end, length: length, explicitVR: sequenceExplicitVR)
+                continue
+            }
+            guard cursor.has(Int(length), before: end) else {
+                throw CompactDataSetError.truncated
+            }
+            if tag == 0x7FE0_0010 {
+                pixelDataRange = cursor.position..<cursor.position + Int(length)
+            }
+            if !CompactDataSet.skippedTags.contains(tag) {
+                let value = UnsafeRawBufferPointer(rebasing: cursor.bytes[cursor.position..<cursor.position + Int(length)])
+                append(tag: tag, vr: vr, bytes: value)
+                if tag == 0x0008_0005 {
+                    characterSet = SpecificCharacterSet(String(decoding: value, as: UTF8.self))
+                }
+            }
+            cursor.position += Int(length)
+        }
+        // 파일은 태그 순서로 쓰이지만 이진 탐색을 위해 한 번 더 보장
+        records.sort { $0.tag < $1.tag }
+    }
+
+    private func skipFragments(_ cursor: inout Cursor, end: Int) throws {
+        while cursor.has(8, before: end) {
+            let element = cursor.uint16(at: 2), fragmentLength = Int(cursor.uint32(at: 4))
+            cursor.position += 8
+            if element == 0xE0DD {
+                return
+            }
+            guard cursor.has(fragmentLength, before: end) else {
+                throw CompactDataSetError.truncated
+            }
+            cursor.position += fragmentLength
+        }
+    }
+
+    private func append(tag: UInt32, vr: UInt16, bytes: UnsafeRawBufferPointer) {
+        if bytes.count <= CompactTagRecord.inlineCapacity {
+            var record = CompactTagRecord(tag: tag, vr: vr, isInline: true, length: UInt32(bytes.count), offset: 0)
+            withUnsafeMutableBytes(of: &record.inline) { inline in
+                inline.copyMemory(from: bytes)
+            }
+            records.append(record)
+        } else {
+            records.append(CompactTagRecord(tag: tag, vr: vr, isInline: false, length: UInt32(bytes.count), offset: UInt32(heap.count)))
+            heap.append(contentsOf: bytes)
+        }
+    }
+
+    // 항목을 하나씩 자식 데이터셋으로 읽음 (정의된 길이와 구분자로 끝나는 길이 모두)
+    private func appendSequence(tag: UInt32, cursor: inout Cursor, end: Int, length: UInt32, explicitVR: Bool) throws {
+        let sequenceEnd = length == CompactDataSet.undefinedLength ? end : cursor.position + Int(length)
+        guard sequenceEnd <= end else {
+            throw CompactDataSetError.truncated
+        }
+        var children: [CompactDataSet] = []
+        while cursor.has(8, before: sequenceEnd) {
+            let group = cursor.uint16(at: 0), element = cursor.uint16(at: 2)
+            let itemLength = cursor.uint32(at: 4)
+            cursor.position += 8
+            if group == 0xFFFE && element == 0xE0DD {
+                break
+            }
+            guard group == 0xFFFE && element == 0xE000 else {
+                throw CompactDataSetError.truncated
+            }
+            let item = CompactDataSet(characterSet: characterSet)
+            let itemEnd = itemLength == CompactDataSet.undefinedLength ? sequenceEnd : cursor.position + Int(itemLength)
+            guard itemEnd <= sequenceEnd else {
+                throw CompactDataSetError.truncated
+            }
+            try item.parse(&cursor, end: itemEnd, explicitVR: explicitVR, stopAfter: .max)
+            cursor.position = itemLength == CompactDataSet.undefinedLength ? cursor.position : itemEnd
+            children.append(item)
+        }
+        if length != CompactDataSet.undefinedLength {
+            cursor.position = sequenceEnd
+        }
+        let first = items.count
+        items.append(contentsOf: children)
+        records.append(CompactTagRecord(tag: tag, vr: ValueRepresentation.sq, isInline: false,
+                                        length: UInt32(children.count), offset: UInt32(first)))
+    }
+
+    // 레코드 수, 힙, 항목을 포함한 대략적인 메모리 사용량(바이트)
+    var byteCount: Int {
+        records.count * MemoryLayout<CompactTagRecord>.stride + heap.count + items.reduce(0) { $0 + $1.byteCount }
+    }
+
+    func record(_ tag: DicomheroTagEnum) -> CompactTagRecord? {
+        record(tag.rawValue)
+    }
+
+    func record(_ tag: UInt32) -> CompactTagRecord? {
+        var low = 0, high = records.count
+        while low < high {
+            let middle = (low + high) / 2
+            if records[middle].tag < tag {
+                low = middle + 1
+            } else {
+                high = middle
+            }
+        }
+        return low < records.count && records[low].tag == tag ? records[low] : nil
+    }
+
+    // 레코드 값의 바이트를 body에 넘김 (인라인이면 레코드 안, 아니면 힙)
+    func withValue<Result>(_ record: CompactTagRecord, _ body: (UnsafeRawBufferPointer) -> Result) -> Result {
+        if record.isInline {
+            var inline = record.inline
+            return withUnsafeBytes(of: &inline) { body(UnsafeRawBufferPointer(rebasing: $0.prefix(Int(record.length)))) }
+        }
+        return heap.withUnsafeBytes { body(UnsafeRawBufferPointer(rebasing: $0[Int(record.offset)..<Int(record.offset + record.length)])) }
+    }
+
+    // 문자열 VR의 element번째 값 (백슬래시로 구분, 앞뒤 공백과 NUL 제거, Specific Character Set에 따라 변환)
+    func string(_ tag: DicomheroTagEnum, element: Int = 0) -> String? {
+        guard let record = record(tag), !record.isSequence else {
+            return nil
+        }
+        return withValue(record) { bytes in
+            var start = 0, index = 0
+            for i in 0...bytes.count where i == bytes.count || bytes[i] == 0x5C {
+                if index == element {
+                    var lower = start, upper = i
+                    while lower < upper && (bytes[lower] == 0x20 || bytes[lower] == 0) { lower += 1 }
+                    while upper > lower && (bytes[upper - 1] == 0x20 || bytes[upper - 1] == 0) { upper -= 1 }
+                    return characterSet.decode(UnsafeRawBufferPointer(rebasing: bytes[lower..<upper]))
+                }
+                index += 1
+                start = i + 1
+            }
+            return nil
+        }
+    }
+
+    // 이진 정수 VR(US/SS/UL/SL 등)은 그대로, 문자열 VR(IS/DS)은 파싱해서 읽음
+    func uint16(_ tag: DicomheroTagEnum, element: Int = 0) -> UInt16? {
+        integer(tag, element: element).map { UInt16(truncatingIfNeeded: $0) }
+    }
+
+    func uint32(_ tag: DicomheroTagEnum, element: Int = 0) -> UInt32? {
+        integer(tag, element: element).map { UInt32(truncatingIfNeeded: $0) }
+    }
+
+    func double(_ tag: DicomheroTagEnum, element: Int = 0) -> Double? {
+        guard let record = record(tag) else {
+            return nil
+        }
+        switch record.vr {
+        case ValueRepresentation.fl: return binary(record, Float.self, element).map(Double.init)
+        case ValueRepresentation.fd: return binary(record, Double.self, element)
+        case ValueRepresentation.ds, ValueRepresentation.`is`: return string(tag, element: element).flatMap(Double.init)
+        default: return integer(tag, element: element).map(Double.init)
+        }
+    }
+
+    // 시퀀스의 item번째 항목
+    func sequenceItem(_ tag: DicomheroTagEnum, item: Int = 0) -> CompactDataSet? {
+        guard let record = record(tag), record.isSequence, item < Int(record.length) else {
+            return nil
+        }
+        return items[Int(record.offset) + item]
+    }
+
+    private func integer(_ tag: DicomheroTagEnum, element: Int) -> Int64? {
+        guard let record = record(tag) else {
+            return nil
+        }
+        switch record.vr {
+        case ValueRepresentation.us: return binary(record, UInt16.self, element).map(Int64.init)
+        case ValueRepresentation.ss: return binary(record, Int16.self, element).map(Int64.init)
+        case ValueRepresentation.ul: return binary(record, UInt32.self, element).map(Int64.init)
+        case ValueRepresentation.sl: return binary(record, Int32.self, element).map(Int64.init)
+        case ValueRepresentation.uv: return binary(record, UInt64.self, element).map { Int64(truncatingIfNeeded: $0) }
+        case ValueRepresentation.sv: return binary(record, Int64.self, element)
+        default:
+            guard let text = string(tag, element: element) else { return nil }
+            // IS/DS 문자열: NaN, 무한대, Int64 범위 밖의 값은 nil
+            return Int64(text) ?? Double(text).flatMap { Int64(exactly: $0.rounded(.towardZero)) }
+        }
+    }
+
+    private func binary<Value>(_ record: CompactTagRecord, _ type: Value.Type, _ element: Int) -> Value? {
+        withValue(record) { bytes in
+            let size = MemoryLayout<Value>.size
+            guard (element + 1) * size <= bytes.count else {
+                return nil
+            }
+            return bytes.loadUnaligned(fromByteOffset: element * size, as: Value.self)
+        }
+    }
+}
+
+// 메타데이터 위주 객체(SR, RTSTRUCT 등)에서 압축 표현과 라이브러리 데이터셋을 비교
+struct CompactDataSetStatistics {
+    var files = 0
+    var tags = 0
+    var inlineTags = 0
+    var compactBytes = 0
+    var datasetLoadSeconds = 0.0 // 라이브러리로 파일을 파싱한 시간
+    var buildSeconds = 0.0       // 같은 파일에서 CompactDataSet을 바로 만든 시간
+    var datasetReadSeconds = 0.0 // DicomheroDataSet.getString/getUint16으로 읽은 시간
+    var compactReadSeconds = 0.0 // CompactDataSet으로 같은 값을 읽은 시간
+
+    var inlineRatio: Double { tags > 0 ? Double(inlineTags) / Double(tags) : 0 }
+}
+
+enum CompactDataSetBenchmark {
+    // 자주 읽는 짧은 태그들
+    static let stringTags: [DicomheroTagEnum] = [
+        .enumModality_0008_0060, .enumStudyDate_0008_0020, .enumStudyTime_0008_0030,
+        .enumPatientSex_0010_0040, .enumPatientAge_0010_1010, .enumSOPClassUID_0008_0016,
+        .enumSeriesNumber_0020_0011, .enumInstanceNumber_0020_0013
+    ]
+    static let integerTags: [DicomheroTagEnum] = [.enumRows_0028_0010, .enumColumns_0028_0011, .enumBitsAllocated_0028_0100]
+
+    static func run(urls: [URL], repetitions: Int = 100) -> CompactDataSetStatistics {
+        var statistics = CompactDataSetStatistics()
+        let stringIds = stringTags.map { DicomheroTagId(id: $0)! }
+        let integerIds = integerTags.map { DicomheroTagId(id: $0)! }
+        for url in urls {
+            autoreleasepool {
+                var start = DispatchTime.now().uptimeNanoseconds
+                guard let dataset = try? DicomheroCodecFactory.load(fromFileMaxSize: url.path, maxBufferSize: 2048) else {
+                    return
+                }
+                statistics.datasetLoadSeconds += elapsed(since: start)
+                start = DispatchTime.now().uptimeNanoseconds
+                guard let compact = try? CompactDataSet(url: url) else {
+                    return
+                }
+                statistics.buildSeconds += elapsed(since: start)
+                statistics.files += 1
+                count(compact, into: &statistics)
+
+                start = DispatchTime.now().uptimeNanoseconds
+                for _ in 0..<repetitions {
+                    for tagId in stringIds {
+                        _ = try? dataset.getString(tagId, elementNumber: 0)
+                    }
+                    for tagId in integerIds {
+                        _ = try? dataset.getUint16(tagId, elementNumber: 0)
+                    }
+                }
+                statistics.datasetReadSeconds += elapsed(since: start)
+
+                start = DispatchTime.now().uptimeNanoseconds
+                for _ in 0..<repetitions {
+                    for tag in stringTags {
+                        _ = compact.string(tag)
+                    }
+                    for tag in integerTags {
+                        _ = compact.uint16(tag)
+                    }
+                }
+                statistics.compactReadSeconds += elapsed(since: start)
+            }
+        }
+        return statistics
+    }
+
+    private static func count(_ compact: CompactDataSet, into statistics: inout CompactDataSetStatistics) {
+        statistics.tags += compact.records.count
+        statistics.inlineTags += compact.records.filter(\.isInline).count
+        statistics.compactBytes += compact.records.count * MemoryLayout<CompactTagRecord>.stride + compact.heap.count
+        compact.items.forEach { count($0, into: &statistics) }
+    }
+
+    private static func elapsed(since start: UInt64) -> Double {
+        Double(DispatchTime.now().uptimeNanoseconds - start) / 1e9
+    }
+}
@@ -0,0 +1,394 @@
+//
+//  CompressedVolume.swift
+//  Dicom
+//
+//  Created by hanjongwoo on 10/19/26.
+//
+
+import Foundation
+import simd
+
+// 브릭 단위 무손실 코덱 (델타 예측 + 지그재그 + 비트 패킹)
+// 인접 복셀과의 차이는 대부분 작기 때문에 그룹마다 필요한 비트 수만 사용해 저장
+enum BrickCodec {
+    // 비트 폭을 공유하는 값의 개수
+    static let groupSize = 64
+
+    static func encode(_ values: UnsafePointer<Int16>, width: Int, height: Int, depth: Int) -> [UInt8] {
+        let count = width * height * depth
+        var residuals = [UInt16](repeating: 0, count: count)
+        var k = 0
+        for z in 0..<depth {
+            for y in 0..<height {
+                for x in 0..<width {
+                    let delta = values[k] &- prediction(values, k, x, y, z, width, height)
+                    residuals[k] = UInt16(bitPattern: (delta << 1) ^ (delta >> 15))
+                    k += 1
+                }
+            }
+        }
+
+        var output = [UInt8]()
+        output.reserveCapacity(count)
+        var i = 0
+        while i < count {
+            let n = min(groupSize, count - i)
+            var combined: UInt16 = 0
+            for j in i..<(i + n) {
+                combined |= residuals[j]
+            }
+            let bits = 16 - combined.leadingZeroBitCount
+            output.append(UInt8(bits))
+            if bits > 0 {
+                // 그룹마다 바이트 경계에서 끝나도록 남은 비트를 채워서 기록
+                var accumulator: UInt64 = 0
+                var accumulatedBits = 0
+                for j in i..<(i + n) {
+                    accumulator |= UInt64(residuals[j]) << accumulatedBits
+                    accumulatedBits += bits
+                    while accumulatedBits >= 8 {
+                        output.append(UInt8(truncatingIfNeeded: accumulator))
+                        accumulator >>= 8
+                        accumulatedBits -= 8
+                    }
+                }
+                if accumulatedBits > 0 {
+                    output.append(UInt8(truncatingIfNeeded: accumulator))
+                }
+            }
+            i += n
+        }
+        return output
+    }
+
+    static func decode(_ bytes: [UInt8], width: Int, height: Int, depth: Int, into output: UnsafeMutablePointer<Int16>) {
+        let count = width * height * depth
+        bytes.withUnsafeBufferPointer { input in
+            var position = 0
+            var i = 0
+            while i < count {
+                let n = min(groupSize, count - i)
+                let bits = Int(input[position])
+                position += 1
+                if bits == 0 {
+                    output.advanced(by: i).update(repeating: 0, count: n)
+                } else {
+                    let mask = (UInt64(1) << bits) - 1
+                    var accumulator: UInt64 = 0
+                    var accumulatedBits = 0
+                    for j in i..<(i + n) {
+                        while accumulatedBits < bits {
+                            accumulator |= UInt64(input[position]) << accumulatedBits
+                            position += 1
+                            accumulatedBits += 8
+                        }
+                        let residual = UInt16(truncatingIfNeeded: accumulator & mask)
+                        accumulator >>= bits
+                        accumulatedBits -= bits
+                        output[j] = Int16(bitPattern: residual >> 1) ^ -Int16(bitPattern: residual & 1)
+                    }
+                }
+                i += n
+            }
+        }
+
+        // 이미 복원된 값으로 예측값을 계산하여 인코딩 순서대로 되돌림
+        var k = 0
+        for z in 0..<depth {
+            for y in 0..<height {
+                for x in 0..<width {
+                    output[k] = output[k] &+ prediction(UnsafePointer(output), k, x, y, z, width, height)
+                    k += 1
+                }
+            }
+        }
+    }
+
+    // 왼쪽 복셀, 행의 첫 복셀이면 위쪽 복셀, 슬라이스의 첫 복셀이면 이전 슬라이스 복셀로 예측
+    @inline(__always)
+    private static func prediction(_ values: UnsafePointer<Int16>, _ k: Int, _ x: Int, _ y: Int, _ z: Int, _ width: Int, _ height: Int) -> Int16 {
+        if x > 0 {
+            return values[k - 1]
+        }
+        if y > 0 {
+            return values[k - width]
+        }
+        if z > 0 {
+            return values[k - width * height]
+        }
+        return 0
+    }
+}
+
+// 압축을 푼 브릭 하나 (캐시에서 밀려나도 쓰고 있는 쪽이 잡고 있는 동안은 유효함)
+final class DecodedBrick {
+    let voxels: UnsafeMutablePointer<Int16>
+    private let count: Int
+
+    init(count: Int) {
+        self.count = count
+        voxels = .allocate(capacity: count)
+        MemoryGovernor.shared.recordAllocation(count * MemoryLayout<Int16>.stride, in: .volumes)
+    }
+
+    deinit {
+        voxels.deallocate()
+        MemoryGovernor.shared.recordRelease(count * MemoryLayout<Int16>.stride, in: .volumes)
+    }
+}
+
+// 최근에 사용한 브릭의 압축 해제본을 보관하는 작은 LRU 캐시
+// 잠금은 브릭을 찾고 넣을 때만 잡고, 압축 해제와 복셀 읽기는 잠금 밖에서 하므로 여러 스레드가 함께 읽을 수 있음
+final class BrickCache {
+    private struct Slot {
+        let brick: DecodedBrick
+        var lastUse: UInt64
+    }
+
+    let capacity: Int
+    let brickVoxels: Int
+    private let lock = NSLock()
+    private var slots: [Int: Slot] = [:]
+    private var clock: UInt64 = 0
+
+    private(set) var hits = 0
+    private(set) var misses = 0
+
+    init(capacity: Int, brickVoxels: Int) {
+        self.capacity = max(capacity, 1)
+        self.brickVoxels = brickVoxels
+        MemoryGovernor.shared.register(MemoryGovernor.Cache(
+            name: "BrickCache",
+            residentBytes: { [weak self] in self?.residentBytes ?? 0 },
+            hitsAndMisses: { [weak self] in self?.counts ?? (0, 0) },
+            shed: { [weak self] in self?.removeAll() }), owner: self)
+    }
+
+    deinit {
+        MemoryGovernor.shared.unregister(owner: self)
+    }
+
+    private var counts: (hits: Int, misses: Int) {
+        lock.lock()
+        defer { lock.unlock() }
+        return (hits, misses)
+    }
+
+    var hitRate: Double {
+        lock.lock()
+        defer { lock.unlock() }
+        return hits + misses > 0 ? Double(hits) / Double(hits + misses) : 0
+    }
+
+    var residentBytes: Int {
+        lock.lock()
+        defer { lock.unlock() }
+        return slots.count * brickVoxels * MemoryLayout<Int16>.stride
+    }
+
+    // 브릭이 캐시에 없으면 decode로 채워 넣고 돌려줌 (두 스레드가 같이 놓치면 먼저 넣은 쪽을 씀)
+    func brick(_ index: Int, decode: (UnsafeMutablePointer<Int16>) -> Void) -> DecodedBrick {
+        lock.lock()
+        clock += 1
+        if let slot = slots[index] {
+            hits += 1
+            slots[index]!.lastUse = clock
+            lock.unlock()
+            return slot.brick
+        }
+        misses += 1
+        lock.unlock()
+
+        let decoded = DecodedBrick(count: brickVoxels)
+        decode(decoded.voxels)
+
+        lock.lock()
+        defer { lock.unlock() }
+        clock += 1
+        if let existing = slots[index] {
+            return existing.brick
+        }
+        if slots.count >= capacity, let oldest = slots.min(by: { $0.value.lastUse < $1.value.lastUse })?.key {
+            slots[oldest] = nil // 가장 오래 사용하지 않은 브릭을 내보냄
+        }
+        slots[index] = Slot(brick: decoded, lastUse: clock)
+        return decoded
+    }
+
+    // 캐시된 브릭을 모두 버림 (메모리 부족 시)
+    func removeAll() {
+        lock.lock()
+        slots.removeAll()
+        lock.unlock()
+    }
+}
+
+// 메모리 예산을 넘는 시리즈를 위해 브릭 단위로 압축해 RAM에 보관하는 볼륨
+// 복셀을 읽을 때 해당 브릭만 압축을 풀어 캐시하므로 MPR/렌더링 쪽에서는 일반 볼륨과 같이 사용
+final class CompressedVolume: VolumeSampling {
+    static let brickSize = 32
+
+    let width: Int
+    let height: Int
+    let depth: Int
+    let spacing: SIMD3<Float>
+    let origin: SIMD3<Float>
+    let rowDirection: SIMD3<Float>
+    let columnDirection: SIMD3<Float>
+
+    let bricksX: Int
+    let bricksY: Int
+    let bricksZ: Int
+    private var bricks: [[UInt8]]
+    let cache: BrickCache
+
+    init(width: Int, height: Int, depth: Int,
+         spacing: SIMD3<Float>, origin: SIMD3<Float>,
+         rowDirection: SIMD3<Float>, columnDirection: SIMD3<Float>,
+         cacheCapacity: Int = 64) {
+        self.width = width
+        self.height = height
+        self.depth = depth
+        self.spacing = spacing
+        self.origin = origin
+        self.rowDirection = rowDirection
+        self.columnDirection = columnDirection
+        let size = CompressedVolume.brickSize
+        bricksX = (width + size - 1) / size
+        bricksY = (height + size - 1) / size
+        bricksZ = (depth + size - 1) / size
+        bricks = [[UInt8]](repeating: [], count: bricksX * bricksY * bricksZ)
+        cache = BrickCache(capacity: cacheCapacity, brickVoxels: size * size * size)
+    }
+
+    deinit {
+        MemoryGovernor.shared.recordRelease(compressedByteCount, in: .volumes)
+    }
+
+    // 압축된 데이터의 총 크기(바이트)
+    var compressedByteCount: Int {
+        bricks.reduce(0) { $0 + $1.count }
+    }
+
+    // 원본 대비 압축률
+    var compressionRatio: Double {
+        let compressed = compressedByteCount
+        return compressed > 0 ? Double(width * height * depth * MemoryLayout<Int16>.stride) / Double(compressed) : 0
+    }
+
+    // 브릭 z 층 하나(최대 brickSize장의 슬라이스)를 압축하여 저장
+    // slab은 z = brickZ * brickSize 부터 시작하는 연속된 슬라이스 버퍼
+    func store(slab: UnsafePointer<Int16>, brickZ: Int) {
+        let size = CompressedVolume.brickSize
+        let z0 = brickZ * size
+        let brickDepth = min(size, depth - z0)
+        let bricksX = bricksX, bricksY = bricksY
+        let width = width, height = height
+        bricks.withUnsafeMutableBufferPointer { buffer in
+            let output = buffer
+            DispatchQueue.concurrentPerform(iterations: bricksX * bricksY) { i in
+                let bx = i % bricksX, by = i / bricksX
+                let brickWidth = min(size, width - bx * size)
+                let brickHeight = min(size, height - by * size)
+                // 브릭 영역을 연속된 버퍼로 모은 뒤 압축
+                let gathered = UnsafeMutablePointer<Int16>.allocate(capacity: brickWidth * brickHeight * brickDepth)
+                defer { gathered.deallocate() }
+                var k = 0
+                for z in 0..<brickDepth {
+                    for y in 0..<brickHeight {
+                        let row = slab + (z * height + by * size + y) * width + bx * size
+                        (gathered + k).update(from: row, count: brickWidth)
+                        k += brickWidth
+                    }
+                }
+                output[(brickZ * bricksY + by) * bricksX + bx] = BrickCodec.encode(gathered, width: brickWidth, height: brickHeight, depth: brickDepth)
+            }
+        }
+        let layer = bricks[(brickZ * bricksY * bricksX)..<((brickZ + 1) * bricksY * bricksX)]
+        MemoryGovernor.shared.recordAllocation(layer.reduce(0) { $0 + $1.count }, in: .volumes)
+    }
+
+    func value(x: Int, y: Int, z: Int) -> Int16 {
+        let size = CompressedVolume.brickSize
+        let (brick, extent) = self.brick(x / size, y / size, z / size)
+        let local = ((z % size) * extent.y + y % size) * extent.x + x % size
+        return brick.voxels[local]
+    }
+
+    // 줄을 브릭 경계에서 나눠 브릭마다 캐시를 한 번만 찾음
+    func line(from start: SIMD3<Int>, axis: Int, count: Int, into output: UnsafeMutablePointer<Int16>) {
+        let size = CompressedVolume.brickSize
+        var p = start, written = 0
+        while written < count {
+            let (brick, extent) = self.brick(p.x / size, p.y / size, p.z / size)
+            let local = SIMD3(p.x % size, p.y % size, p.z % size)
+            let stride = [1, extent.x, extent.x * extent.y][axis]
+            var index = (local.z * extent.y + local.y) * extent.x + local.x
+            let run = min(count - written, extent[axis] - local[axis])
+            for i in 0..<run {
+                output[written + i] = brick.voxels[index]
+                index += stride
+            }
+            written += run
+            p[axis] += run
+        }
+    }
+
+    // 브릭 좌표의 압축 해제본과 그 브릭의 실제 크기 (볼륨 가장자리 브릭은 작음)
+    private func brick(_ bx: Int, _ by: Int, _ bz: Int) -> (DecodedBrick, SIMD3<Int>) {
+        let size = CompressedVolume.brickSize
+        let extent = SIMD3(min(size, width - bx * size), min(size, height - by * size), min(size, depth - bz * size))
+        let index = (bz * bricksY + by) * bricksX + bx
+        let decoded = cache.brick(index) { output in
+            BrickCodec.decode(bricks[index], width: extent.x, height: extent.y, depth: extent.z, into: output)
+        }
+        return (decoded, extent)
+    }
+}
+
+extension DicomVolumeLoader {
+    // 메모리 예산 안에 들어가면 일반 볼륨으로, 넘으면 압축 브릭 볼륨으로 조립
+    // 압축 경로에서는 브릭 한 층 분량의 슬라이스만 디코딩해 두고 바로 압축하므로
+    // 최대 메모리 사용량은 (압축 데이터 + 슬라이스 brickSize장 + 캐시) 수준으로 유지됨
+    static func load(urls: [URL], memoryBudget: Int) throws -> VolumeSampling {
+        try load(headers: sortedHeaders(urls: urls), memoryBudget: memoryBudget)
+    }
+
+    // 일반 볼륨(슬라이스당 Int16)으로 만들었을 때 예산 안에 들어가는지
+    static func fitsInMemory(_ headers: [SliceHeader], memoryBudget: Int) -> Bool {
+        guard let first = headers.first else {
+            return true
+        }
+        return first.rows * first.columns * headers.count * MemoryLayout<Int16>.stride <= memoryBudget
+    }
+
+    static func load(headers: [SliceHeader], memoryBudget: Int) throws -> VolumeSampling {
+        guard let first = headers.first else {
+            throw DicomVolumeError.emptySeries
+        }
+        guard headers.allSatisfy({ $0.rows == first.rows && $0.columns == first.columns }) else {
+            throw DicomVolumeError.inconsistentSliceSize
+        }
+        if fitsInMemory(headers, memoryBudget: memoryBudget) {
+            return try load(headers: headers)
+        }
+
+        let layout = geometry(headers: headers)
+        let volume = CompressedVolume(width: first.columns, height: first.rows, depth: headers.count,
+                                      spacing: layout.spacing,
+                                      origin: layout.origin,
+                                      rowDirection: layout.rowDirection,
+                                      columnDirection: layout.columnDirection)
+        let size = CompressedVolume.brickSize
+        let sliceSize = first.rows * first.columns
+        let slab = UnsafeMutablePointer<Int16>.allocate(capacity: sliceSize * size)
+        defer { slab.deallocate() }
+        for brickZ in 0..<volume.bricksZ {
+            let z0 = brickZ * size
+            let z1 = min(z0 + size, headers.count)
+            try decodeSlices(headers[z0..<z1], sliceSize: sliceSize) { slab + ($0 - z0) * sliceSize }
+            volume.store(slab: slab, brickZ: brickZ)
+        }
+        return volume
+    }
+}
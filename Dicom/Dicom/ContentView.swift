@@ -32,8 +32,24 @@ struct ContentView: View {
                 Image(uiImage: data.image!).resizable()
                     .scaledToFit().imageScale(.medium)
             }
+
+            // 가져온 검사 목록 (로컬 색인에서 읽으므로 파일을 다시 열지 않음)
+            List(data.studies, id: \.studyUID) { study in
+                VStack(alignment: .leading) {
+                    Text(study.patientName)
+                    Text("\(study.studyDate) \(study.modality) \(study.accessionNumber)").font(.caption)
+                }
+            }
         }
         .padding()
+        .onAppear {
+            DispatchQueue.global(qos: .utility).async {
+                let studies = MetadataLibrary.shared.studies()
+                DispatchQueue.main.async {
+                    data.studies = studies
+                }
+            }
+        }
         .sheet(isPresented: self.$showFilePicker) {
             DocumentPickerImportView(path: $path, loading: $loading, data: $data)
         }
@@ -0,0 +1,251 @@
+//
+//  DecodeAdmission.swift
+//  Dicom
+//
+//  Created by hanjongwoo on 10/19/26.
+//
+
+import Foundation
+import os
+
+// 디코딩 전에 헤더만으로 계산한 메모리 사용량 예측
+struct DecodeEstimate {
+    let rows: Int
+    let columns: Int
+    let frames: Int
+    let bitsAllocated: Int
+    let samplesPerPixel: Int
+
+    init(rows: Int, columns: Int, frames: Int = 1, bitsAllocated: Int = 16, samplesPerPixel: Int = 1) {
+        self.rows = rows
+        self.columns = columns
+        self.frames = max(frames, 1)
+        self.bitsAllocated = bitsAllocated
+        self.samplesPerPixel = max(samplesPerPixel, 1)
+    }
+
+    // 픽셀 데이터를 읽지 않고 Rows/Columns/NumberOfFrames/BitsAllocated/SamplesPerPixel만 사용
+    init(dataSet: DicomheroDataSet) throws {
+        func uint32(_ tag: DicomheroTagEnum, _ defaultValue: UInt32) throws -> Int {
+            Int(try dataSet.getUint32(DicomheroTagId(id: tag), elementNumber: 0, defaultValue: defaultValue))
+        }
+        self.init(rows: try uint32(.enumRows_0028_0010, 0),
+                  columns: try uint32(.enumColumns_0028_0011, 0),
+                  frames: try uint32(.enumNumberOfFrames_0028_0008, 1),
+                  bitsAllocated: try uint32(.enumBitsAllocated_0028_0100, 16),
+                  samplesPerPixel: try uint32(.enumSamplesPerPixel_0028_0002, 1))
+    }
+
+    // 디코딩된 표본 하나의 크기 (1/2/4바이트로 올림)
+    var bytesPerSample: Int {
+        bitsAllocated <= 8 ? 1 : (bitsAllocated <= 16 ? 2 : 4)
+    }
+
+    // 프레임 하나를 디코딩한 이미지의 크기
+    var frameBytes: Int { rows * columns * samplesPerPixel * bytesPerSample }
+
+    // 모든 프레임을 디코딩했을 때의 크기 (볼륨 조립 등)
+    var allFramesBytes: Int { frameBytes * frames }
+
+    // 모달리티 변환 결과 (최대 32비트 표본)
+    var modalityBytes: Int { rows * columns * samplesPerPixel * 4 }
+
+    // 화면 표시용 RGBA 비트맵
+    var bitmapBytes: Int { rows * columns * 4 }
+
+    // 프레임 하나를 디코딩하고 변환해 표시할 때 동시에 살아 있는 최대 메모리
+    var peakBytes: Int { frameBytes + modalityBytes + bitmapBytes }
+
+    // 축소 디코딩(ReducedDecoder)으로 가로세로를 factor배 줄여 만들 때의 최대 메모리
+    // 원본 표본 버퍼는 그대로 읽고, 모달리티 변환 결과와 비트맵만 줄어듦
+    func peakBytes(downsampleFactor factor: Int) -> Int {
+        frameBytes + (modalityBytes + bitmapBytes) / (factor * factor)
+    }
+}
+
+// 예산 안에서 디코딩 작업을 허가받은 표. 해제되면 잡고 있던 예산을 돌려줌
+final class DecodeTicket {
+    let bytes: Int
+    let downsampleFactor: Int // 1이면 원본 크기, 2 이상이면 그만큼 줄여서 디코딩함
+    private weak var scheduler: DecodeScheduler?
+    private var released = false
+
+    fileprivate init(bytes: Int, downsampleFactor: Int, scheduler: DecodeScheduler) {
+        self.bytes = bytes
+        self.downsampleFactor = downsampleFactor
+        self.scheduler = scheduler
+    }
+
+    deinit {
+        release()
+    }
+
+    func release() {
+        guard !released else { return }
+        released = true
+        scheduler?.release(bytes)
+    }
+}
+
+// 예측된 디코딩 크기를 공유 예산에 맞춰 허가하는 스케줄러
+// 고정된 최대 이미지 크기로 거절하는 대신
+//  - 예산이 남아 있으면 바로 허가
+//  - 다른 작업이 예산을 쓰고 있으면 도착 순서대로 대기열에 넣고, 예산이 돌아올 때 실행
+//  - 혼자서도 예산을 넘는 이미지는 축소 디코딩이 가능하면 줄여서 만들도록 허가하고, 그래도 넘으면 단독으로 실행
+// 대기 중인 작업은 스레드를 잡지 않으므로 GCD 작업 스레드가 대기로 막히지 않음
+final class DecodeScheduler {
+    static let shared = DecodeScheduler(budget: DecodeScheduler.defaultBudget)
+
+    // 프로세스가 더 쓸 수 있는 메모리의 절반 (최소 64MB)
+    static var defaultBudget: Int {
+        max(os_proc_available_memory() / 2, 64 << 20)
+    }
+
+    // 축소 배율의 상한
+    static let maximumDownsampleFactor = DecodeScale.eighth.rawValue
+
+    // 앱 시작 시 한 번: 라이브러리의 고정 크기 제한(기본 4096x4096)을 Rows/Columns가 가질 수 있는 최대로 올림
+    // 무엇을 어떤 배율로 디코딩할지는 스케줄러의 예산이 정함
+    static func configureLibraryLimits() {
+        DicomheroCodecFactory.setMaximumImageSize(UInt32(UInt16.max), maxHeight: UInt32(UInt16.max))
+    }
+
+    struct Statistics {
+        var admitted = 0
+        var queued = 0       // 바로 허가되지 못하고 기다린 작업 수
+        var downsampled = 0
+        var exclusive = 0    // 예산을 넘어 단독으로 실행된 작업 수
+        var bytesInUse = 0
+        var peakBytesInUse = 0
+    }
+
+    private struct Request {
+        let bytes: Int
+        let downsampleFactor: Int
+        let queue: DispatchQueue
+        let body: (DecodeTicket) -> Void
+    }
+
+    let budget: Int
+    private let lock = NSLock()
+    private var bytesInUse = 0
+    private var waiting: [Request] = [] // 도착 순서대로 대기 중인 작업
+    private var counters = Statistics()
+
+    init(budget: Int) {
+        self.budget = budget
+    }
+
+    var statistics: Statistics {
+        lock.lock()
+        defer { lock.unlock() }
+        var statistics = counters
+        statistics.bytesInUse = bytesInUse
+        return statistics
+    }
+
+    // 허가를 받으면 queue에서 body를 실행하고, 끝나면 예산을 돌려줌
+    // reducible이 true이면(축소 디코딩이 가능한 이미지) 예산을 넘을 때 축소 배율을 올려 허가함
+    func schedule(_ estimate: DecodeEstimate, reducible: Bool = false, on queue: DispatchQueue = .global(qos: .userInitiated),
+                  _ body: @escaping (DecodeTicket) -> Void) {
+        var factor = 1
+        while reducible && estimate.peakBytes(downsampleFactor: factor) > budget && factor < DecodeScheduler.maximumDownsampleFactor {
+            factor *= 2
+        }
+        let request = Request(bytes: factor > 1 ? estimate.peakBytes(downsampleFactor: factor) : estimate.peakBytes,
+                              downsampleFactor: factor, queue: queue, body: body)
+
+        lock.lock()
+        if !waiting.isEmpty || !fits(request.bytes) {
+            waiting.append(request)
+            counters.queued += 1
+            lock.unlock()
+            return
+        }
+        admit(request)
+        lock.unlock()
+        run(request)
+    }
+
+    // 예산이 남거나 아무도 예산을 쓰지 않을 때 허가 (대기열 순서는 호출하는 쪽에서 지킴)
+    private func fits(_ bytes: Int) -> Bool {
+        bytesInUse == 0 || bytesInUse + bytes <= budget
+    }
+
+    private func admit(_ request: Request) {
+        bytesInUse += request.bytes
+        counters.admitted += 1
+        counters.downsampled += request.downsampleFactor > 1 ? 1 : 0
+        counters.exclusive += request.bytes > budget ? 1 : 0
+        counters.peakBytesInUse = max(counters.peakBytesInUse, bytesInUse)
+    }
+
+    private func run(_ request: Request) {
+        request.queue.async {
+            let ticket = DecodeTicket(bytes: request.bytes, downsampleFactor: request.downsampleFactor, scheduler: self)
+            request.body(ticket)
+            ticket.release()
+        }
+    }
+
+    fileprivate func release(_ bytes: Int) {
+        lock.lock()
+        bytesInUse -= bytes
+        // 돌아온 예산으로 대기열 앞쪽부터 들어갈 수 있는 만큼 허가
+        var admitted: [Request] = []
+        while let next = waiting.first, fits(next.bytes) {
+            waiting.removeFirst()
+            admit(next)
+            admitted.append(next)
+        }
+        lock.unlock()
+        admitted.forEach { run($0) }
+    }
+}
+
+extension DicomheroImage {
+    // 단일 채널 이미지를 factor 간격으로 표본 추출한 작은 이미지로 만듦
+    // 축소 디코딩을 지원하지 않는 전송 구문에서 표시용 이미지 크기를 줄일 때 사용
+    // 원본 깊이를 유지해 부호 없는 16비트 값이 잘리지 않게 함 (썸네일 벤치마크의 전체 디코딩 쪽 기준으로도 씀)
+    func downsampled(by factor: Int) throws -> DicomheroImage {
+        guard channelsNumber == 1 else {
+            throw DicomVolumeError.unsupportedImage
+        }
+        let width = Int(self.width), height = Int(self.height)
+        let outputWidth = max(width / factor, 1), outputHeight = max(height / factor, 1)
+        // 화소 버퍼를 한 번에 받아 factor 간격으로 골라 냄 (화소마다 핸들러를 부르지 않음)
+        guard let source = try getReadingDataHandler().getMemory().data() else {
+            throw DicomVolumeError.unsupportedImage
+        }
+        func pack<Sample: FixedWidthInteger>(_ type: Sample.Type) throws -> Data {
+            guard source.count >= width * height * MemoryLayout<Sample>.stride else {
+                throw DicomVolumeError.unsupportedImage
+            }
+            var samples = [Sample](repeating: 0, count: outputWidth * outputHeight)
+            source.withUnsafeBytes { raw in
+                let pixels = raw.bindMemory(to: Sample.self)
+                for y in 0..<outputHeight {
+                    let row = y * factor * width
+                    for x in 0..<outputWidth {
+                        samples[y * outputWidth + x] = pixels[row + x * factor]
+                    }
+                }
+            }
+            return samples.withUnsafeBytes { Data($0) }
+        }
+        let bytes: Data
+        switch depth {
+        case .u8: bytes = try pack(UInt8.self)
+        case .s8: bytes = try pack(Int8.self)
+        case .u16: bytes = try pack(UInt16.self)
+        case .s16: bytes = try pack(Int16.self)
+        case .u32: bytes = try pack(UInt32.self)
+        default: bytes = try pack(Int32.self)
+        }
+        let image: DicomheroImage = DicomheroImage(width: UInt32(outputWidth), height: UInt32(outputHeight), depth: depth, colorSpace: colorSpace, highBit: highBit)
+        let writer = try image.getWritingDataHandler()
+        try writer.assign(bytes)
+        writer.commit()
+        return image
+    }
+}
@@ -9,6 +9,12 @@ import SwiftUI
 
 @main
 struct DicomApp: App {
+    init() {
+        MemoryGovernor.shared.configurePool(minimumBlockSize: MemoryGovernor.defaultPoolMinimumBlockSize,
+                                            maximumSize: MemoryGovernor.defaultPoolMaximumSize)
+        DecodeScheduler.configureLibraryLimits()
+    }
+
     var body: some Scene {
         WindowGroup {
             ContentView()
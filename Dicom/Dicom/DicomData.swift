@@ -10,4 +10,5 @@ import UIKit
 struct DicomData {
     var patientName = ""
     var image: UIImage?
+    var studies: [StudyCatalogue.Entry] = [] // 로컬 색인의 검사 목록
 }
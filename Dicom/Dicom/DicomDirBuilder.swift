@@ -0,0 +1,281 @@
+//
+//  DicomDirBuilder.swift
+//  Dicom
+//
+//  Created by hanjongwoo on 10/19/26.
+//
+
+import Foundation
+
+// 헤더만 읽어 모은 인스턴스 하나 (values는 DicomDirBuilder.scannedTags 순서)
+struct DicomDirInstance {
+    let fileParts: [String] // 루트 기준 경로 요소 (Referenced File ID)
+    let values: [String]
+}
+
+// 폴더 아래 파일들을 병렬로 헤더만 읽고 환자/검사/시리즈/영상 계층으로 묶어 DICOMDIR을 만듦
+// 인스턴스를 계층 키 순서로 정렬한 뒤 한 번 훑으면서 레코드를 잇고, updateDataSet은 마지막에 한 번만 부름
+final class DicomDirBuilder {
+    struct Configuration {
+        var readers = ProcessInfo.processInfo.activeProcessorCount
+        var maxBufferSize: UInt32 = 2048 // 라이브러리로 읽을 때 이보다 큰 태그(픽셀 데이터)는 읽지 않음
+        var fileSetID = ""
+    }
+
+    struct Statistics {
+        var files = 0
+        var instances = 0
+        var skipped = 0
+        var patients = 0
+        var studies = 0
+        var series = 0
+        var scanSeconds = 0.0
+        var buildSeconds = 0.0
+        var writeSeconds = 0.0
+
+        var filesPerSecond: Double { scanSeconds > 0 ? Double(files) / scanSeconds : 0 }
+        var totalSeconds: Double { scanSeconds + buildSeconds + writeSeconds }
+    }
+
+    static let recordTypes = ["PATIENT", "STUDY", "SERIES", "IMAGE"]
+
+    // 레벨마다 레코드에 옮겨 적는 태그 (첫 태그가 그 레벨의 키)
+    static let recordTags: [[DicomheroTagEnum]] = [
+        [.enumPatientID_0010_0020, .enumPatientName_0010_0010, .enumPatientBirthDate_0010_0030, .enumPatientSex_0010_0040],
+        [.enumStudyInstanceUID_0020_000D, .enumStudyDate_0008_0020, .enumStudyTime_0008_0030,
+         .enumStudyID_0020_0010, .enumAccessionNumber_0008_0050, .enumStudyDescription_0008_1030],
+        [.enumSeriesInstanceUID_0020_000E, .enumModality_0008_0060, .enumSeriesNumber_0020_0011],
+        [.enumSOPInstanceUID_0008_0018, .enumInstanceNumber_0020_0013, .enumSOPClassUID_0008_0016, .enumTransferSyntaxUID_0002_0010]
+    ]
+
+    // 영상 레코드에서는 이름을 바꿔 적는 태그
+    private static let referencedTags: [DicomheroTagEnum: DicomheroTagEnum] = [
+        .enumSOPInstanceUID_0008_0018: .enumReferencedSOPInstanceUIDInFile_0004_1511,
+        .enumSOPClassUID_0008_0016: .enumReferencedSOPClassUIDInFile_0004_1510,
+        .enumTransferSyntaxUID_0002_0010: .enumReferencedTransferSyntaxUIDInFile_0004_1512
+    ]
+
+    static let scannedTags = Array(recordTags.joined())
+    private static let levelOffsets = recordTags.reduce(into: [0]) { $0.append($0.last! + $1.count) }
+    private static let instanceNumberIndex = scannedTags.firstIndex(of: .enumInstanceNumber_0020_0013)!
+    private static let lastScannedTag = scannedTags.map(\.rawValue).max()!
+
+    let configuration: Configuration
+
+    init(configuration: Configuration = Configuration()) {
+        self.configuration = configuration
+    }
+
+    // root 아래를 훑어 root/DICOMDIR로 저장
+    func write(root: URL) throws -> Statistics {
+        var statistics = Statistics()
+        let dataSet = try build(root: root, statistics: &statistics)
+        let start = DispatchTime.now().uptimeNanoseconds
+        try DicomheroCodecFactory.save(toFile: root.appendingPathComponent("DICOMDIR").path, dataSet: dataSet, codecType: .dicom)
+        statistics.writeSeconds = DicomDirBuilder.elapsed(since: start)
+        return statistics
+    }
+
+    func build(root: URL, statistics: inout Statistics) throws -> DicomheroDataSet {
+        var start = DispatchTime.now().uptimeNanoseconds
+        let urls = DicomDirBuilder.files(under: root)
+        let instances = scan(urls, root: root)
+        statistics.files = urls.count
+        statistics.instances = instances.count
+        statistics.skipped = urls.count - instances.count
+        statistics.scanSeconds = DicomDirBuilder.elapsed(since: start)
+
+        start = DispatchTime.now().uptimeNanoseconds
+        let dataSet = try build(instances, statistics: &statistics)
+        statistics.buildSeconds = DicomDirBuilder.elapsed(since: start)
+        return dataSet
+    }
+
+    // 읽는 스레드마다 자기 몫을 따로 모았다가 마지막에 합침 (DICOM이 아닌 파일은 빠짐)
+    func scan(_ urls: [URL], root: URL) -> [DicomDirInstance] {
+        let rootDepth = root.standardizedFileURL.pathComponents.count
+        let readers = max(1, min(configuration.readers, urls.count))
+        var parts = [[DicomDirInstance]](repeating: [], count: readers)
+        let lock = NSLock()
+        DispatchQueue.concurrentPerform(iterations: readers) { reader in
+            var local: [DicomDirInstance] = []
+            local.reserveCapacity(urls.count / readers + 1)
+            for index in stride(from: reader, to: urls.count, by: readers) {
+                autoreleasepool {
+                    if let instance = read(urls[index], rootDepth: rootDepth) {
+                        local.append(instance)
+                    }
+                }
+            }
+            lock.lock()
+            parts[reader] = local
+            lock.unlock()
+        }
+        return Array(parts.joined())
+    }
+
+    func build(_ instances: [DicomDirInstance], statistics: inout Statistics) throws -> DicomheroDataSet {
+        let sorted = instances.sorted(by: DicomDirBuilder.precedes)
+        let dicomDir = DicomheroDicomDir()
+        var previous: [DicomheroDicomDirEntry?] = Array(repeating: nil, count: DicomDirBuilder.recordTypes.count)
+        var keys: [String?] = Array(repeating: nil, count: DicomDirBuilder.recordTypes.count - 1)
+        for instance in sorted {
+            // 키가 처음 달라지는 레벨부터 아래로 레코드를 새로 만듦 (영상은 항상 새로)
+            let changed = (0..<keys.count).first { keys[$0] != DicomDirBuilder.key(instance, level: $0) } ?? keys.count
+            for level in changed..<DicomDirBuilder.recordTypes.count {
+                let entry = try makeEntry(dicomDir, level: level, instance: instance)
+                if let sibling = previous[level] {
+                    try sibling.setNextEntry(entry)
+                } else if level == 0 {
+                    try dicomDir.setFirstRootEntry(entry)
+                } else {
+                    try previous[level - 1]!.setFirstChildEntry(entry)
+                }
+                previous[level] = entry
+                for deeper in level + 1..<previous.count {
+                    previous[deeper] = nil
+                }
+                if level < keys.count {
+                    keys[level] = DicomDirBuilder.key(instance, level: level)
+                }
+                switch level {
+                case 0: statistics.patients += 1
+                case 1: statistics.studies += 1
+                case 2: statistics.series += 1
+                default: break
+                }
+            }
+        }
+        let dataSet = try dicomDir.updateDataSet()
+        if !configuration.fileSetID.isEmpty {
+            try dataSet.setString(DicomheroTagId(id: .enumFileSetID_0004_1130), newValue: configuration.fileSetID)
+        }
+        return dataSet
+    }
+
+    private func makeEntry(_ dicomDir: DicomheroDicomDir, level: Int, instance: DicomDirInstance) throws -> DicomheroDicomDirEntry {
+        let entry = try dicomDir.getNewEntry(DicomDirBuilder.recordTypes[level])
+        let dataSet: DicomheroDataSet = entry.getEntryDataSet()
+        for (offset, tag) in DicomDirBuilder.recordTags[level].enumerated() {
+            let value = instance.values[DicomDirBuilder.levelOffsets[level] + offset]
+            guard !value.isEmpty else { continue }
+            let target = level == DicomDirBuilder.recordTypes.count - 1 ? DicomDirBuilder.referencedTags[tag] ?? tag : tag
+            try dataSet.setString(DicomheroTagId(id: target), newValue: value)
+        }
+        if level == DicomDirBuilder.recordTypes.count - 1 {
+            try entry.setFileParts(instance.fileParts)
+        }
+        return entry
+    }
+
+    // 라이브러리 데이터셋을 만들지 않고 파일 바이트에서 필요한 태그까지만 읽음
+    // CompactDataSet이 다루지 않는 전송 구문(빅 엔디언, deflate)만 라이브러리로 읽음
+    private func read(_ url: URL, rootDepth: Int) -> DicomDirInstance? {
+        do {
+            let values: [String]
+            do {
+                let compact = try CompactDataSet(url: url, stopAfter: DicomDirBuilder.lastScannedTag)
+                values = DicomDirBuilder.scannedTags.map { compact.string($0) ?? "" }
+            } catch CompactDataSetError.unsupportedTransferSyntax {
+                let dataSet = try DicomheroCodecFactory.load(fromFileMaxSize: url.path, maxBufferSize: configuration.maxBufferSize)
+                values = try DicomDirBuilder.scannedTags.map {
+                    try dataSet.getString(DicomheroTagId(id: $0), elementNumber: 0, defaultValue: "")
+                }
+            }
+            guard !values[DicomDirBuilder.levelOffsets[3]].isEmpty else { return nil }
+            return DicomDirInstance(fileParts: Array(url.standardizedFileURL.pathComponents.dropFirst(rootDepth)), values: values)
+        } catch {
+            return nil
+        }
+    }
+
+    private static func key(_ instance: DicomDirInstance, level: Int) -> String {
+        instance.values[levelOffsets[level]]
+    }
+
+    private static func precedes(_ lhs: DicomDirInstance, _ rhs: DicomDirInstance) -> Bool {
+        for level in 0..<recordTypes.count - 1 where key(lhs, level: level) != key(rhs, level: level) {
+            return key(lhs, level: level) < key(rhs, level: level)
+        }
+        let left = Int(lhs.values[instanceNumberIndex]) ?? 0, right = Int(rhs.values[instanceNumberIndex]) ?? 0
+        return left != right ? left < right : key(lhs, level: 3) < key(rhs, level: 3)
+    }
+
+    private static func files(under root: URL) -> [URL] {
+        guard let enumerator = FileManager.default.enumerator(at: root, includingPropertiesForKeys: [.isRegularFileKey],
+                                                              options: [.skipsHiddenFiles]) else {
+            return []
+        }
+        return enumerator.compactMap { $0 as? URL }.filter {
+            $0.lastPathComponent != "DICOMDIR" && (try? $0.resourceValues(forKeys: [.isRegularFileKey]).isRegularFile) == true
+        }
+    }
+
+    private static func elapsed(since start: UInt64) -> Double {
+        Double(DispatchTime.now().uptimeNanoseconds - start) / 1e9
+    }
+}
+
+struct DicomDirMeasurement {
+    var images = 0
+    var corpusSeconds = 0.0
+    var statistics = DicomDirBuilder.Statistics()
+}
+
+enum DicomDirBenchmark {
+    // 픽셀 없는 합성 인스턴스 images개를 미디어 배치(환자/검사/시리즈/영상, 요소당 8자)로 만들고 DICOMDIR 생성 시간을 잼
+    static func run(images: Int = 50_000, imagesPerSeries: Int = 100, seriesPerStudy: Int = 4,
+                    studiesPerPatient: Int = 2) -> DicomDirMeasurement {
+        var measurement = DicomDirMeasurement(images: images)
+        let root = FileManager.default.temporaryDirectory.appendingPathComponent("DicomDirBenchmark-\(UUID().uuidString)")
+        defer { try? FileManager.default.removeItem(at: root) }
+
+        let start = DispatchTime.now().uptimeNanoseconds
+        let uidRoot = "1.2.826.0.1.3680043.10.1234"
+        let modalities = ["CT", "MR", "CR", "US"]
+        let seriesCount = max(1, (images + imagesPerSeries - 1) / imagesPerSeries)
+        DispatchQueue.concurrentPerform(iterations: seriesCount) { seriesIndex in
+            let study = seriesIndex / seriesPerStudy, patient = study / studiesPerPatient
+            let directory = root.appendingPathComponent(String(format: "P%07d", patient))
+                .appendingPathComponent(String(format: "S%07d", study))
+                .appendingPathComponent(String(format: "E%07d", seriesIndex % seriesPerStudy))
+            do {
+                try FileManager.default.createDirectory(at: directory, withIntermediateDirectories: true)
+                for image in 0..<min(imagesPerSeries, images - seriesIndex * imagesPerSeries) {
+                    try autoreleasepool {
+                        let dataSet = DicomheroDataSet(transferSyntax: TransferSyntaxKind.explicitLittleEndian)
+                        let values: [(DicomheroTagEnum, String)] = [
+                            (.enumSOPClassUID_0008_0016, WellKnownUID.string(for: WellKnownUID.ctImageStorage)),
+                            (.enumSOPInstanceUID_0008_0018, "\(uidRoot).3.\(seriesIndex).\(image)"),
+                            (.enumPatientID_0010_0020, String(format: "P%07d", patient)),
+                            (.enumPatientName_0010_0010, "PATIENT^\(patient)"),
+                            (.enumStudyInstanceUID_0020_000D, "\(uidRoot).1.\(study)"),
+                            (.enumStudyDate_0008_0020, String(20150101 + (study % 10) * 10000 + (study % 12) * 100 + study % 28)),
+                            (.enumStudyID_0020_0010, String(study)),
+                            (.enumAccessionNumber_0008_0050, "A\(study)"),
+                            (.enumSeriesInstanceUID_0020_000E, "\(uidRoot).2.\(seriesIndex)"),
+                            (.enumModality_0008_0060, modalities[seriesIndex % modalities.count]),
+                            (.enumSeriesNumber_0020_0011, String(seriesIndex % seriesPerStudy + 1)),
+                            (.enumInstanceNumber_0020_0013, String(image + 1))
+                        ]
+                        for (tag, value) in values {
+                            try dataSet.setString(DicomheroTagId(id: tag), newValue: value)
+                        }
+                        try DicomheroCodecFactory.save(toFile: directory.appendingPathComponent(String(format: "I%07d", image)).path,
+                                                       dataSet: dataSet, codecType: .dicom)
+                    }
+                }
+            } catch {
+                print("caught: \(error)")
+            }
+        }
+        measurement.corpusSeconds = Double(DispatchTime.now().uptimeNanoseconds - start) / 1e9
+
+        do {
+            measurement.statistics = try DicomDirBuilder().write(root: root)
+        } catch {
+            print("caught: \(error)")
+        }
+        return measurement
+    }
+}
@@ -0,0 +1,577 @@
+//
+//  DicomPDU.swift
+//  Dicom
+//
+//  Created by hanjongwoo on 10/19/26.
+//
+
+import Foundation
+
+// DICOM 상위 계층(PS3.8) PDU와 DIMSE 명령 집합의 최소 구현
+// 라이브러리의 ACSE는 연결마다 스레드를 막고 읽으므로, 비동기 소켓 계층에서 쓰려고 직접 구현함
+
+enum PDUType: UInt8 {
+    case associateRequest = 0x01
+    case associateAccept = 0x02
+    case associateReject = 0x03
+    case dataTransfer = 0x04
+    case releaseRequest = 0x05
+    case releaseResponse = 0x06
+    case abort = 0x07
+}
+
+enum PDUError: Error {
+    case unknownType(UInt8)
+    case tooLarge(Int)
+    case malformed(String)
+}
+
+struct PDU {
+    let type: PDUType
+    let body: [UInt8] // 6바이트 헤더를 뺀 가변 필드
+}
+
+// 빅 엔디언(PDU)과 리틀 엔디언(명령 집합) 값을 이어 쓰는 버퍼
+struct ByteWriter {
+    var bytes: [UInt8] = []
+
+    mutating func uint8(_ value: UInt8) {
+        bytes.append(value)
+    }
+
+    mutating func uint16BE(_ value: UInt16) {
+        bytes.append(UInt8(value >> 8))
+        bytes.append(UInt8(value & 0xFF))
+    }
+
+    mutating func uint32BE(_ value: UInt32) {
+        uint16BE(UInt16(value >> 16))
+        uint16BE(UInt16(value & 0xFFFF))
+    }
+
+    mutating func uint16LE(_ value: UInt16) {
+        bytes.append(UInt8(value & 0xFF))
+        bytes.append(UInt8(value >> 8))
+    }
+
+    mutating func uint32LE(_ value: UInt32) {
+        uint16LE(UInt16(value & 0xFFFF))
+        uint16LE(UInt16(value >> 16))
+    }
+
+    mutating func zeros(_ count: Int) {
+        bytes.append(contentsOf: repeatElement(0, count: count))
+    }
+
+    // AE 타이틀: 16바이트, 공백으로 채움
+    mutating func aeTitle(_ title: String) {
+        let utf8 = Array(title.utf8.prefix(16))
+        bytes.append(contentsOf: utf8)
+        bytes.append(contentsOf: repeatElement(0x20, count: 16 - utf8.count))
+    }
+
+    // 항목 타입, 예약 1바이트, 2바이트 길이 뒤에 body가 쓴 내용을 붙임
+    mutating func item(_ type: UInt8, _ body: (inout ByteWriter) -> Void) {
+        uint8(type)
+        uint8(0)
+        let lengthIndex = bytes.count
+        uint16BE(0)
+        body(&self)
+        let length = bytes.count - lengthIndex - 2
+        bytes[lengthIndex] = UInt8(length >> 8)
+        bytes[lengthIndex + 1] = UInt8(length & 0xFF)
+    }
+
+    mutating func item(_ type: UInt8, string: String) {
+        item(type) { $0.bytes.append(contentsOf: string.utf8) }
+    }
+
+    // PDU 헤더(타입, 예약, 4바이트 길이) 뒤에 body가 쓴 내용을 붙임
+    static func pdu(_ type: PDUType, _ body: (inout ByteWriter) -> Void) -> [UInt8] {
+        var writer = ByteWriter()
+        writer.uint8(type.rawValue)
+        writer.uint8(0)
+        writer.uint32BE(0)
+        body(&writer)
+        let length = UInt32(writer.bytes.count - 6)
+        writer.bytes[2] = UInt8(length >> 24)
+        writer.bytes[3] = UInt8((length >> 16) & 0xFF)
+        writer.bytes[4] = UInt8((length >> 8) & 0xFF)
+        writer.bytes[5] = UInt8(length & 0xFF)
+        return writer.bytes
+    }
+}
+
+struct ByteReader {
+    let bytes: ArraySlice<UInt8>
+    private(set) var index: Int
+
+    init(_ bytes: ArraySlice<UInt8>) {
+        self.bytes = bytes
+        index = bytes.startIndex
+    }
+
+    var isAtEnd: Bool { index >= bytes.endIndex }
+
+    mutating func take(_ count: Int) throws -> ArraySlice<UInt8> {
+        guard count >= 0, bytes.endIndex - index >= count else {
+            throw PDUError.malformed("unexpected end of item")
+        }
+        defer { index += count }
+        return bytes[index..<index + count]
+    }
+
+    mutating func uint8() throws -> UInt8 {
+        try take(1).first!
+    }
+
+    mutating func uint16BE() throws -> UInt16 {
+        let value = try take(2)
+        return UInt16(value[value.startIndex]) << 8 | UInt16(value[value.startIndex + 1])
+    }
+
+    mutating func uint32BE() throws -> UInt32 {
+        UInt32(try uint16BE()) << 16 | UInt32(try uint16BE())
+    }
+
+    mutating func uint16LE() throws -> UInt16 {
+        let value = try take(2)
+        return UInt16(value[value.startIndex]) | UInt16(value[value.startIndex + 1]) << 8
+    }
+
+    mutating func uint32LE() throws -> UInt32 {
+        UInt32(try uint16LE()) | UInt32(try uint16LE()) << 16
+    }
+
+    // 앞뒤 공백/NUL을 제거한 문자열
+    mutating func string(_ count: Int) throws -> String {
+        String.trimmedDicom(try take(count))
+    }
+}
+
+extension String {
+    static func trimmedDicom(_ bytes: ArraySlice<UInt8>, characterSet: SpecificCharacterSet = .default) -> String {
+        var lower = bytes.startIndex, upper = bytes.endIndex
+        while lower < upper && (bytes[lower] == 0x20 || bytes[lower] == 0) { lower += 1 }
+        while upper > lower && (bytes[upper - 1] == 0x20 || bytes[upper - 1] == 0) { upper -= 1 }
+        return characterSet.decode(bytes[lower..<upper])
+    }
+}
+
+// 소켓에서 조각조각 들어오는 바이트를 받아 완성된 PDU를 하나씩 꺼냄
+struct PDUParser {
+    let maxBodyLength: Int
+    private var buffer: [UInt8] = []
+    private var start = 0
+
+    init(maxBodyLength: Int) {
+        self.maxBodyLength = maxBodyLength
+    }
+
+    var bufferedBytes: Int { buffer.count - start }
+
+    mutating func append(_ bytes: UnsafeRawBufferPointer) {
+        // 이미 꺼낸 앞부분이 절반을 넘으면 당겨서 버퍼가 계속 자라지 않게 함
+        if start > 0 && start * 2 >= buffer.count {
+            buffer.removeFirst(start)
+            start = 0
+        }
+        buffer.append(contentsOf: bytes)
+    }
+
+    mutating func next() throws -> PDU? {
+        guard buffer.count - start >= 6 else {
+            return nil
+        }
+        guard let type = PDUType(rawValue: buffer[start]) else {
+            throw PDUError.unknownType(buffer[start])
+        }
+        let length = Int(buffer[start + 2]) << 24 | Int(buffer[start + 3]) << 16
+                   | Int(buffer[start + 4]) << 8 | Int(buffer[start + 5])
+        guard length <= maxBodyLength else {
+            throw PDUError.tooLarge(length)
+        }
+        guard buffer.count - start - 6 >= length else {
+            return nil
+        }
+        let body = Array(buffer[start + 6..<start + 6 + length])
+        start += 6 + length
+        if start == buffer.count {
+            buffer.removeAll(keepingCapacity: false) // 대기 중인 연결이 큰 버퍼를 붙잡고 있지 않게 함
+            start = 0
+        }
+        return PDU(type: type, body: body)
+    }
+}
+
+// 표현 컨텍스트 항목 (RQ에서는 추상 구문과 후보 전송 구문, AC에서는 결과와 선택된 전송 구문)
+struct PresentationContextItem {
+    var id: UInt8
+    var result: UInt8 = 0 // 0: 수락, 3: 추상 구문 미지원, 4: 전송 구문 미지원
+    var abstractSyntax = ""
+    var transferSyntaxes: [String] = []
+}
+
+// A-ASSOCIATE-RQ / A-ASSOCIATE-AC 공통 형식
+struct AssociationPDU {
+    static let applicationContextName = "1.2.840.10008.3.1.1.1"
+    static let implementationClassUID = "2.25.208154620953436911257893712104567342"
+
+    var calledAET: String
+    var callingAET: String
+    var presentationContexts: [PresentationContextItem] = []
+    var maxPDULength: UInt32 = 16384 // 0이면 제한 없음
+    var implementationClassUID = AssociationPDU.implementationClassUID
+    // 비동기 연산 창 (응답을 기다리지 않고 보낼/처리할 수 있는 연산 수, 0은 제한 없음). nil이면 1개씩
+    var asyncOperationsWindow: (invoked: UInt16, performed: UInt16)?
+
+    init(calledAET: String, callingAET: String) {
+        self.calledAET = calledAET
+        self.callingAET = callingAET
+    }
+
+    init(parsing body: [UInt8]) throws {
+        var reader = ByteReader(body[...])
+        _ = try reader.take(4) // 프로토콜 버전, 예약
+        calledAET = try reader.string(16)
+        callingAET = try reader.string(16)
+        _ = try reader.take(32)
+        while !reader.isAtEnd {
+            let type = try reader.uint8()
+            _ = try reader.uint8()
+            var item = ByteReader(try reader.take(Int(try reader.uint16BE())))
+            switch type {
+            case 0x20, 0x21:
+                var context = PresentationContextItem(id: try item.uint8())
+                _ = try item.uint8()
+                context.result = try item.uint8()
+                _ = try item.uint8()
+                while !item.isAtEnd {
+                    let subType = try item.uint8()
+                    _ = try item.uint8()
+                    let value = try item.string(Int(try item.uint16BE()))
+                    if subType == 0x30 {
+                        context.abstractSyntax = value
+                    } else if subType == 0x40 {
+                        context.transferSyntaxes.append(value)
+                    }
+                }
+                presentationContexts.append(context)
+            case 0x50:
+                while !item.isAtEnd {
+                    let subType = try item.uint8()
+                    _ = try item.uint8()
+                    var value = ByteReader(try item.take(Int(try item.uint16BE())))
+                    if subType == 0x51 {
+                        maxPDULength = try value.uint32BE()
+                    } else if subType == 0x52 {
+                        implementationClassUID = try value.string(value.bytes.count)
+                    } else if subType == 0x53 {
+                        asyncOperationsWindow = (try value.uint16BE(), try value.uint16BE())
+                    }
+                }
+            default:
+                break // 0x10 응용 컨텍스트 등은 고정값이므로 확인하지 않음
+            }
+        }
+    }
+
+    func encoded(as type: PDUType) -> [UInt8] {
+        ByteWriter.pdu(type) { writer in
+            writer.uint16BE(1)
+            writer.uint16BE(0)
+            writer.aeTitle(calledAET)
+            writer.aeTitle(callingAET)
+            writer.zeros(32)
+            writer.item(0x10, string: AssociationPDU.applicationContextName)
+            for context in presentationContexts {
+                writer.item(type == .associateRequest ? 0x20 : 0x21) { item in
+                    item.uint8(context.id)
+                    item.uint8(0)
+                    item.uint8(type == .associateRequest ? 0 : context.result)
+                    item.uint8(0)
+                    if type == .associateRequest {
+                        item.item(0x30, string: context.abstractSyntax)
+                        context.transferSyntaxes.forEach { item.item(0x40, string: $0) }
+                    } else {
+                        item.item(0x40, string: context.transferSyntaxes.first ?? "")
+                    }
+                }
+            }
+            writer.item(0x50) { item in
+                item.item(0x51) { $0.uint32BE(maxPDULength) }
+                item.item(0x52, string: implementationClassUID)
+                if let window = asyncOperationsWindow {
+                    item.item(0x53) {
+                        $0.uint16BE(window.invoked)
+                        $0.uint16BE(window.performed)
+                    }
+                }
+            }
+        }
+    }
+
+    static func reject(result: UInt8 = 1, source: UInt8 = 1, reason: UInt8 = 1) -> [UInt8] {
+        ByteWriter.pdu(.associateReject) { $0.bytes += [0, result, source, reason] }
+    }
+
+    static func releaseRequest() -> [UInt8] {
+        ByteWriter.pdu(.releaseRequest) { $0.zeros(4) }
+    }
+
+    static func releaseResponse() -> [UInt8] {
+        ByteWriter.pdu(.releaseResponse) { $0.zeros(4) }
+    }
+
+    static func abort(source: UInt8 = 2, reason: UInt8 = 0) -> [UInt8] {
+        ByteWriter.pdu(.abort) { $0.bytes += [0, 0, source, reason] }
+    }
+}
+
+// P-DATA-TF 안의 값 조각(PDV)
+struct PDV {
+    let contextID: UInt8
+    let isCommand: Bool
+    let isLast: Bool
+    let data: ArraySlice<UInt8>
+}
+
+enum PDataTransfer {
+    static func pdvs(in body: [UInt8]) throws -> [PDV] {
+        var reader = ByteReader(body[...])
+        var items: [PDV] = []
+        while !reader.isAtEnd {
+            let length = Int(try reader.uint32BE())
+            guard length >= 2 else {
+                throw PDUError.malformed("PDV item too short")
+            }
+            let contextID = try reader.uint8()
+            let header = try reader.uint8()
+            items.append(PDV(contextID: contextID, isCommand: header & 1 != 0, isLast: header & 2 != 0,
+                             data: try reader.take(length - 2)))
+        }
+        return items
+    }
+
+    // 최대 PDU 길이 0은 제한 없음. 1~6은 PDV 머리(6바이트)만으로 차서 데이터를 실을 수 없음
+    static func canFragment(maxPDULength: Int) -> Bool {
+        maxPDULength == 0 || maxPDULength > 6
+    }
+
+    // 명령과 데이터셋을 상대의 최대 PDU 길이에 맞춰 P-DATA-TF PDU들로 나눔 (PDU 하나에 PDV 하나)
+    static func encode(contextID: UInt8, command: [UInt8], dataSet: [UInt8]?, maxPDULength: Int) throws -> [[UInt8]] {
+        guard canFragment(maxPDULength: maxPDULength) else {
+            throw PDUError.malformed("maximum PDU length \(maxPDULength) too small")
+        }
+        let fragment = maxPDULength == 0 ? Int(UInt32.max >> 1) : maxPDULength - 6
+        var pdus: [[UInt8]] = []
+        func append(_ bytes: [UInt8], command: Bool) {
+            var offset = 0
+            repeat {
+                let count = min(fragment, bytes.count - offset)
+                pdus.append(pdu(contextID: contextID, bytes[offset..<offset + count],
+                                isCommand: command, isLast: offset + count == bytes.count))
+                offset += count
+            } while offset < bytes.count
+        }
+        append(command, command: true)
+        if let dataSet {
+            append(dataSet, command: false)
+        }
+        return pdus
+    }
+
+    // PDV 하나를 담은 P-DATA-TF PDU (데이터셋을 나눠 보낼 때는 마지막 조각에만 isLast)
+    static func pdu(contextID: UInt8, _ fragment: ArraySlice<UInt8>, isCommand: Bool, isLast: Bool) -> [UInt8] {
+        ByteWriter.pdu(.dataTransfer) { writer in
+            writer.uint32BE(UInt32(fragment.count + 2))
+            writer.uint8(contextID)
+            writer.uint8((isCommand ? 1 : 0) | (isLast ? 2 : 0))
+            writer.bytes.append(contentsOf: fragment)
+        }
+    }
+}
+
+// 명령 집합(그룹 0000, 암시적 VR 리틀 엔디언)
+struct DimseCommandSet {
+    static let affectedSOPClassUID: UInt16 = 0x0002
+    static let commandField: UInt16 = 0x0100
+    static let messageID: UInt16 = 0x0110
+    static let messageIDBeingRespondedTo: UInt16 = 0x0120
+    static let moveDestination: UInt16 = 0x0600
+    static let priority: UInt16 = 0x0700
+    static let commandDataSetType: UInt16 = 0x0800
+    static let status: UInt16 = 0x0900
+    static let affectedSOPInstanceUID: UInt16 = 0x1000
+
+    static let noDataSet: UInt16 = 0x0101
+
+    // 명령 필드 값
+    static let cStoreRequest: UInt16 = 0x0001
+    static let cEchoRequest: UInt16 = 0x0030
+    static let responseBit: UInt16 = 0x8000
+
+    private(set) var elements: [UInt16: [UInt8]] = [:]
+
+    init() {}
+
+    init(parsing bytes: ArraySlice<UInt8>) throws {
+        var reader = ByteReader(bytes)
+        while !reader.isAtEnd {
+            let group = try reader.uint16LE()
+            let element = try reader.uint16LE()
+            let value = try reader.take(Int(try reader.uint32LE()))
+            if group == 0 && element != 0 {
+                elements[element] = Array(value)
+            }
+        }
+    }
+
+    func uint16(_ element: UInt16) -> UInt16? {
+        guard let value = elements[element], value.count >= 2 else {
+            return nil
+        }
+        return UInt16(value[0]) | UInt16(value[1]) << 8
+    }
+
+    func string(_ element: UInt16) -> String? {
+        elements[element].map { String.trimmedDicom($0[...]) }
+    }
+
+    mutating func set(_ element: UInt16, uint16 value: UInt16) {
+        elements[element] = [UInt8(value & 0xFF), UInt8(value >> 8)]
+    }
+
+    // UID는 NUL, 그 밖의 문자열(AE 타이틀)은 공백으로 짝수 길이를 맞춤
+    mutating func set(_ element: UInt16, string value: String, padding: UInt8 = 0) {
+        var bytes = Array(value.utf8)
+        if bytes.count % 2 == 1 {
+            bytes.append(padding)
+        }
+        elements[element] = bytes
+    }
+
+    var command: UInt16 { uint16(DimseCommandSet.commandField) ?? 0 }
+    var hasDataSet: Bool { uint16(DimseCommandSet.commandDataSetType).map { $0 != DimseCommandSet.noDataSet } ?? false }
+
+    // 그룹 길이(0000,0000)를 앞에 붙여 태그 순서대로 씀
+    func encoded() -> [UInt8] {
+        var body = ByteWriter()
+        for element in elements.keys.sorted() {
+            let value = elements[element]!
+            body.uint16LE(0)
+            body.uint16LE(element)
+            body.uint32LE(UInt32(value.count))
+            body.bytes.append(contentsOf: value)
+        }
+        var writer = ByteWriter()
+        writer.uint16LE(0)
+        writer.uint16LE(0)
+        writer.uint32LE(4)
+        writer.uint32LE(UInt32(body.bytes.count))
+        writer.bytes.append(contentsOf: body.bytes)
+        return writer.bytes
+    }
+
+    static func request(_ command: UInt16, messageID: UInt16, sopClassUID: String,
+                        sopInstanceUID: String? = nil, hasDataSet: Bool) -> DimseCommandSet {
+        var set = DimseCommandSet()
+        set.set(affectedSOPClassUID, string: sopClassUID)
+        set.set(commandField, uint16: command)
+        set.set(self.messageID, uint16: messageID)
+        if command == cStoreRequest {
+            set.set(priority, uint16: 0)
+        }
+        set.set(commandDataSetType, uint16: hasDataSet ? 0x0000 : noDataSet)
+        if let sopInstanceUID {
+            set.set(affectedSOPInstanceUID, string: sopInstanceUID)
+        }
+        return set
+    }
+
+    // 요청에 대한 응답 명령 (데이터셋 없음)
+    static func response(to request: DimseCommandSet, status: UInt16) -> DimseCommandSet {
+        var set = DimseCommandSet()
+        set.elements[affectedSOPClassUID] = request.elements[affectedSOPClassUID]
+        set.set(commandField, uint16: request.command | responseBit)
+        set.elements[messageIDBeingRespondedTo] = request.elements[messageID]
+        set.set(commandDataSetType, uint16: noDataSet)
+        set.set(self.status, uint16: status)
+        set.elements[affectedSOPInstanceUID] = request.elements[affectedSOPInstanceUID]
+        return set
+    }
+}
+
+// 완성된 DIMSE 메시지: 명령 집합과 (있으면) 협상된 전송 구문으로 인코딩된 데이터셋
+struct DimseMessage {
+    let contextID: UInt8
+    let command: DimseCommandSet
+    let dataSet: [UInt8]?
+}
+
+// PDV 조각을 모아 DIMSE 메시지를 완성함
+// 데이터셋이 따라오는 명령이 완성되면 dataSetCommand를 알리고, 호출자가 streamDataSet()을 부르면
+// 그 데이터셋은 모으지 않고 조각 그대로 넘김 (파일로 바로 쓰는 수신용)
+struct DimseAssembler {
+    enum Event {
+        case message(DimseMessage)
+        case dataSetCommand(contextID: UInt8, command: DimseCommandSet)
+        case dataSetFragment(ArraySlice<UInt8>, isLast: Bool)
+    }
+
+    private var commandBytes: [UInt8] = []
+    private var dataSetBytes: [UInt8] = []
+    private var pendingCommand: DimseCommandSet?
+    private var streaming = false
+
+    // 데이터셋을 모두 모은 메시지만 돌려줌
+    mutating func append(_ pdv: PDV) throws -> DimseMessage? {
+        if case .message(let message)? = try next(pdv) {
+            return message
+        }
+        return nil
+    }
+
+    // dataSetCommand 직후에 호출하면 현재 명령의 데이터셋을 조각으로 넘김
+    mutating func streamDataSet() {
+        streaming = pendingCommand != nil
+    }
+
+    mutating func next(_ pdv: PDV) throws -> Event? {
+        if pdv.isCommand {
+            guard pendingCommand == nil else {
+                throw PDUError.malformed("command fragment while waiting for data set")
+            }
+            commandBytes.append(contentsOf: pdv.data)
+            guard pdv.isLast else {
+                return nil
+            }
+            let command = try DimseCommandSet(parsing: commandBytes[...])
+            commandBytes = []
+            if command.hasDataSet {
+                pendingCommand = command
+                return .dataSetCommand(contextID: pdv.contextID, command: command)
+            }
+            return .message(DimseMessage(contextID: pdv.contextID, command: command, dataSet: nil))
+        }
+        guard let command = pendingCommand else {
+            throw PDUError.malformed("data set fragment without command")
+        }
+        if streaming {
+            if pdv.isLast {
+                pendingCommand = nil
+                streaming = false
+            }
+            return .dataSetFragment(pdv.data, isLast: pdv.isLast)
+        }
+        dataSetBytes.append(contentsOf: pdv.data)
+        guard pdv.isLast else {
+            return nil
+        }
+        defer {
+            dataSetBytes = []
+            pendingCommand = nil
+        }
+        return .message(DimseMessage(contextID: pdv.contextID, command: command, dataSet: dataSetBytes))
+    }
+}
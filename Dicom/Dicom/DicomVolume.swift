@@ -0,0 +1,339 @@
+//
+//  DicomVolume.swift
+//  Dicom
+//
+//  Created by hanjongwoo on 10/19/26.
+//
+
+import Foundation
+import simd
+
+// MPR/렌더링이 볼륨의 저장 방식(일반 버퍼, 압축 브릭 등)과 무관하게 복셀을 읽기 위한 인터페이스
+protocol VolumeSampling: AnyObject {
+    var width: Int { get }
+    var height: Int { get }
+    var depth: Int { get }
+    var spacing: SIMD3<Float> { get }
+
+    func value(x: Int, y: Int, z: Int) -> Int16
+
+    // start에서 한 축(0: x, 1: y, 2: z)을 따라 이어진 복셀 count개를 읽음
+    func line(from start: SIMD3<Int>, axis: Int, count: Int, into output: UnsafeMutablePointer<Int16>)
+}
+
+extension VolumeSampling {
+    func line(from start: SIMD3<Int>, axis: Int, count: Int, into output: UnsafeMutablePointer<Int16>) {
+        var p = start
+        for i in 0..<count {
+            output[i] = value(x: p.x, y: p.y, z: p.z)
+            p[axis] += 1
+        }
+    }
+}
+
+// 여러 슬라이스를 쌓아 만든 3D 볼륨
+// 복셀 값은 모달리티 변환(Rescale Slope/Intercept)이 적용된 값(CT의 경우 HU)을 Int16으로 저장
+final class DicomVolume: VolumeSampling {
+    let width: Int   // x 방향 복셀 수 (Columns)
+    let height: Int  // y 방향 복셀 수 (Rows)
+    let depth: Int   // z 방향 복셀 수 (슬라이스 수)
+
+    let spacing: SIMD3<Float> // 복셀 간격(mm): 열 방향, 행 방향, 슬라이스 방향
+    let origin: SIMD3<Float>  // 첫 번째 복셀의 환자 좌표(mm)
+    let rowDirection: SIMD3<Float>    // x 인덱스가 증가하는 환자 좌표 방향
+    let columnDirection: SIMD3<Float> // y 인덱스가 증가하는 환자 좌표 방향
+
+    // 복셀 버퍼: 여러 스레드가 서로 다른 슬라이스를 동시에 채울 수 있도록 직접 할당
+    let voxels: UnsafeMutableBufferPointer<Int16>
+
+    init(width: Int, height: Int, depth: Int,
+         spacing: SIMD3<Float> = SIMD3(1, 1, 1),
+         origin: SIMD3<Float> = .zero,
+         rowDirection: SIMD3<Float> = SIMD3(1, 0, 0),
+         columnDirection: SIMD3<Float> = SIMD3(0, 1, 0)) {
+        self.width = width
+        self.height = height
+        self.depth = depth
+        self.spacing = spacing
+        self.origin = origin
+        self.rowDirection = rowDirection
+        self.columnDirection = columnDirection
+        voxels = .allocate(capacity: width * height * depth)
+        voxels.initialize(repeating: 0)
+        MemoryGovernor.shared.recordAllocation(byteCount, in: .volumes)
+    }
+
+    deinit {
+        MemoryGovernor.shared.recordRelease(byteCount, in: .volumes)
+        voxels.deallocate()
+    }
+
+    // 슬라이스 법선 방향 (z 인덱스가 증가하는 방향)
+    var sliceDirection: SIMD3<Float> {
+        simd_normalize(simd_cross(rowDirection, columnDirection))
+    }
+
+    // 한 슬라이스의 복셀 수
+    var sliceSize: Int { width * height }
+
+    // 볼륨이 차지하는 메모리(바이트)
+    var byteCount: Int { voxels.count * MemoryLayout<Int16>.stride }
+
+    @inline(__always)
+    func index(_ x: Int, _ y: Int, _ z: Int) -> Int {
+        (z * height + y) * width + x
+    }
+
+    @inline(__always)
+    subscript(x: Int, y: Int, z: Int) -> Int16 {
+        get { voxels[index(x, y, z)] }
+        set { voxels[index(x, y, z)] = newValue }
+    }
+
+    @inline(__always)
+    func value(x: Int, y: Int, z: Int) -> Int16 {
+        voxels[index(x, y, z)]
+    }
+
+    // z번째 슬라이스의 시작 주소
+    func slice(_ z: Int) -> UnsafeMutablePointer<Int16> {
+        voxels.baseAddress! + z * sliceSize
+    }
+}
+
+enum DicomVolumeError: Error {
+    case emptySeries             // 슬라이스가 하나도 없음
+    case inconsistentSliceSize   // 슬라이스마다 Rows/Columns가 다름
+    case unsupportedImage        // 다채널 등 볼륨으로 만들 수 없는 이미지
+}
+
+// 파일 목록에서 볼륨을 조립하는 로더
+enum DicomVolumeLoader {
+    // 정렬에 필요한 슬라이스별 헤더 정보
+    struct SliceHeader {
+        let url: URL
+        let position: SIMD3<Double>
+        let rowDirection: SIMD3<Double>
+        let columnDirection: SIMD3<Double>
+        let pixelSpacing: SIMD2<Double> // 행 간격, 열 간격
+        let rows: Int
+        let columns: Int
+    }
+
+    // 슬라이스 파일들을 읽어 위치순으로 정렬한 뒤 하나의 볼륨으로 조립
+    static func load(urls: [URL]) throws -> DicomVolume {
+        try load(headers: sortedHeaders(urls: urls))
+    }
+
+    static func load(headers: [SliceHeader]) throws -> DicomVolume {
+        guard let first = headers.first else {
+            throw DicomVolumeError.emptySeries
+        }
+        guard headers.allSatisfy({ $0.rows == first.rows && $0.columns == first.columns }) else {
+            throw DicomVolumeError.inconsistentSliceSize
+        }
+
+        let volume = makeVolume(headers: headers)
+        try decodeSlices(headers[...], sliceSize: volume.sliceSize) { volume.slice($0) }
+        return volume
+    }
+
+    // 슬라이스 디코딩은 서로 독립적이므로 병렬로 수행
+    // 다른 디코딩 작업과 같은 메모리 예산을 나눠 쓰며, 허가된 슬라이스부터 스케줄러가 작업 큐에서 실행
+    // destination은 슬라이스 번호(headers의 인덱스)를 받아 픽셀을 기록할 주소를 돌려줌
+    static func decodeSlices(_ headers: ArraySlice<SliceHeader>, sliceSize: Int,
+                             destination: @escaping (Int) -> UnsafeMutablePointer<Int16>) throws {
+        let group = DispatchGroup()
+        var firstError: Error?
+        scheduleSlices(headers, sliceSize: sliceSize, group: group, destination: destination) { _, error in
+            if firstError == nil {
+                firstError = error
+            }
+        }
+        group.wait()
+        if let firstError {
+            throw firstError
+        }
+    }
+
+    // 슬라이스마다 스케줄러의 허가를 받아 디코딩하고 기다리지 않고 돌아옴
+    // 각 슬라이스가 끝날 때 group을 떠나기 전에 completed(슬라이스 번호, 오류)를 부름 (한 번에 하나씩 불림)
+    static func scheduleSlices(_ headers: ArraySlice<SliceHeader>, sliceSize: Int, group: DispatchGroup,
+                               destination: @escaping (Int) -> UnsafeMutablePointer<Int16>,
+                               completed: @escaping (Int, Error?) -> Void) {
+        let lock = NSLock()
+        for index in headers.indices {
+            let header = headers[index]
+            group.enter()
+            DecodeScheduler.shared.schedule(DecodeEstimate(rows: header.rows, columns: header.columns)) { _ in
+                defer { group.leave() }
+                var failure: Error?
+                do {
+                    try decodeSlice(header, into: destination(index), count: sliceSize)
+                } catch {
+                    failure = error
+                }
+                lock.lock()
+                completed(index, failure)
+                lock.unlock()
+            }
+        }
+    }
+
+    // 슬라이스 하나를 모달리티 변환해 destination에 Int16으로 씀
+    static func decodeSlice(_ header: SliceHeader, into destination: UnsafeMutablePointer<Int16>, count: Int) throws {
+        try autoreleasepool {
+            let dataset = try DicomheroCodecFactory.load(fromFileMaxSize: header.url.path, maxBufferSize: 2048)
+            let image = try dataset.getImageApplyModalityTransform(0)
+            try image.copyPixels(to: destination, count: count)
+        }
+    }
+
+    // 헤더만 읽어 슬라이스 법선 방향의 위치순으로 정렬
+    static func sortedHeaders(urls: [URL]) throws -> [SliceHeader] {
+        var headers = [SliceHeader?](repeating: nil, count: urls.count)
+        headers.withUnsafeMutableBufferPointer { buffer in
+            let slots = buffer
+            DispatchQueue.concurrentPerform(iterations: urls.count) { i in
+                autoreleasepool {
+                    slots[i] = try? readHeader(url: urls[i])
+                }
+            }
+        }
+        let valid = headers.compactMap { $0 }
+        guard let first = valid.first else {
+            throw DicomVolumeError.emptySeries
+        }
+        let normal = simd_cross(first.rowDirection, first.columnDirection)
+        return valid.sorted { simd_dot($0.position, normal) < simd_dot($1.position, normal) }
+    }
+
+    static func readHeader(url: URL) throws -> SliceHeader {
+        // 픽셀 데이터는 필요할 때 읽도록 작은 버퍼만 메모리에 올림
+        let dataset = try DicomheroCodecFactory.load(fromFileMaxSize: url.path, maxBufferSize: 2048)
+        func double(_ tag: DicomheroTagEnum, _ element: UInt32, _ defaultValue: Double) throws -> Double {
+            try dataset.getDouble(DicomheroTagId(id: tag), elementNumber: element, defaultValue: defaultValue)
+        }
+        let position = SIMD3(try double(.enumImagePositionPatient_0020_0032, 0, 0),
+                             try double(.enumImagePositionPatient_0020_0032, 1, 0),
+                             try double(.enumImagePositionPatient_0020_0032, 2, 0))
+        let rowDirection = SIMD3(try double(.enumImageOrientationPatient_0020_0037, 0, 1),
+                                 try double(.enumImageOrientationPatient_0020_0037, 1, 0),
+                                 try double(.enumImageOrientationPatient_0020_0037, 2, 0))
+        let columnDirection = SIMD3(try double(.enumImageOrientationPatient_0020_0037, 3, 0),
+                                    try double(.enumImageOrientationPatient_0020_0037, 4, 1),
+                                    try double(.enumImageOrientationPatient_0020_0037, 5, 0))
+        let pixelSpacing = SIMD2(try double(.enumPixelSpacing_0028_0030, 0, 1),
+                                 try double(.enumPixelSpacing_0028_0030, 1, 1))
+        let rows = try dataset.getUint32(DicomheroTagId(id: .enumRows_0028_0010), elementNumber: 0)
+        let columns = try dataset.getUint32(DicomheroTagId(id: .enumColumns_0028_0011), elementNumber: 0)
+        return SliceHeader(url: url, position: position,
+                           rowDirection: rowDirection, columnDirection: columnDirection,
+                           pixelSpacing: pixelSpacing, rows: Int(rows), columns: Int(columns))
+    }
+
+    // 볼륨의 공간 정보 (복셀 간격, 원점, 방향)
+    struct Geometry {
+        let spacing: SIMD3<Float>
+        let origin: SIMD3<Float>
+        let rowDirection: SIMD3<Float>
+        let columnDirection: SIMD3<Float>
+    }
+
+    // 정렬된 헤더로부터 공간 정보를 계산 (슬라이스 간격은 양 끝 슬라이스 위치 차이의 평균)
+    static func geometry(headers: [SliceHeader]) -> Geometry {
+        let first = headers[0]
+        let normal = simd_normalize(simd_cross(first.rowDirection, first.columnDirection))
+        var sliceSpacing = 1.0
+        if headers.count > 1 {
+            let distance = simd_dot(headers[headers.count - 1].position - first.position, normal)
+            sliceSpacing = abs(distance) / Double(headers.count - 1)
+        }
+        // PixelSpacing은 (행 간격, 열 간격) 순서이므로 x 간격은 두 번째 값
+        let spacing = SIMD3(Float(first.pixelSpacing.y), Float(first.pixelSpacing.x), Float(max(sliceSpacing, 1e-3)))
+        return Geometry(spacing: spacing,
+                        origin: SIMD3<Float>(first.position),
+                        rowDirection: SIMD3<Float>(first.rowDirection),
+                        columnDirection: SIMD3<Float>(first.columnDirection))
+    }
+
+    // 정렬된 헤더로부터 빈 볼륨을 생성
+    static func makeVolume(headers: [SliceHeader]) -> DicomVolume {
+        let first = headers[0]
+        let layout = geometry(headers: headers)
+        return DicomVolume(width: first.columns, height: first.rows, depth: headers.count,
+                           spacing: layout.spacing,
+                           origin: layout.origin,
+                           rowDirection: layout.rowDirection,
+                           columnDirection: layout.columnDirection)
+    }
+}
+
+extension DicomheroImage {
+    // 단일 채널 이미지의 픽셀을 Int16으로 변환하여 destination에 복사
+    // 모달리티 변환 결과는 원본에 따라 8/16/32비트 정수 또는 실수일 수 있음
+    // rescale을 지정하면 값 * slope + intercept를 적용 (멀티프레임에서 프레임별 값을 직접 적용할 때 사용)
+    func copyPixels(to destination: UnsafeMutablePointer<Int16>, count: Int,
+                    rescale: (slope: Double, intercept: Double)? = nil) throws {
+        guard channelsNumber == 1 else {
+            throw DicomVolumeError.unsupportedImage
+        }
+        let handler = try getReadingDataHandler()
+        guard let data = try handler.getMemory().data() else {
+            return
+        }
+        let unitSize = Int(handler.unitSize)
+        let isSigned = handler.isSigned
+        let isFloat = handler.isFloat
+        let pixelCount = min(count, data.count / max(unitSize, 1))
+
+        @inline(__always)
+        func clamped(_ value: Double) -> Int16 {
+            value.isFinite ? Int16(clamping: Int(value.rounded())) : 0
+        }
+
+        // 디코딩된 화소 복사본이 살아 있는 동안 사용량으로 기록
+        MemoryGovernor.shared.recordAllocation(data.count, in: .decodedImages)
+        defer { MemoryGovernor.shared.recordRelease(data.count, in: .decodedImages) }
+
+        data.withUnsafeBytes { raw in
+            func convertInteger<Source: BinaryInteger>(_ type: Source.Type) {
+                let source = raw.bindMemory(to: Source.self)
+                if let rescale {
+                    for i in 0..<pixelCount {
+                        destination[i] = clamped(Double(source[i]) * rescale.slope + rescale.intercept)
+                    }
+                } else {
+                    for i in 0..<pixelCount {
+                        destination[i] = Int16(clamping: source[i])
+                    }
+                }
+            }
+            func convertFloat<Source: BinaryFloatingPoint>(_ type: Source.Type) {
+                let source = raw.bindMemory(to: Source.self)
+                let slope = rescale?.slope ?? 1
+                let intercept = rescale?.intercept ?? 0
+                for i in 0..<pixelCount {
+                    destination[i] = clamped(Double(source[i]) * slope + intercept)
+                }
+            }
+
+            switch (unitSize, isSigned, isFloat) {
+            case (1, false, _): convertInteger(UInt8.self)
+            case (1, true, _): convertInteger(Int8.self)
+            case (2, false, _): convertInteger(UInt16.self)
+            case (2, true, _):
+                if rescale == nil {
+                    destination.update(from: raw.bindMemory(to: Int16.self).baseAddress!, count: pixelCount)
+                } else {
+                    convertInteger(Int16.self)
+                }
+            case (4, _, true): convertFloat(Float.self)
+            case (4, false, _): convertInteger(UInt32.self)
+            case (4, true, _): convertInteger(Int32.self)
+            case (8, _, true): convertFloat(Double.self)
+            default: break
+            }
+        }
+    }
+}
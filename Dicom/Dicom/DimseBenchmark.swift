@@ -0,0 +1,290 @@
+//
+//  DimseBenchmark.swift
+//  Dicom
+//
+//  Created by hanjongwoo on 10/19/26.
+//
+
+import Foundation
+
+enum DimseTransport: String {
+    case pipe = "pipe"  // DicomheroPipeStream 한 쌍 (소켓을 거치지 않음)
+    case tcp = "tcp"    // 루프백 DicomheroTCPStream
+}
+
+enum DimseWorkload: String {
+    case echo = "C-ECHO"
+    case store = "C-STORE"
+    case find = "C-FIND"
+    case move = "C-MOVE"
+}
+
+struct DimseBenchmarkResult {
+    var workload = DimseWorkload.echo
+    var transport = DimseTransport.tcp
+    var concurrency = 0
+    var operations = 0
+    var failures = 0
+    var bytes = 0
+    var seconds = 0.0
+    var cpuSeconds = 0.0 // 프로세스 전체(SCP + SCU + 하위 연산) 사용자 + 시스템 시간
+    var p50Milliseconds = 0.0
+    var p99Milliseconds = 0.0
+
+    var operationsPerSecond: Double { seconds > 0 ? Double(operations) / seconds : 0 }
+    var megabytesPerSecond: Double { seconds > 0 ? Double(bytes) / seconds / 1_048_576 : 0 }
+    var cpuNanosecondsPerByte: Double { bytes > 0 ? cpuSeconds * 1e9 / Double(bytes) : 0 }
+}
+
+// 한 프로세스 안에서 StorageSCP와 SCU 여러 개를 띄워 DIMSE 작업별 처리량과 응답 시간을 재는 하네스
+// 네트워크 쪽을 바꿀 때 전후를 같은 조건으로 비교하기 위한 것
+enum DimseBenchmark {
+    struct Configuration {
+        var transport = DimseTransport.tcp
+        var workloads: [DimseWorkload] = [.echo, .store, .find, .move]
+        var concurrency = 4
+        var operationsPerClient = 200
+        var port = 11120             // SCP, port + 1은 C-MOVE 목적지
+        var syntheticStudies = 10_000 // C-FIND 카탈로그에 더 넣을 합성 검사 수 (파일 없음)
+        var pipeBufferSize: UInt32 = 1 << 20
+    }
+
+    // C-STORE는 urls를 돌려 가며 보내고, C-MOVE는 urls의 검사를 하나씩 골라 목적지로 보냄
+    static func run(urls: [URL], configuration: Configuration = Configuration()) -> [DimseBenchmarkResult] {
+        let directory = FileManager.default.temporaryDirectory.appendingPathComponent("DimseBenchmark")
+        defer { try? FileManager.default.removeItem(at: directory) }
+        let catalogue = StudyCatalogue()
+        let studies = RetrieveBenchmark.stage(urls: urls, in: directory, catalogue: catalogue).map { (uid: $0.key, bytes: $0.value) }
+        let patientIDs = fillCatalogue(catalogue, studies: configuration.syntheticStudies)
+        let instances = StorageLoadGenerator.load(urls: urls)
+        let instanceBytes = instances.map { (try? $0.url.resourceValues(forKeys: [.fileSizeKey]).fileSize) ?? 0 }
+
+        let destination = AssociationMultiplexer(configuration: AssociationMultiplexer.Configuration(
+            aeTitle: "BENCHDEST", port: configuration.port + 1, maxPDULength: 1 << 20, maxPerformedOperations: 64))
+        var scpConfiguration = StorageSCP.Configuration(port: configuration.port, directory: directory,
+                                                        maxAssociations: configuration.concurrency * 2)
+        scpConfiguration.moveDestinations = [destination.configuration.aeTitle: StorageSCP.MoveDestination(
+            node: "127.0.0.1", port: configuration.port + 1, window: Int(destination.configuration.maxPerformedOperations))]
+        let scp = StorageSCP(configuration: scpConfiguration, catalogue: catalogue)
+        do {
+            try destination.start()
+            if configuration.transport == .tcp {
+                try scp.start()
+            }
+        } catch {
+            print("caught: \(error)")
+            return []
+        }
+        defer {
+            scp.stop()
+            destination.stop()
+        }
+
+        return configuration.workloads.compactMap { workload -> DimseBenchmarkResult? in
+            if (workload == .store && instances.isEmpty) || (workload == .move && studies.isEmpty) {
+                return nil
+            }
+            var result = DimseBenchmarkResult(workload: workload, transport: configuration.transport,
+                                              concurrency: configuration.concurrency)
+            var latencies: [Double] = []
+            let lock = NSLock()
+            let group = DispatchGroup()
+            // 명령과 데이터셋의 SOP Instance UID를 함께 바꾸므로 클라이언트마다 데이터셋 사본을 따로 읽어 둠 (측정 시간 밖에서)
+            let copies = workload == .store
+                ? (0..<configuration.concurrency).map { _ in StorageLoadGenerator.load(urls: instances.map(\.url)) }
+                : []
+            let cpuStart = cpuTime()
+            let start = DispatchTime.now().uptimeNanoseconds
+            for client in 0..<configuration.concurrency {
+                group.enter()
+                let thread = Thread {
+                    var partial = DimseBenchmarkResult()
+                    var clientLatencies: [Double] = []
+                    do {
+                        let connection = try connect(to: scp, configuration: configuration)
+                        defer { connection.close() }
+                        let service = DicomheroDimseService(association: connection.association)
+                        for operation in 0..<configuration.operationsPerClient {
+                            let index = client * configuration.operationsPerClient + operation
+                            let begin = DispatchTime.now().uptimeNanoseconds
+                            let outcome: (succeeded: Bool, bytes: Int) = try autoreleasepool {
+                                switch workload {
+                                case .echo:
+                                    return (try echo(service), 0)
+                                case .store:
+                                    // 클라이언트마다 같은 파일을 보내므로 UID에 클라이언트/순번을 붙여 SCP와 목록에 중복으로 들어가지 않게 함
+                                    let own = copies[client]
+                                    let i = index % own.count
+                                    return (try store(own[i], sopInstanceUID: "\(own[i].sopInstanceUID).\(client).\(operation)",
+                                                      service: service), instanceBytes[i])
+                                case .find:
+                                    return (try find(patientID: patientIDs[index % patientIDs.count], service: service), 0)
+                                case .move:
+                                    let study = studies[index % studies.count]
+                                    return (try move(studyUID: study.uid, to: destination.configuration.aeTitle,
+                                                     service: service), study.bytes)
+                                }
+                            }
+                            clientLatencies.append(Double(DispatchTime.now().uptimeNanoseconds - begin) / 1e6)
+                            partial.operations += 1
+                            partial.failures += outcome.succeeded ? 0 : 1
+                            partial.bytes += outcome.succeeded ? outcome.bytes : 0
+                        }
+                        try connection.association.release()
+                    } catch {
+                        print("caught: \(error)")
+                    }
+                    lock.lock()
+                    result.operations += partial.operations
+                    result.failures += partial.failures
+                    result.bytes += partial.bytes
+                    latencies += clientLatencies
+                    lock.unlock()
+                    group.leave()
+                }
+                thread.name = "DimseBenchmark.client.\(client)"
+                thread.start()
+            }
+            group.wait()
+            result.seconds = Double(DispatchTime.now().uptimeNanoseconds - start) / 1e9
+            result.cpuSeconds = cpuTime() - cpuStart
+            latencies.sort()
+            if !latencies.isEmpty {
+                result.p50Milliseconds = latencies[latencies.count / 2]
+                result.p99Milliseconds = latencies[min(latencies.count - 1, latencies.count * 99 / 100)]
+            }
+            return result
+        }
+    }
+
+    private struct Connection {
+        let association: DicomheroAssociationSCU
+        let close: () -> Void
+    }
+
+    // tcp: SCP 리스너로 연결. pipe: 파이프 두 개(요청 방향, 응답 방향)를 만들고 SCP 쪽 처리를 스레드 하나에 붙임
+    private static func connect(to scp: StorageSCP, configuration: Configuration) throws -> Connection {
+        func associate(reader: DicomheroStreamReader, writer: DicomheroStreamWriter) throws -> DicomheroAssociationSCU {
+            try DicomheroAssociationSCU(
+                thisAET: "BENCHSCU", otherAET: scp.configuration.aeTitle,
+                maxInvokedOperations: 1, maxPerformedOperations: 1,
+                presentationContexts: StorageSCP.presentationContexts(),
+                reader: reader, writer: writer,
+                dimseTimeoutSeconds: scp.configuration.dimseTimeoutSeconds)
+        }
+        switch configuration.transport {
+        case .tcp:
+            let stream = try DicomheroTCPStream(address: DicomheroTCPActiveAddress(
+                node: "127.0.0.1", service: String(configuration.port)))
+            let association = try associate(reader: DicomheroStreamReader(inputStream: stream.getStreamInput()),
+                                            writer: DicomheroStreamWriter(outputStream: stream.getStreamOutput()))
+            return Connection(association: association, close: { withExtendedLifetime(stream) {} })
+        case .pipe:
+            let requests = DicomheroPipeStream(bufferSize: configuration.pipeBufferSize)
+            let responses = DicomheroPipeStream(bufferSize: configuration.pipeBufferSize)
+            let thread = Thread {
+                scp.serve(input: requests.getStreamInput(), output: responses.getStreamOutput())
+            }
+            thread.name = "DimseBenchmark.scp"
+            thread.start()
+            let association = try associate(reader: DicomheroStreamReader(inputStream: responses.getStreamInput()),
+                                            writer: DicomheroStreamWriter(outputStream: requests.getStreamOutput()))
+            return Connection(association: association, close: {
+                try? requests.close(1000)
+                try? responses.close(1000)
+            })
+        }
+    }
+
+    private static func echo(_ service: DicomheroDimseService) throws -> Bool {
+        let verification = WellKnownUID.string(for: WellKnownUID.verification)
+        let command = DicomheroCEchoCommand(abstractSyntax: verification, messageID: service.getNextCommandID(),
+                                            priority: .medium, affectedSopClassUid: verification)
+        try service.sendCommandOrResponse(command)
+        return try service.getCEchoResponse(command).status == .success
+    }
+
+    private static func store(_ instance: StorageLoadGenerator.Instance, sopInstanceUID: String,
+                              service: DicomheroDimseService) throws -> Bool {
+        // 응답을 받은 뒤 다음 전송을 하므로 클라이언트의 사본을 다시 고쳐 써도 됨
+        try instance.dataSet.setString(DicomheroTagId(id: .enumSOPInstanceUID_0008_0018), newValue: sopInstanceUID)
+        let command = DicomheroCStoreCommand(
+            abstractSyntax: instance.sopClassUID, messageID: service.getNextCommandID(), priority: .medium,
+            affectedSopClassUid: instance.sopClassUID, affectedSopInstanceUid: sopInstanceUID,
+            originatorAET: "", originatorMessageID: 0, payload: instance.dataSet)
+        try service.sendCommandOrResponse(command)
+        return try service.getCStoreResponse(command).status == .success
+    }
+
+    private static func identifier(_ level: QueryLevel, _ keys: [(DicomheroTagEnum, String)]) throws -> DicomheroDataSet {
+        let dataSet = DicomheroDataSet(transferSyntax: TransferSyntaxKind.explicitLittleEndian)
+        try dataSet.setString(DicomheroTagId(id: .enumQueryRetrieveLevel_0008_0052), newValue: level.rawValue)
+        for (tag, value) in keys {
+            try dataSet.setString(DicomheroTagId(id: tag), newValue: value)
+        }
+        return dataSet
+    }
+
+    // 환자 하나의 검사 목록 (일반적인 워크리스트 화면의 질의)
+    private static func find(patientID: String, service: DicomheroDimseService) throws -> Bool {
+        let abstractSyntax = DicomheroUidStudyRootQueryRetrieveInformationModelFIND_1_2_840_10008_5_1_4_1_2_2_1
+        let command = DicomheroCFindCommand(
+            abstractSyntax: abstractSyntax, messageID: service.getNextCommandID(), priority: .medium,
+            affectedSopClassUid: abstractSyntax,
+            identifier: try identifier(.study, [
+                (.enumPatientID_0010_0020, patientID), (.enumPatientName_0010_0010, ""),
+                (.enumStudyInstanceUID_0020_000D, ""), (.enumStudyDate_0008_0020, ""),
+                (.enumModalitiesInStudy_0008_0061, ""), (.enumNumberOfStudyRelatedInstances_0020_1208, "")
+            ]))
+        try service.sendCommandOrResponse(command)
+        while true {
+            let response = try service.getCFindResponse(command)
+            if response.status != .pending {
+                return response.status == .success
+            }
+        }
+    }
+
+    private static func move(studyUID: String, to destinationAET: String, service: DicomheroDimseService) throws -> Bool {
+        let abstractSyntax = DicomheroUidStudyRootQueryRetrieveInformationModelMOVE_1_2_840_10008_5_1_4_1_2_2_2
+        let command = DicomheroCMoveCommand(
+            abstractSyntax: abstractSyntax, messageID: service.getNextCommandID(), priority: .medium,
+            affectedSopClassUid: abstractSyntax, destinationAET: destinationAET,
+            identifier: try identifier(.study, [(.enumStudyInstanceUID_0020_000D, studyUID)]))
+        try service.sendCommandOrResponse(command)
+        while true {
+            let response = try service.getCMoveResponse(command)
+            if response.status != .pending {
+                return response.status == .success
+            }
+        }
+    }
+
+    // 파일 없이 색인만 있는 검사를 더해 C-FIND가 실제 규모의 카탈로그를 뒤지게 함 (환자 ID 목록을 돌려줌)
+    private static func fillCatalogue(_ catalogue: StudyCatalogue, studies: Int) -> [String] {
+        var patientIDs: [String] = []
+        for study in 0..<studies {
+            var entry = StudyCatalogue.Entry()
+            entry.patientID = String(format: "BENCH%06d", study / 2)
+            entry.patientName = "BENCH^\(study / 2)"
+            entry.studyUID = "2.25.1.\(study)"
+            entry.studyDate = String(20200101 + study % 28)
+            entry.seriesUID = "2.25.2.\(study)"
+            entry.modality = study % 2 == 0 ? "CT" : "MR"
+            entry.instanceUID = "2.25.3.\(study)"
+            entry.sopClassUID = WellKnownUID.string(for: WellKnownUID.ctImageStorage)
+            catalogue.insert(entry)
+            if study % 2 == 0 {
+                patientIDs.append(entry.patientID)
+            }
+        }
+        return patientIDs.isEmpty ? ["NONE"] : patientIDs
+    }
+
+    private static func cpuTime() -> Double {
+        var usage = rusage()
+        getrusage(RUSAGE_SELF, &usage)
+        func seconds(_ time: timeval) -> Double { Double(time.tv_sec) + Double(time.tv_usec) / 1e6 }
+        return seconds(usage.ru_utime) + seconds(usage.ru_stime)
+    }
+}
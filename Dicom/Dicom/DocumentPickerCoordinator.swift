@@ -30,12 +30,32 @@ class DocumentPickerCoordinator: NSObject, UIDocumentPickerDelegate, UINavigatio
         }
         
         path = urls[0]
+        importToLibrary(urls: urls)
+        // 여러 파일이 선택되면 시리즈로 보고 볼륨을 점진적으로 조립
+        if urls.count > 1 {
+            loadSeries(urls: urls)
+            return
+        }
         // 백그라운드 스레드에서 파일을 로드
         DispatchQueue.global(qos: .background).async {
             self.loadImage(url: urls[0])
         }
     }
 
+    // 선택한 파일을 앱 컨테이너로 복사해 로컬 색인에 더하고 검사 목록을 색인에서 다시 만듦 (헤더만 읽음)
+    // 복사가 끝난 뒤에는 보안 범위 접근을 놓아도 색인의 경로로 다시 열 수 있음
+    private func importToLibrary(urls: [URL]) {
+        let accessed = urls.filter { $0.startAccessingSecurityScopedResource() }
+        DispatchQueue.global(qos: .utility).async {
+            MetadataLibrary.shared.importFiles(accessed)
+            accessed.forEach { $0.stopAccessingSecurityScopedResource() }
+            let studies = MetadataLibrary.shared.studies()
+            DispatchQueue.main.async {
+                self.data.studies = studies
+            }
+        }
+    }
+
     // 취소된 경우 호출되는 메소드
     func documentPickerWasCancelled(_ controller: UIDocumentPickerViewController) {
         DispatchQueue.main.async {
@@ -54,7 +74,7 @@ class DocumentPickerCoordinator: NSObject, UIDocumentPickerDelegate, UINavigatio
             return
         }
         
-        defer {
+        let finish = {
             DispatchQueue.main.async {
                 self.loading = false
             }
@@ -62,12 +82,42 @@ class DocumentPickerCoordinator: NSObject, UIDocumentPickerDelegate, UINavigatio
         }
         
         do {
-            // DICOMHero의 기본 메모리 할당 제한을 설정하여 메모리 과다 할당 방지
-            DicomheroCodecFactory.setMaximumImageSize(8000, maxHeight: 8000)
             // 선택된 파일에서 DICOM 데이터셋 로드
             let dataset: DicomheroDataSet = try DicomheroCodecFactory.load(fromFileMaxSize: url.path, maxBufferSize: 2048)
-            // 변환을 적용한 이미지를 가져옴
-            let heroImage: DicomheroImage = try dataset.getImageApplyModalityTransform(0)
+            // 고정된 최대 크기 대신 헤더로 예측한 디코딩 크기를 공유 예산에 맞춰 허가받음
+            // 다른 이미지가 예산을 쓰고 있으면 대기열에서 기다리고, 혼자서도 넘으면 축소 디코딩으로 표시
+            // 허가를 기다리는 동안 스레드를 잡지 않도록 나머지 작업은 허가된 뒤 스케줄러가 실행
+            let estimate = try DecodeEstimate(dataSet: dataset)
+            // 프레임들이 공간을 채우는 멀티프레임 객체(Enhanced CT/MR 등)는 볼륨으로 조립해 관상면을 표시
+            // 프레임은 하나씩 디코딩하므로 프레임 하나의 예측으로 허가받고, 조립할 볼륨은 예산 안일 때만 만듦
+            if estimate.frames > 1, let table = try? FrameGeometryTable(dataSet: dataset), table.spansVolume,
+               estimate.rows * estimate.columns * estimate.frames * MemoryLayout<Int16>.stride <= DecodeScheduler.defaultBudget {
+                DecodeScheduler.shared.schedule(estimate) { _ in
+                    defer { finish() }
+                    self.showVolume(url: url, dataset: dataset, table: table)
+                }
+                return
+            }
+            DecodeScheduler.shared.schedule(estimate, reducible: ReducedDecoder.canDecodeReduced(dataSet: dataset)) { ticket in
+                defer { finish() }
+                self.showImage(url: url, dataset: dataset, downsampleFactor: ticket.downsampleFactor)
+            }
+        } catch {
+            print("caught: \(error)")
+            finish()
+        }
+    }
+
+    // 허가받은 배율로 이미지를 디코딩해 화면에 표시
+    private func showImage(url: URL, dataset: DicomheroDataSet, downsampleFactor: Int) {
+        do {
+            // 변환을 적용한 이미지를 가져옴 (축소 배율이 있으면 원본 해상도로 디코딩하지 않음)
+            let heroImage: DicomheroImage
+            if let scale = DecodeScale(rawValue: downsampleFactor) {
+                heroImage = try ReducedDecoder.reducedImage(url: url, dataSet: dataset, frame: 0, scale: scale)
+            } else {
+                heroImage = try dataset.getImageApplyModalityTransform(0)
+            }
 
             // 이미지 크기 가져오기
             let width = heroImage.width
@@ -83,8 +133,12 @@ class DocumentPickerCoordinator: NSObject, UIDocumentPickerDelegate, UINavigatio
             /// WW(Window Width): 이미지의 밝기 범위
             /// WL(Window Level): 이미지의 중앙 밝기
             if DicomheroColorTransformsFactory.isMonochrome(heroImage.colorSpace) {
+                // 향상된(enhanced) 객체는 VOI가 기능 그룹 안에 있으므로 프레임 정보 테이블에 있으면 그것을 씀 (단일 프레임 포함)
+                let frameTable = try? FrameGeometryTable(dataSet: dataset)
                 let vois = try dataset.getVOIs() as! Array<DicomheroVOIDescription>
-                if !vois.isEmpty {
+                if let frameVOI = frameTable?.voiDescription(frame: 0) {
+                    chain!.add(DicomheroVOILUT(voiDescription: frameVOI))
+                } else if !vois.isEmpty {
                     chain!.add(DicomheroVOILUT(voiDescription: vois.first))
                 } else {
                     let voiDescription = try DicomheroVOILUT.getOptimalVOI(heroImage, inputTopLeftX: 0, inputTopLeftY: 0, inputWidth: width, inputHeight: height)
@@ -114,4 +168,74 @@ class DocumentPickerCoordinator: NSObject, UIDocumentPickerDelegate, UINavigatio
             print("caught: \(error)")
         }
     }
+
+    // 멀티프레임 객체를 프레임 정보 테이블 순서로 볼륨에 조립하고 가운데 관상면(coronal)을 표시
+    private func showVolume(url: URL, dataset: DicomheroDataSet, table: FrameGeometryTable) {
+        do {
+            let volume = try DicomVolumeLoader.load(multiFrame: dataset, table: table, url: url)
+            let plane = VolumePlane.coronal
+            let image = try VolumeReslicer.render(VolumeReslicer.slice(volume, plane: plane, index: volume.height / 2))
+            DispatchQueue.main.async {
+                self.data.image = image
+            }
+        } catch {
+            print("caught: \(error)")
+        }
+    }
+
+    // 시리즈를 볼륨으로 조립하면서 적재된 범위의 관상면(coronal) MPR을 계속 갱신
+    // 전체 슬라이스가 끝나기 전에도 앞쪽부터 채워진 영역이 화면에 표시됨
+    // 일반 볼륨이 메모리 예산을 넘으면 압축 브릭 볼륨으로 조립한 뒤 한 번 그림
+    private func loadSeries(urls: [URL]) {
+        DispatchQueue.main.async {
+            self.loading = true
+        }
+        let accessed = urls.filter { $0.startAccessingSecurityScopedResource() }
+
+        DispatchQueue.global(qos: .userInitiated).async {
+            func finish() {
+                accessed.forEach { $0.stopAccessingSecurityScopedResource() }
+                DispatchQueue.main.async {
+                    self.loading = false
+                }
+            }
+
+            do {
+                let headers = try DicomVolumeLoader.sortedHeaders(urls: accessed)
+                let budget = DecodeScheduler.defaultBudget
+                guard DicomVolumeLoader.fitsInMemory(headers, memoryBudget: budget) else {
+                    let volume = try DicomVolumeLoader.load(headers: headers, memoryBudget: budget)
+                    let plane = VolumePlane.coronal
+                    let image = try VolumeReslicer.render(VolumeReslicer.slice(volume, plane: plane, index: volume.height / 2))
+                    DispatchQueue.main.async {
+                        self.data.image = image
+                    }
+                    finish()
+                    return
+                }
+                let assembler = try StreamingVolumeAssembler(headers: headers)
+                assembler.onProgress = { volume, coverage in
+                    do {
+                        let plane = VolumePlane.coronal
+                        let slice = try VolumeReslicer.slice(volume, plane: plane, index: volume.height / 2, coverage: coverage)
+                        let image = try VolumeReslicer.render(slice, rows: plane.coveredRows(of: volume, coverage: coverage))
+                        DispatchQueue.main.async {
+                            self.data.image = image
+                        }
+                    } catch {
+                        print("caught: \(error)")
+                    }
+                }
+                assembler.start { error in
+                    if let error {
+                        print("caught: \(error)")
+                    }
+                    finish()
+                }
+            } catch {
+                print("caught: \(error)")
+                finish()
+            }
+        }
+    }
 }
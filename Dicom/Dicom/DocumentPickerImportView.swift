@@ -25,6 +25,8 @@ struct DocumentPickerImportView: UIViewControllerRepresentable {
     // UIDocumentPickerViewController를 생성
     func makeUIViewController(context: UIViewControllerRepresentableContext<DocumentPickerImportView>) -> UIDocumentPickerViewController {
         let documentPicker = UIDocumentPickerViewController(forOpeningContentTypes: [UTType.item], asCopy: false)
+        // 여러 파일을 선택하면 시리즈로 보고 볼륨을 조립
+        documentPicker.allowsMultipleSelection = true
         documentPicker.delegate = context.coordinator
         return documentPicker
     }
@@ -0,0 +1,258 @@
+//
+//  FrameGeometryTable.swift
+//  Dicom
+//
+//  Created by hanjongwoo on 10/19/26.
+//
+
+import Foundation
+import simd
+
+// 멀티프레임(Enhanced CT/MR 등) 객체의 프레임별 공간/표시 정보 테이블
+// getFunctionalGroupDataSet(frame)은 호출할 때마다 공유/프레임별 기능 그룹을 다시 찾으므로
+// 한 번의 순회로 모든 프레임의 값을 속성별 배열(struct-of-arrays)에 모아 두고
+// 정렬, 볼륨 조립, 화면 표시에서 이 테이블만 읽도록 함
+struct FrameGeometryTable {
+    let frameCount: Int
+    private(set) var positions: [SIMD3<Double>] = []        // Image Position (Patient)
+    private(set) var rowDirections: [SIMD3<Double>] = []    // Image Orientation (Patient) 앞의 3개
+    private(set) var columnDirections: [SIMD3<Double>] = [] // Image Orientation (Patient) 뒤의 3개
+    private(set) var pixelSpacings: [SIMD2<Double>] = []    // 행 간격, 열 간격
+    private(set) var sliceThicknesses: [Double] = []
+    private(set) var rescaleSlopes: [Double] = []
+    private(set) var rescaleIntercepts: [Double] = []
+    private(set) var windowCenters: [Double] = []           // 값이 없으면 NaN
+    private(set) var windowWidths: [Double] = []            // 값이 없으면 NaN
+    private(set) var temporalIndices: [Int32] = []          // Temporal Position Index, 없으면 0
+    private(set) var stackPositions: [Int32] = []           // In-Stack Position Number, 없으면 0
+
+    // 기능 그룹 하나에서 읽은 값 (없는 매크로는 nil로 남겨 공유 그룹 값을 그대로 사용)
+    private struct FrameValues {
+        var position: SIMD3<Double>?
+        var rowDirection: SIMD3<Double>?
+        var columnDirection: SIMD3<Double>?
+        var pixelSpacing: SIMD2<Double>?
+        var sliceThickness: Double?
+        var rescaleSlope: Double?
+        var rescaleIntercept: Double?
+        var windowCenter: Double?
+        var windowWidth: Double?
+        var temporalIndex: Int32?
+        var stackPosition: Int32?
+    }
+
+    // 프레임마다 새로 만들지 않도록 태그 ID를 한 번만 생성
+    private enum Tags {
+        static let numberOfFrames: DicomheroTagId = DicomheroTagId(id: .enumNumberOfFrames_0028_0008)
+        static let sharedGroups: DicomheroTagId = DicomheroTagId(id: .enumSharedFunctionalGroupsSequence_5200_9229)
+        static let perFrameGroups: DicomheroTagId = DicomheroTagId(id: .enumPerFrameFunctionalGroupsSequence_5200_9230)
+        static let planePosition: DicomheroTagId = DicomheroTagId(id: .enumPlanePositionSequence_0020_9113)
+        static let planeOrientation: DicomheroTagId = DicomheroTagId(id: .enumPlaneOrientationSequence_0020_9116)
+        static let pixelMeasures: DicomheroTagId = DicomheroTagId(id: .enumPixelMeasuresSequence_0028_9110)
+        static let pixelValueTransformation: DicomheroTagId = DicomheroTagId(id: .enumPixelValueTransformationSequence_0028_9145)
+        static let frameVOILUT: DicomheroTagId = DicomheroTagId(id: .enumFrameVOILUTSequence_0028_9132)
+        static let frameContent: DicomheroTagId = DicomheroTagId(id: .enumFrameContentSequence_0020_9111)
+        static let imagePosition: DicomheroTagId = DicomheroTagId(id: .enumImagePositionPatient_0020_0032)
+        static let imageOrientation: DicomheroTagId = DicomheroTagId(id: .enumImageOrientationPatient_0020_0037)
+        static let pixelSpacing: DicomheroTagId = DicomheroTagId(id: .enumPixelSpacing_0028_0030)
+        static let sliceThickness: DicomheroTagId = DicomheroTagId(id: .enumSliceThickness_0018_0050)
+        static let rescaleSlope: DicomheroTagId = DicomheroTagId(id: .enumRescaleSlope_0028_1053)
+        static let rescaleIntercept: DicomheroTagId = DicomheroTagId(id: .enumRescaleIntercept_0028_1052)
+        static let windowCenter: DicomheroTagId = DicomheroTagId(id: .enumWindowCenter_0028_1050)
+        static let windowWidth: DicomheroTagId = DicomheroTagId(id: .enumWindowWidth_0028_1051)
+        static let temporalIndex: DicomheroTagId = DicomheroTagId(id: .enumTemporalPositionIndex_0020_9128)
+        static let stackPosition: DicomheroTagId = DicomheroTagId(id: .enumInStackPositionNumber_0020_9057)
+    }
+
+    init(dataSet: DicomheroDataSet) throws {
+        frameCount = Int(try dataSet.getUint32(Tags.numberOfFrames, elementNumber: 0, defaultValue: 1))
+
+        // 기능 그룹이 없는 일반 객체는 최상위 태그 값을 모든 프레임에 사용
+        var shared = FrameValues()
+        FrameGeometryTable.readTopLevel(dataSet, into: &shared)
+        if let sharedGroup = try? dataSet.getSequenceItem(Tags.sharedGroups, item: 0) {
+            FrameGeometryTable.readFunctionalGroup(sharedGroup, into: &shared)
+        }
+
+        reserve(frameCount)
+        let perFrame = try? dataSet.getTag(Tags.perFrameGroups)
+        for frame in 0..<frameCount {
+            var values = shared
+            if let perFrame, let group = try? perFrame.getSequenceItem(UInt32(frame)) {
+                FrameGeometryTable.readFunctionalGroup(group, into: &values)
+            }
+            append(values)
+        }
+    }
+
+    // 슬라이스 법선 방향 (첫 프레임 기준)
+    var sliceDirection: SIMD3<Double> {
+        guard frameCount > 0 else {
+            return SIMD3(0, 0, 1)
+        }
+        return simd_normalize(simd_cross(rowDirections[0], columnDirections[0]))
+    }
+
+    // 프레임들에 있는 시간 위치 값 (정렬됨). 둘 이상이면 4D 시리즈
+    var temporalIndexValues: [Int32] {
+        Array(Set(temporalIndices)).sorted()
+    }
+
+    // 법선 방향 위치가 서로 다른 프레임이 있는지 (시네처럼 같은 위치를 되풀이하는 객체는 볼륨이 아님)
+    var spansVolume: Bool {
+        let normal = sliceDirection
+        return Set(positions.map { simd_dot($0, normal) }).count > 1
+    }
+
+    // 볼륨 조립 순서: 시간 위치별로 묶은 뒤 법선 방향 위치순으로 정렬
+    // temporalIndex를 지정하면 해당 시간 위치의 프레임만 돌려줌
+    func sortedFrames(temporalIndex: Int32? = nil) -> [Int] {
+        let normal = sliceDirection
+        let distances = positions.map { simd_dot($0, normal) }
+        var frames = Array(0..<frameCount)
+        if let temporalIndex {
+            frames = frames.filter { temporalIndices[$0] == temporalIndex }
+        }
+        return frames.sorted {
+            if temporalIndices[$0] != temporalIndices[$1] {
+                return temporalIndices[$0] < temporalIndices[$1]
+            }
+            return distances[$0] < distances[$1]
+        }
+    }
+
+    // 프레임에 지정된 VOI (없으면 nil)
+    func voiDescription(frame: Int) -> DicomheroVOIDescription? {
+        guard windowCenters[frame].isFinite, windowWidths[frame].isFinite, windowWidths[frame] > 0 else {
+            return nil
+        }
+        return DicomheroVOIDescription(center: windowCenters[frame], width: windowWidths[frame], function: .linear, description: "")
+    }
+
+    // 볼륨 로더가 사용하는 슬라이스 헤더 형식으로 변환
+    func sliceHeader(frame: Int, url: URL, rows: Int, columns: Int) -> DicomVolumeLoader.SliceHeader {
+        DicomVolumeLoader.SliceHeader(url: url, position: positions[frame],
+                                      rowDirection: rowDirections[frame], columnDirection: columnDirections[frame],
+                                      pixelSpacing: pixelSpacings[frame], rows: rows, columns: columns)
+    }
+
+    private mutating func reserve(_ count: Int) {
+        positions.reserveCapacity(count)
+        rowDirections.reserveCapacity(count)
+        columnDirections.reserveCapacity(count)
+        pixelSpacings.reserveCapacity(count)
+        sliceThicknesses.reserveCapacity(count)
+        rescaleSlopes.reserveCapacity(count)
+        rescaleIntercepts.reserveCapacity(count)
+        windowCenters.reserveCapacity(count)
+        windowWidths.reserveCapacity(count)
+        temporalIndices.reserveCapacity(count)
+        stackPositions.reserveCapacity(count)
+    }
+
+    private mutating func append(_ values: FrameValues) {
+        positions.append(values.position ?? .zero)
+        rowDirections.append(values.rowDirection ?? SIMD3(1, 0, 0))
+        columnDirections.append(values.columnDirection ?? SIMD3(0, 1, 0))
+        pixelSpacings.append(values.pixelSpacing ?? SIMD2(1, 1))
+        sliceThicknesses.append(values.sliceThickness ?? 0)
+        rescaleSlopes.append(values.rescaleSlope ?? 1)
+        rescaleIntercepts.append(values.rescaleIntercept ?? 0)
+        windowCenters.append(values.windowCenter ?? .nan)
+        windowWidths.append(values.windowWidth ?? .nan)
+        temporalIndices.append(values.temporalIndex ?? 0)
+        stackPositions.append(values.stackPosition ?? 0)
+    }
+
+    private static func readTopLevel(_ dataSet: DicomheroDataSet, into values: inout FrameValues) {
+        values.position = vector3(dataSet, Tags.imagePosition, offset: 0) ?? values.position
+        values.rowDirection = vector3(dataSet, Tags.imageOrientation, offset: 0) ?? values.rowDirection
+        values.columnDirection = vector3(dataSet, Tags.imageOrientation, offset: 3) ?? values.columnDirection
+        if let row = double(dataSet, Tags.pixelSpacing, 0), let column = double(dataSet, Tags.pixelSpacing, 1) {
+            values.pixelSpacing = SIMD2(row, column)
+        }
+        values.sliceThickness = double(dataSet, Tags.sliceThickness, 0) ?? values.sliceThickness
+        values.rescaleSlope = double(dataSet, Tags.rescaleSlope, 0) ?? values.rescaleSlope
+        values.rescaleIntercept = double(dataSet, Tags.rescaleIntercept, 0) ?? values.rescaleIntercept
+        values.windowCenter = double(dataSet, Tags.windowCenter, 0) ?? values.windowCenter
+        values.windowWidth = double(dataSet, Tags.windowWidth, 0) ?? values.windowWidth
+    }
+
+    // 기능 그룹 항목 안의 매크로(각각 항목 하나짜리 시퀀스)를 읽음
+    private static func readFunctionalGroup(_ group: DicomheroDataSet, into values: inout FrameValues) {
+        if let item = try? group.getSequenceItem(Tags.planePosition, item: 0) {
+            values.position = vector3(item, Tags.imagePosition, offset: 0) ?? values.position
+        }
+        if let item = try? group.getSequenceItem(Tags.planeOrientation, item: 0) {
+            values.rowDirection = vector3(item, Tags.imageOrientation, offset: 0) ?? values.rowDirection
+            values.columnDirection = vector3(item, Tags.imageOrientation, offset: 3) ?? values.columnDirection
+        }
+        if let item = try? group.getSequenceItem(Tags.pixelMeasures, item: 0) {
+            if let row = double(item, Tags.pixelSpacing, 0), let column = double(item, Tags.pixelSpacing, 1) {
+                values.pixelSpacing = SIMD2(row, column)
+            }
+            values.sliceThickness = double(item, Tags.sliceThickness, 0) ?? values.sliceThickness
+        }
+        if let item = try? group.getSequenceItem(Tags.pixelValueTransformation, item: 0) {
+            values.rescaleSlope = double(item, Tags.rescaleSlope, 0) ?? values.rescaleSlope
+            values.rescaleIntercept = double(item, Tags.rescaleIntercept, 0) ?? values.rescaleIntercept
+        }
+        if let item = try? group.getSequenceItem(Tags.frameVOILUT, item: 0) {
+            values.windowCenter = double(item, Tags.windowCenter, 0) ?? values.windowCenter
+            values.windowWidth = double(item, Tags.windowWidth, 0) ?? values.windowWidth
+        }
+        if let item = try? group.getSequenceItem(Tags.frameContent, item: 0) {
+            if let index = try? item.getInt32(Tags.temporalIndex, elementNumber: 0) {
+                values.temporalIndex = index
+            }
+            if let position = try? item.getInt32(Tags.stackPosition, elementNumber: 0) {
+                values.stackPosition = position
+            }
+        }
+    }
+
+    private static func double(_ dataSet: DicomheroDataSet, _ tag: DicomheroTagId, _ element: UInt32) -> Double? {
+        try? dataSet.getDouble(tag, elementNumber: element)
+    }
+
+    private static func vector3(_ dataSet: DicomheroDataSet, _ tag: DicomheroTagId, offset: UInt32) -> SIMD3<Double>? {
+        guard let x = double(dataSet, tag, offset),
+              let y = double(dataSet, tag, offset + 1),
+              let z = double(dataSet, tag, offset + 2) else {
+            return nil
+        }
+        return SIMD3(x, y, z)
+    }
+}
+
+extension DicomVolumeLoader {
+    // 멀티프레임 객체 하나에서 볼륨을 조립
+    // 프레임 정렬, 공간 정보, 모달리티 변환 값은 모두 FrameGeometryTable에서 읽음
+    static func load(multiFrameURL url: URL, temporalIndex: Int32? = nil) throws -> DicomVolume {
+        let dataset = try DicomheroCodecFactory.load(fromFileMaxSize: url.path, maxBufferSize: 2048)
+        return try load(multiFrame: dataset, table: try FrameGeometryTable(dataSet: dataset), url: url, temporalIndex: temporalIndex)
+    }
+
+    // 이미 읽은 데이터셋과 테이블로 조립 (파일을 다시 읽지 않음)
+    static func load(multiFrame dataset: DicomheroDataSet, table: FrameGeometryTable, url: URL,
+                     temporalIndex: Int32? = nil) throws -> DicomVolume {
+        let frames = table.sortedFrames(temporalIndex: temporalIndex ?? table.temporalIndexValues.first)
+        guard !frames.isEmpty else {
+            throw DicomVolumeError.emptySeries
+        }
+        let rows = Int(try dataset.getUint32(DicomheroTagId(id: .enumRows_0028_0010), elementNumber: 0))
+        let columns = Int(try dataset.getUint32(DicomheroTagId(id: .enumColumns_0028_0011), elementNumber: 0))
+        let headers = frames.map { table.sliceHeader(frame: $0, url: url, rows: rows, columns: columns) }
+        let volume = makeVolume(headers: headers)
+
+        // 같은 데이터셋의 프레임을 순서대로 디코딩하고, 모달리티 변환은 테이블 값으로 직접 적용
+        for (z, frame) in frames.enumerated() {
+            try autoreleasepool {
+                let image = try dataset.getImage(UInt32(frame))
+                try image.copyPixels(to: volume.slice(z), count: volume.sliceSize,
+                                     rescale: (table.rescaleSlopes[frame], table.rescaleIntercepts[frame]))
+            }
+        }
+        return volume
+    }
+}
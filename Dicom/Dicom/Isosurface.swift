@@ -0,0 +1,668 @@
+//
+//  Isosurface.swift
+//  Dicom
+//
+//  Created by hanjongwoo on 10/19/26.
+//
+
+import Foundation
+import simd
+
+// 등가면 추출 임계값 프리셋 (HU)
+enum IsosurfacePreset {
+    case bone
+    case skin
+
+    var threshold: Int16 {
+        switch self {
+        case .bone: return 300
+        case .skin: return -500
+        }
+    }
+}
+
+// 블록 단위 최소/최대값 피라미드
+// 임계값이 블록의 [min, max] 범위를 벗어나면 그 블록에는 등가면이 지나가지 않으므로 통째로 건너뜀
+final class MinMaxPyramid {
+    let blockSize: Int
+    // levels[0]은 블록 단위, 상위 레벨은 하위 레벨의 2x2x2 블록을 합친 값
+    private(set) var levels: [[SIMD2<Int16>]] = []
+    private(set) var levelDimensions: [SIMD3<Int>] = []
+
+    init(volume: DicomVolume, blockSize: Int = 8) {
+        self.blockSize = blockSize
+        buildBaseLevel(volume: volume)
+        while let last = levelDimensions.last, last.x > 1 || last.y > 1 || last.z > 1 {
+            buildNextLevel()
+        }
+    }
+
+    var blockDimensions: SIMD3<Int> { levelDimensions[0] }
+    var blockCount: Int { levels[0].count }
+
+    // 등가면이 지나갈 수 있는 블록 목록 (levels[0] 인덱스)
+    // 꼭짓점 값이 임계값 이상이면 내부로 보므로 min < threshold <= max 인 블록만 해당
+    func activeBlocks(threshold: Int16) -> [Int] {
+        var result: [Int] = []
+        visit(level: levels.count - 1, cell: .zero, threshold: threshold, result: &result)
+        return result
+    }
+
+    private func visit(level: Int, cell: SIMD3<Int>, threshold: Int16, result: inout [Int]) {
+        let dims = levelDimensions[level]
+        guard cell.x < dims.x, cell.y < dims.y, cell.z < dims.z else {
+            return
+        }
+        let index = (cell.z * dims.y + cell.y) * dims.x + cell.x
+        let range = levels[level][index]
+        guard range.x < threshold, range.y >= threshold else {
+            return
+        }
+        if level == 0 {
+            result.append(index)
+            return
+        }
+        for dz in 0..<2 {
+            for dy in 0..<2 {
+                for dx in 0..<2 {
+                    visit(level: level - 1, cell: cell &* 2 &+ SIMD3(dx, dy, dz), threshold: threshold, result: &result)
+                }
+            }
+        }
+    }
+
+    private func buildBaseLevel(volume: DicomVolume) {
+        // 셀 개수는 복셀 개수 - 1, 블록은 셀 단위로 나눔
+        let cells = SIMD3(max(volume.width - 1, 1), max(volume.height - 1, 1), max(volume.depth - 1, 1))
+        let dims = (cells &+ (blockSize - 1)) / blockSize
+        var base = [SIMD2<Int16>](repeating: SIMD2(.max, .min), count: dims.x * dims.y * dims.z)
+        let voxels = volume.voxels.baseAddress!
+        let blockSize = blockSize
+        base.withUnsafeMutableBufferPointer { buffer in
+            let output = buffer
+            // 블록 z 층마다 독립적으로 계산 (서로 다른 영역에만 기록하므로 잠금 불필요)
+            DispatchQueue.concurrentPerform(iterations: dims.z) { bz in
+                for by in 0..<dims.y {
+                    for bx in 0..<dims.x {
+                        // 블록이 포함하는 셀의 꼭짓점까지 포함하도록 끝 복셀도 포함
+                        let x0 = bx * blockSize, x1 = min(x0 + blockSize, volume.width - 1)
+                        let y0 = by * blockSize, y1 = min(y0 + blockSize, volume.height - 1)
+                        let z0 = bz * blockSize, z1 = min(z0 + blockSize, volume.depth - 1)
+                        var low = Int16.max
+                        var high = Int16.min
+                        for z in z0...z1 {
+                            for y in y0...y1 {
+                                let row = voxels + volume.index(x0, y, z)
+                                for x in 0...(x1 - x0) {
+                                    let value = row[x]
+                                    low = min(low, value)
+                                    high = max(high, value)
+                                }
+                            }
+                        }
+                        output[(bz * dims.y + by) * dims.x + bx] = SIMD2(low, high)
+                    }
+                }
+            }
+        }
+        levels = [base]
+        levelDimensions = [dims]
+    }
+
+    private func buildNextLevel() {
+        let below = levels[levels.count - 1]
+        let belowDims = levelDimensions[levelDimensions.count - 1]
+        let dims = (belowDims &+ 1) / 2
+        var level = [SIMD2<Int16>](repeating: SIMD2(.max, .min), count: dims.x * dims.y * dims.z)
+        for z in 0..<belowDims.z {
+            for y in 0..<belowDims.y {
+                for x in 0..<belowDims.x {
+                    let range = below[(z * belowDims.y + y) * belowDims.x + x]
+                    let parent = ((z / 2) * dims.y + y / 2) * dims.x + x / 2
+                    level[parent] = SIMD2(min(level[parent].x, range.x), max(level[parent].y, range.y))
+                }
+            }
+        }
+        levels.append(level)
+        levelDimensions.append(dims)
+    }
+}
+
+// 추출된 삼각형 메시 (환자 좌표계, mm)
+struct IsosurfaceMesh {
+    var positions: [SIMD3<Float>] = []
+    var normals: [SIMD3<Float>] = []   // 값이 낮아지는 방향(표면 바깥쪽)을 향하는 단위 벡터
+    var indices: [UInt32] = []         // 삼각형마다 정점 인덱스 3개
+
+    var vertexCount: Int { positions.count }
+    var triangleCount: Int { indices.count / 3 }
+}
+
+extension IsosurfaceMesh {
+    // 간단한 바이너리 메시 포맷 (리틀 엔디언)
+    // "DMSH" | 버전(UInt32) | 정점 수(UInt32) | 삼각형 수(UInt32)
+    // | 위치(Float32 x 3 x 정점 수) | 법선(Float32 x 3 x 정점 수) | 인덱스(UInt32 x 3 x 삼각형 수)
+    static let fileMagic = Array("DMSH".utf8)
+    static let fileVersion: UInt32 = 1
+
+    func write(to url: URL) throws {
+        var data = Data(capacity: 16 + vertexCount * 24 + indices.count * 4)
+        data.append(contentsOf: IsosurfaceMesh.fileMagic)
+        for value in [IsosurfaceMesh.fileVersion, UInt32(vertexCount), UInt32(triangleCount)] {
+            withUnsafeBytes(of: value.littleEndian) { data.append(contentsOf: $0) }
+        }
+        // SIMD3<Float>는 16바이트로 정렬되므로 12바이트씩 채워서 기록
+        for vectors in [positions, normals] {
+            var packed = [Float]()
+            packed.reserveCapacity(vectors.count * 3)
+            for v in vectors {
+                packed.append(v.x)
+                packed.append(v.y)
+                packed.append(v.z)
+            }
+            packed.withUnsafeBytes { data.append(contentsOf: $0) }
+        }
+        indices.withUnsafeBytes { data.append(contentsOf: $0) }
+        try data.write(to: url, options: .atomic)
+    }
+}
+
+// 추출 통계 (벤치마크용)
+struct IsosurfaceStatistics: CustomStringConvertible {
+    var totalBlocks = 0
+    var activeBlocks = 0
+    var vertexCount = 0
+    var triangleCount = 0
+    var pyramidSeconds = 0.0  // 최소/최대 피라미드 생성 시간
+    var extractSeconds = 0.0  // 블록별 병렬 추출 시간
+    var mergeSeconds = 0.0    // 스레드별 버퍼 병합 시간
+
+    var totalSeconds: Double { pyramidSeconds + extractSeconds + mergeSeconds }
+    var trianglesPerSecond: Double { totalSeconds > 0 ? Double(triangleCount) / totalSeconds : 0 }
+
+    var description: String {
+        String(format: "blocks %d/%d, %d triangles, %d vertices, pyramid %.3fs, extract %.3fs, merge %.3fs, %.0f triangles/s",
+               activeBlocks, totalBlocks, triangleCount, vertexCount,
+               pyramidSeconds, extractSeconds, mergeSeconds, trianglesPerSecond)
+    }
+}
+
+// 병렬 마칭 큐브 등가면 추출기
+enum IsosurfaceExtractor {
+    // 한 작업 단위가 처리하는 활성 블록 수
+    static let blocksPerTask = 16
+
+    // 작업 단위별 지역 버퍼 (다른 스레드와 공유하지 않음)
+    private struct LocalMesh {
+        var positions: [SIMD3<Float>] = []
+        var normals: [SIMD3<Float>] = []
+        var indices: [UInt32] = []
+        var vertexForEdge: [Int: UInt32] = [:] // 같은 모서리의 정점을 재사용하기 위한 맵
+    }
+
+    static func extract(volume: DicomVolume, preset: IsosurfacePreset, pyramid: MinMaxPyramid? = nil) -> (IsosurfaceMesh, IsosurfaceStatistics) {
+        extract(volume: volume, threshold: preset.threshold, pyramid: pyramid)
+    }
+
+    // pyramid를 넘기면 같은 볼륨에서 임계값을 바꿔 여러 번 추출할 때 피라미드를 재사용
+    static func extract(volume: DicomVolume, threshold: Int16, pyramid: MinMaxPyramid? = nil) -> (IsosurfaceMesh, IsosurfaceStatistics) {
+        var statistics = IsosurfaceStatistics()
+        var start = CFAbsoluteTimeGetCurrent()
+
+        let pyramid = pyramid ?? MinMaxPyramid(volume: volume)
+        let blocks = pyramid.activeBlocks(threshold: threshold)
+        statistics.totalBlocks = pyramid.blockCount
+        statistics.activeBlocks = blocks.count
+        statistics.pyramidSeconds = CFAbsoluteTimeGetCurrent() - start
+        start = CFAbsoluteTimeGetCurrent()
+
+        // 작업 단위마다 자기 슬롯에만 결과를 기록하므로 잠금 없이 병렬 처리
+        let taskCount = (blocks.count + blocksPerTask - 1) / blocksPerTask
+        var locals = [LocalMesh](repeating: LocalMesh(), count: taskCount)
+        locals.withUnsafeMutableBufferPointer { buffer in
+            let slots = buffer
+            DispatchQueue.concurrentPerform(iterations: taskCount) { task in
+                var local = LocalMesh()
+                let end = min((task + 1) * blocksPerTask, blocks.count)
+                for block in blocks[(task * blocksPerTask)..<end] {
+                    polygonize(volume: volume, pyramid: pyramid, block: block, threshold: threshold, into: &local)
+                }
+                local.vertexForEdge = [:]
+                slots[task] = local
+            }
+        }
+        statistics.extractSeconds = CFAbsoluteTimeGetCurrent() - start
+        start = CFAbsoluteTimeGetCurrent()
+
+        let mesh = merge(locals)
+        statistics.vertexCount = mesh.vertexCount
+        statistics.triangleCount = mesh.triangleCount
+        statistics.mergeSeconds = CFAbsoluteTimeGetCurrent() - start
+        return (mesh, statistics)
+    }
+
+    // 지역 버퍼의 크기로 오프셋을 미리 계산한 뒤 각자 겹치지 않는 영역에 복사
+    private static func merge(_ locals: [LocalMesh]) -> IsosurfaceMesh {
+        var vertexOffsets = [Int](repeating: 0, count: locals.count + 1)
+        var indexOffsets = [Int](repeating: 0, count: locals.count + 1)
+        for (i, local) in locals.enumerated() {
+            vertexOffsets[i + 1] = vertexOffsets[i] + local.positions.count
+            indexOffsets[i + 1] = indexOffsets[i] + local.indices.count
+        }
+        var positions = [SIMD3<Float>](repeating: .zero, count: vertexOffsets[locals.count])
+        var normals = [SIMD3<Float>](repeating: .zero, count: vertexOffsets[locals.count])
+        var indices = [UInt32](repeating: 0, count: indexOffsets[locals.count])
+        positions.withUnsafeMutableBufferPointer { positionBuffer in
+            normals.withUnsafeMutableBufferPointer { normalBuffer in
+                indices.withUnsafeMutableBufferPointer { indexBuffer in
+                    let positions = positionBuffer, normals = normalBuffer, indices = indexBuffer
+                    DispatchQueue.concurrentPerform(iterations: locals.count) { i in
+                        let local = locals[i]
+                        let vertexBase = vertexOffsets[i]
+                        for (j, position) in local.positions.enumerated() {
+                            positions[vertexBase + j] = position
+                            normals[vertexBase + j] = local.normals[j]
+                        }
+                        let indexBase = indexOffsets[i]
+                        for (j, index) in local.indices.enumerated() {
+                            indices[indexBase + j] = index + UInt32(vertexBase)
+                        }
+                    }
+                }
+            }
+        }
+        return IsosurfaceMesh(positions: positions, normals: normals, indices: indices)
+    }
+
+    // 블록 하나에 포함된 셀들을 삼각형으로 변환
+    private static func polygonize(volume: DicomVolume, pyramid: MinMaxPyramid, block: Int, threshold: Int16, into local: inout LocalMesh) {
+        let dims = pyramid.blockDimensions
+        let size = pyramid.blockSize
+        let bx = block % dims.x
+        let by = (block / dims.x) % dims.y
+        let bz = block / (dims.x * dims.y)
+        let x0 = bx * size, x1 = min(x0 + size, volume.width - 1)
+        let y0 = by * size, y1 = min(y0 + size, volume.height - 1)
+        let z0 = bz * size, z1 = min(z0 + size, volume.depth - 1)
+
+        let voxels = volume.voxels.baseAddress!
+        let rowStride = volume.width
+        let sliceStride = volume.sliceSize
+        // 꼭짓점 0~7의 복셀 인덱스 오프셋 (cornerOffsets 순서)
+        let offsets = [0, 1, rowStride + 1, rowStride, sliceStride, sliceStride + 1, sliceStride + rowStride + 1, sliceStride + rowStride]
+
+        for z in z0..<z1 {
+            for y in y0..<y1 {
+                for x in x0..<x1 {
+                    let base = volume.index(x, y, z)
+                    var cubeIndex = 0
+                    for corner in 0..<8 where voxels[base + offsets[corner]] >= threshold {
+                        cubeIndex |= 1 << corner
+                    }
+                    if cubeIndex == 0 || cubeIndex == 255 {
+                        continue
+                    }
+                    let row = cubeIndex * 16
+                    var i = 0
+                    while i < 16, triangleTable[row + i] >= 0 {
+                        let edge = Int(triangleTable[row + i])
+                        local.indices.append(vertex(volume: volume, cell: SIMD3(x, y, z), edge: edge, threshold: threshold, into: &local))
+                        i += 1
+                    }
+                }
+            }
+        }
+    }
+
+    // 모서리 위의 등가점 정점을 찾거나 새로 생성
+    // 보간은 항상 모서리의 낮은 쪽 꼭짓점에서 시작하므로 이웃 셀과 같은 위치가 계산됨
+    private static func vertex(volume: DicomVolume, cell: SIMD3<Int>, edge: Int, threshold: Int16, into local: inout LocalMesh) -> UInt32 {
+        let lower = cell &+ edgeLowerCorners[edge]
+        let axis = edgeAxes[edge]
+        let key = volume.index(lower.x, lower.y, lower.z) * 3 + axis
+        if let existing = local.vertexForEdge[key] {
+            return existing
+        }
+        var upper = lower
+        upper[axis] += 1
+        let a = Float(volume[lower.x, lower.y, lower.z])
+        let b = Float(volume[upper.x, upper.y, upper.z])
+        let t = a == b ? 0.5 : (Float(threshold) - a) / (b - a)
+
+        var point = SIMD3<Float>(lower)
+        point[axis] += t
+        let gradient = simd_mix(gradientAt(volume: volume, lower), gradientAt(volume: volume, upper), SIMD3(repeating: t))
+
+        let index = UInt32(local.positions.count)
+        local.positions.append(patientPosition(volume: volume, index: point))
+        local.normals.append(patientNormal(volume: volume, gradient: gradient))
+        local.vertexForEdge[key] = index
+        return index
+    }
+
+    // 중앙 차분으로 구한 복셀 인덱스 공간의 그레이디언트
+    private static func gradientAt(volume: DicomVolume, _ p: SIMD3<Int>) -> SIMD3<Float> {
+        let maxIndex = SIMD3(volume.width - 1, volume.height - 1, volume.depth - 1)
+        var gradient = SIMD3<Float>.zero
+        for axis in 0..<3 {
+            var forward = p, backward = p
+            forward[axis] = min(p[axis] + 1, maxIndex[axis])
+            backward[axis] = max(p[axis] - 1, 0)
+            let distance = Float(max(forward[axis] - backward[axis], 1))
+            gradient[axis] = (Float(volume[forward.x, forward.y, forward.z]) - Float(volume[backward.x, backward.y, backward.z])) / distance
+        }
+        return gradient
+    }
+
+    private static func patientPosition(volume: DicomVolume, index: SIMD3<Float>) -> SIMD3<Float> {
+        let millimeters = index * volume.spacing
+        return volume.origin
+            + volume.rowDirection * millimeters.x
+            + volume.columnDirection * millimeters.y
+            + volume.sliceDirection * millimeters.z
+    }
+
+    // 그레이디언트는 값이 커지는 방향이므로 반대로 뒤집어 표면 바깥쪽 법선으로 사용
+    private static func patientNormal(volume: DicomVolume, gradient: SIMD3<Float>) -> SIMD3<Float> {
+        let scaled = gradient / volume.spacing
+        let normal = -(volume.rowDirection * scaled.x + volume.columnDirection * scaled.y + volume.sliceDirection * scaled.z)
+        let length = simd_length(normal)
+        return length > 0 ? normal / length : .zero
+    }
+
+    // 합성 팬텀으로 추출 속도를 측정 (삼각형/초)
+    // 구 껍질 형태의 뼈(1000 HU)와 연부 조직(40 HU), 공기(-1000 HU)로 구성
+    static func benchmark(width: Int = 512, height: Int = 512, depth: Int = 800) -> IsosurfaceStatistics {
+        let volume = DicomVolume(width: width, height: height, depth: depth, spacing: SIMD3(0.7, 0.7, 0.625))
+        let center = SIMD3<Float>(Float(width), Float(height), Float(depth)) / 2
+        let radius = Float(min(width, height)) * 0.45
+        DispatchQueue.concurrentPerform(iterations: depth) { z in
+            let slice = volume.slice(z)
+            for y in 0..<height {
+                for x in 0..<width {
+                    let p = (SIMD3<Float>(Float(x), Float(y), Float(z)) - center) / SIMD3(radius, radius, Float(depth) / 2)
+                    let r = simd_length(p)
+                    // 갈비뼈처럼 반복되는 껍질을 만들기 위해 z 방향으로 변조
+                    let ribs = sin(Float(z) * 0.15) > 0.3
+                    let value: Int16 = r > 1 ? -1000 : (r > 0.9 && ribs ? 1000 : (r < 0.2 ? 700 : 40))
+                    slice[y * width + x] = value
+                }
+            }
+        }
+        let (_, statistics) = extract(volume: volume, preset: .bone)
+        print("isosurface benchmark \(width)x\(height)x\(depth): \(statistics)")
+        return statistics
+    }
+}
+
+// 마칭 큐브 테이블
+// 꼭짓점 번호: 0(0,0,0) 1(1,0,0) 2(1,1,0) 3(0,1,0) 4(0,0,1) 5(1,0,1) 6(1,1,1) 7(0,1,1)
+// 모서리 번호: 0(0-1) 1(1-2) 2(2-3) 3(3-0) 4(4-5) 5(5-6) 6(6-7) 7(7-4) 8(0-4) 9(1-5) 10(2-6) 11(3-7)
+// 모호한 면에서는 내부 꼭짓점끼리 분리하는 쪽으로 일관되게 연결하여 이웃 셀 사이에 구멍이 생기지 않음
+// 각 삼각형은 법선이 표면 바깥쪽(값이 낮은 쪽)을 향하도록 정렬됨
+private let edgeLowerCorners: [SIMD3<Int>] = [
+    SIMD3(0, 0, 0), SIMD3(1, 0, 0), SIMD3(0, 1, 0), SIMD3(0, 0, 0),
+    SIMD3(0, 0, 1), SIMD3(1, 0, 1), SIMD3(0, 1, 1), SIMD3(0, 0, 1),
+    SIMD3(0, 0, 0), SIMD3(1, 0, 0), SIMD3(1, 1, 0), SIMD3(0, 1, 0)
+]
+private let edgeAxes: [Int] = [0, 1, 0, 1, 0, 1, 0, 1, 2, 2, 2, 2]
+
+// 256개 경우마다 최대 5개의 삼각형(모서리 번호 3개씩), -1로 끝을 표시
+private let triangleTable: [Int8] = [
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+         3,  8,  0, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+         9,  1,  0, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+         3,  8,  9,  3,  9,  1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+         1, 10,  2, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+         3,  8,  0,  1, 10,  2, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+         9, 10,  2,  9,  2,  0, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+         3,  8,  9,  3,  9, 10,  3, 10,  2, -1, -1, -1, -1, -1, -1, -1,
+        11,  3,  2, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        11,  8,  0, 11,  0,  2, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        11,  3,  2,  9,  1,  0, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        11,  8,  9, 11,  9,  1, 11,  1,  2, -1, -1, -1, -1, -1, -1, -1,
+        11,  3,  1, 11,  1, 10, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        11,  8,  0, 11,  0,  1, 11,  1, 10, -1, -1, -1, -1, -1, -1, -1,
+        11,  3,  0, 11,  0,  9, 11,  9, 10, -1, -1, -1, -1, -1, -1, -1,
+        11,  8,  9, 11,  9, 10, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+         8,  7,  4, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+         3,  7,  4,  3,  4,  0, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+         8,  7,  4,  9,  1,  0, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+         3,  7,  4,  3,  4,  9,  3,  9,  1, -1, -1, -1, -1, -1, -1, -1,
+         8,  7,  4,  1, 10,  2, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+         3,  7,  4,  3,  4,  0,  1, 10,  2, -1, -1, -1, -1, -1, -1, -1,
+         8,  7,  4,  9, 10,  2,  9,  2,  0, -1, -1, -1, -1, -1, -1, -1,
+         3,  7,  4,  3,  4,  9,  3,  9, 10,  3, 10,  2, -1, -1, -1, -1,
+         8,  7,  4, 11,  3,  2, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        11,  7,  4, 11,  4,  0, 11,  0,  2, -1, -1, -1, -1, -1, -1, -1,
+         8,  7,  4, 11,  3,  2,  9,  1,  0, -1, -1, -1, -1, -1, -1, -1,
+        11,  7,  4, 11,  4,  9, 11,  9,  1, 11,  1,  2, -1, -1, -1, -1,
+         8,  7,  4, 11,  3,  1, 11,  1, 10, -1, -1, -1, -1, -1, -1, -1,
+        11,  7,  4, 11,  4,  0, 11,  0,  1, 11,  1, 10, -1, -1, -1, -1,
+         8,  7,  4, 11,  3,  0, 11,  0,  9, 11,  9, 10, -1, -1, -1, -1,
+        11,  7,  4, 11,  4,  9, 11,  9, 10, -1, -1, -1, -1, -1, -1, -1,
+         5,  9,  4, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+         3,  8,  0,  5,  9,  4, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+         5,  1,  0,  5,  0,  4, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+         3,  8,  4,  3,  4,  5,  3,  5,  1, -1, -1, -1, -1, -1, -1, -1,
+         1, 10,  2,  5,  9,  4, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+         3,  8,  0,  1, 10,  2,  5,  9,  4, -1, -1, -1, -1, -1, -1, -1,
+         5, 10,  2,  5,  2,  0,  5,  0,  4, -1, -1, -1, -1, -1, -1, -1,
+         3,  8,  4,  3,  4,  5,  3,  5, 10,  3, 10,  2, -1, -1, -1, -1,
+        11,  3,  2,  5,  9,  4, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        11,  8,  0, 11,  0,  2,  5,  9,  4, -1, -1, -1, -1, -1, -1, -1,
+        11,  3,  2,  5,  1,  0,  5,  0,  4, -1, -1, -1, -1, -1, -1, -1,
+        11,  8,  4, 11,  4,  5, 11,  5,  1, 11,  1,  2, -1, -1, -1, -1,
+        11,  3,  1, 11,  1, 10,  5,  9,  4, -1, -1, -1, -1, -1, -1, -1,
+        11,  8,  0, 11,  0,  1, 11,  1, 10,  5,  9,  4, -1, -1, -1, -1,
+        11,  3,  0, 11,  0,  4, 11,  4,  5, 11,  5, 10, -1, -1, -1, -1,
+        11,  8,  4, 11,  4,  5, 11,  5, 10, -1, -1, -1, -1, -1, -1, -1,
+         8,  7,  5,  8,  5,  9, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+         3,  7,  5,  3,  5,  9,  3,  9,  0, -1, -1, -1, -1, -1, -1, -1,
+         8,  7,  5,  8,  5,  1,  8,  1,  0, -1, -1, -1, -1, -1, -1, -1,
+         3,  7,  5,  3,  5,  1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+         8,  7,  5,  8,  5,  9,  1, 10,  2, -1, -1, -1, -1, -1, -1, -1,
+         3,  7,  5,  3,  5,  9,  3,  9,  0,  1, 10,  2, -1, -1, -1, -1,
+         8,  7,  5,  8,  5, 10,  8, 10,  2,  8,  2,  0, -1, -1, -1, -1,
+         3,  7,  5,  3,  5, 10,  3, 10,  2, -1, -1, -1, -1, -1, -1, -1,
+         8,  7,  5,  8,  5,  9, 11,  3,  2, -1, -1, -1, -1, -1, -1, -1,
+        11,  7,  5, 11,  5,  9, 11,  9,  0, 11,  0,  2, -1, -1, -1, -1,
+         8,  7,  5,  8,  5,  1,  8,  1,  0, 11,  3,  2, -1, -1, -1, -1,
+        11,  7,  5, 11,  5,  1, 11,  1,  2, -1, -1, -1, -1, -1, -1, -1,
+         8,  7,  5,  8,  5,  9, 11,  3,  1, 11,  1, 10, -1, -1, -1, -1,
+        11,  7,  5, 11,  5,  9, 11,  9,  0, 11,  0,  1, 11,  1, 10, -1,
+         5, 10, 11,  5, 11,  3,  5,  3,  0,  5,  0,  8,  5,  8,  7, -1,
+        11,  7,  5, 11,  5, 10, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        10,  5,  6, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+         3,  8,  0, 10,  5,  6, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        10,  5,  6,  9,  1,  0, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+         3,  8,  9,  3,  9,  1, 10,  5,  6, -1, -1, -1, -1, -1, -1, -1,
+         1,  5,  6,  1,  6,  2, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+         3,  8,  0,  1,  5,  6,  1,  6,  2, -1, -1, -1, -1, -1, -1, -1,
+         9,  5,  6,  9,  6,  2,  9,  2,  0, -1, -1, -1, -1, -1, -1, -1,
+         3,  8,  9,  3,  9,  5,  3,  5,  6,  3,  6,  2, -1, -1, -1, -1,
+        11,  3,  2, 10,  5,  6, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        11,  8,  0, 11,  0,  2, 10,  5,  6, -1, -1, -1, -1, -1, -1, -1,
+        11,  3,  2, 10,  5,  6,  9,  1,  0, -1, -1, -1, -1, -1, -1, -1,
+        11,  8,  9, 11,  9,  1, 11,  1,  2, 10,  5,  6, -1, -1, -1, -1,
+        11,  3,  1, 11,  1,  5, 11,  5,  6, -1, -1, -1, -1, -1, -1, -1,
+        11,  8,  0, 11,  0,  1, 11,  1,  5, 11,  5,  6, -1, -1, -1, -1,
+        11,  3,  0, 11,  0,  9, 11,  9,  5, 11,  5,  6, -1, -1, -1, -1,
+        11,  8,  9, 11,  9,  5, 11,  5,  6, -1, -1, -1, -1, -1, -1, -1,
+         8,  7,  4, 10,  5,  6, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+         3,  7,  4,  3,  4,  0, 10,  5,  6, -1, -1, -1, -1, -1, -1, -1,
+         8,  7,  4, 10,  5,  6,  9,  1,  0, -1, -1, -1, -1, -1, -1, -1,
+         3,  7,  4,  3,  4,  9,  3,  9,  1, 10,  5,  6, -1, -1, -1, -1,
+         8,  7,  4,  1,  5,  6,  1,  6,  2, -1, -1, -1, -1, -1, -1, -1,
+         3,  7,  4,  3,  4,  0,  1,  5,  6,  1,  6,  2, -1, -1, -1, -1,
+         8,  7,  4,  9,  5,  6,  9,  6,  2,  9,  2,  0, -1, -1, -1, -1,
+         3,  7,  4,  3,  4,  9,  3,  9,  5,  3,  5,  6,  3,  6,  2, -1,
+         8,  7,  4, 11,  3,  2, 10,  5,  6, -1, -1, -1, -1, -1, -1, -1,
+        11,  7,  4, 11,  4,  0, 11,  0,  2, 10,  5,  6, -1, -1, -1, -1,
+         8,  7,  4, 11,  3,  2, 10,  5,  6,  9,  1,  0, -1, -1, -1, -1,
+        11,  7,  4, 11,  4,  9, 11,  9,  1, 11,  1,  2, 10,  5,  6, -1,
+         8,  7,  4, 11,  3,  1, 11,  1,  5, 11,  5,  6, -1, -1, -1, -1,
+        11,  7,  4, 11,  4,  0, 11,  0,  1, 11,  1,  5, 11,  5,  6, -1,
+         8,  7,  4, 11,  3,  0, 11,  0,  9, 11,  9,  5, 11,  5,  6, -1,
+        11,  7,  4, 11,  4,  9, 11,  9,  5, 11,  5,  6, -1, -1, -1, -1,
+        10,  9,  4, 10,  4,  6, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+         3,  8,  0, 10,  9,  4, 10,  4,  6, -1, -1, -1, -1, -1, -1, -1,
+        10,  1,  0, 10,  0,  4, 10,  4,  6, -1, -1, -1, -1, -1, -1, -1,
+         3,  8,  4,  3,  4,  6,  3,  6, 10,  3, 10,  1, -1, -1, -1, -1,
+         1,  9,  4,  1,  4,  6,  1,  6,  2, -1, -1, -1, -1, -1, -1, -1,
+         3,  8,  0,  1,  9,  4,  1,  4,  6,  1,  6,  2, -1, -1, -1, -1,
+         0,  4,  6,  0,  6,  2, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+         3,  8,  4,  3,  4,  6,  3,  6,  2, -1, -1, -1, -1, -1, -1, -1,
+        11,  3,  2, 10,  9,  4, 10,  4,  6, -1, -1, -1, -1, -1, -1, -1,
+        11,  8,  0, 11,  0,  2, 10,  9,  4, 10,  4,  6, -1, -1, -1, -1,
+        11,  3,  2, 10,  1,  0, 10,  0,  4, 10,  4,  6, -1, -1, -1, -1,
+         8,  4,  6,  8,  6, 10,  8, 10,  1,  8,  1,  2,  8,  2, 11, -1,
+        11,  3,  1, 11,  1,  9, 11,  9,  4, 11,  4,  6, -1, -1, -1, -1,
+        11,  8,  0, 11,  0,  1, 11,  1,  9, 11,  9,  4, 11,  4,  6, -1,
+        11,  3,  0, 11,  0,  4, 11,  4,  6, -1, -1, -1, -1, -1, -1, -1,
+        11,  8,  4, 11,  4,  6, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+         8,  7,  6,  8,  6, 10,  8, 10,  9, -1, -1, -1, -1, -1, -1, -1,
+         3,  7,  6,  3,  6, 10,  3, 10,  9,  3,  9,  0, -1, -1, -1, -1,
+         8,  7,  6,  8,  6, 10,  8, 10,  1,  8,  1,  0, -1, -1, -1, -1,
+         3,  7,  6,  3,  6, 10,  3, 10,  1, -1, -1, -1, -1, -1, -1, -1,
+         8,  7,  6,  8,  6,  2,  8,  2,  1,  8,  1,  9, -1, -1, -1, -1,
+         7,  6,  2,  7,  2,  1,  7,  1,  9,  7,  9,  0,  7,  0,  3, -1,
+         8,  7,  6,  8,  6,  2,  8,  2,  0, -1, -1, -1, -1, -1, -1, -1,
+         3,  7,  6,  3,  6,  2, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+         8,  7,  6,  8,  6, 10,  8, 10,  9, 11,  3,  2, -1, -1, -1, -1,
+         7,  6, 10,  7, 10,  9,  7,  9,  0,  7,  0,  2,  7,  2, 11, -1,
+         8,  7,  6,  8,  6, 10,  8, 10,  1,  8,  1,  0, 11,  3,  2, -1,
+         7,  6, 10,  7, 10,  1,  7,  1,  2,  7,  2, 11, -1, -1, -1, -1,
+         6, 11,  3,  6,  3,  1,  6,  1,  9,  6,  9,  8,  6,  8,  7, -1,
+        11,  7,  6,  1,  9,  0, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+         6, 11,  3,  6,  3,  0,  6,  0,  8,  6,  8,  7, -1, -1, -1, -1,
+        11,  7,  6, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+         7, 11,  6, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+         7, 11,  6,  3,  8,  0, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+         7, 11,  6,  9,  1,  0, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+         7, 11,  6,  3,  8,  9,  3,  9,  1, -1, -1, -1, -1, -1, -1, -1,
+         7, 11,  6,  1, 10,  2, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+         7, 11,  6,  3,  8,  0,  1, 10,  2, -1, -1, -1, -1, -1, -1, -1,
+         7, 11,  6,  9, 10,  2,  9,  2,  0, -1, -1, -1, -1, -1, -1, -1,
+         7, 11,  6,  3,  8,  9,  3,  9, 10,  3, 10,  2, -1, -1, -1, -1,
+         7,  3,  2,  7,  2,  6, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+         7,  8,  0,  7,  0,  2,  7,  2,  6, -1, -1, -1, -1, -1, -1, -1,
+         7,  3,  2,  7,  2,  6,  9,  1,  0, -1, -1, -1, -1, -1, -1, -1,
+         7,  8,  9,  7,  9,  1,  7,  1,  2,  7,  2,  6, -1, -1, -1, -1,
+         7,  3,  1,  7,  1, 10,  7, 10,  6, -1, -1, -1, -1, -1, -1, -1,
+         7,  8,  0,  7,  0,  1,  7,  1, 10,  7, 10,  6, -1, -1, -1, -1,
+         7,  3,  0,  7,  0,  9,  7,  9, 10,  7, 10,  6, -1, -1, -1, -1,
+         7,  8,  9,  7,  9, 10,  7, 10,  6, -1, -1, -1, -1, -1, -1, -1,
+         8, 11,  6,  8,  6,  4, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+         3, 11,  6,  3,  6,  4,  3,  4,  0, -1, -1, -1, -1, -1, -1, -1,
+         8, 11,  6,  8,  6,  4,  9,  1,  0, -1, -1, -1, -1, -1, -1, -1,
+         3, 11,  6,  3,  6,  4,  3,  4,  9,  3,  9,  1, -1, -1, -1, -1,
+         8, 11,  6,  8,  6,  4,  1, 10,  2, -1, -1, -1, -1, -1, -1, -1,
+         3, 11,  6,  3,  6,  4,  3,  4,  0,  1, 10,  2, -1, -1, -1, -1,
+         8, 11,  6,  8,  6,  4,  9, 10,  2,  9,  2,  0, -1, -1, -1, -1,
+         3, 11,  6,  3,  6,  4,  3,  4,  9,  3,  9, 10,  3, 10,  2, -1,
+         8,  3,  2,  8,  2,  6,  8,  6,  4, -1, -1, -1, -1, -1, -1, -1,
+         4,  0,  2,  4,  2,  6, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+         8,  3,  2,  8,  2,  6,  8,  6,  4,  9,  1,  0, -1, -1, -1, -1,
+         9,  1,  2,  9,  2,  6,  9,  6,  4, -1, -1, -1, -1, -1, -1, -1,
+         8,  3,  1,  8,  1, 10,  8, 10,  6,  8,  6,  4, -1, -1, -1, -1,
+         1, 10,  6,  1,  6,  4,  1,  4,  0, -1, -1, -1, -1, -1, -1, -1,
+         3,  0,  9,  3,  9, 10,  3, 10,  6,  3,  6,  4,  3,  4,  8, -1,
+         9, 10,  6,  9,  6,  4, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+         7, 11,  6,  5,  9,  4, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+         7, 11,  6,  3,  8,  0,  5,  9,  4, -1, -1, -1, -1, -1, -1, -1,
+         7, 11,  6,  5,  1,  0,  5,  0,  4, -1, -1, -1, -1, -1, -1, -1,
+         7, 11,  6,  3,  8,  4,  3,  4,  5,  3,  5,  1, -1, -1, -1, -1,
+         7, 11,  6,  1, 10,  2,  5,  9,  4, -1, -1, -1, -1, -1, -1, -1,
+         7, 11,  6,  3,  8,  0,  1, 10,  2,  5,  9,  4, -1, -1, -1, -1,
+         7, 11,  6,  5, 10,  2,  5,  2,  0,  5,  0,  4, -1, -1, -1, -1,
+         7, 11,  6,  3,  8,  4,  3,  4,  5,  3,  5, 10,  3, 10,  2, -1,
+         7,  3,  2,  7,  2,  6,  5,  9,  4, -1, -1, -1, -1, -1, -1, -1,
+         7,  8,  0,  7,  0,  2,  7,  2,  6,  5,  9,  4, -1, -1, -1, -1,
+         7,  3,  2,  7,  2,  6,  5,  1,  0,  5,  0,  4, -1, -1, -1, -1,
+         8,  4,  5,  8,  5,  1,  8,  1,  2,  8,  2,  6,  8,  6,  7, -1,
+         7,  3,  1,  7,  1, 10,  7, 10,  6,  5,  9,  4, -1, -1, -1, -1,
+         7,  8,  0,  7,  0,  1,  7,  1, 10,  7, 10,  6,  5,  9,  4, -1,
+         3,  0,  4,  3,  4,  5,  3,  5, 10,  3, 10,  6,  3,  6,  7, -1,
+         8,  4,  5,  8,  5, 10,  8, 10,  6,  8,  6,  7, -1, -1, -1, -1,
+         8, 11,  6,  8,  6,  5,  8,  5,  9, -1, -1, -1, -1, -1, -1, -1,
+         3, 11,  6,  3,  6,  5,  3,  5,  9,  3,  9,  0, -1, -1, -1, -1,
+         8, 11,  6,  8,  6,  5,  8,  5,  1,  8,  1,  0, -1, -1, -1, -1,
+         3, 11,  6,  3,  6,  5,  3,  5,  1, -1, -1, -1, -1, -1, -1, -1,
+         8, 11,  6,  8,  6,  5,  8,  5,  9,  1, 10,  2, -1, -1, -1, -1,
+         3, 11,  6,  3,  6,  5,  3,  5,  9,  3,  9,  0,  1, 10,  2, -1,
+         8, 11,  6,  8,  6,  5,  8,  5, 10,  8, 10,  2,  8,  2,  0, -1,
+         3, 11,  6,  3,  6,  5,  3,  5, 10,  3, 10,  2, -1, -1, -1, -1,
+         8,  3,  2,  8,  2,  6,  8,  6,  5,  8,  5,  9, -1, -1, -1, -1,
+         5,  9,  0,  5,  0,  2,  5,  2,  6, -1, -1, -1, -1, -1, -1, -1,
+         8,  3,  2,  8,  2,  6,  8,  6,  5,  8,  5,  1,  8,  1,  0, -1,
+         5,  1,  2,  5,  2,  6, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+         8,  3,  1,  8,  1, 10,  8, 10,  6,  8,  6,  5,  8,  5,  9, -1,
+         6,  5,  9,  6,  9,  0,  6,  0,  1,  6,  1, 10, -1, -1, -1, -1,
+         8,  3,  0,  5, 10,  6, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+         5, 10,  6, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+         7, 11, 10,  7, 10,  5, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+         7, 11, 10,  7, 10,  5,  3,  8,  0, -1, -1, -1, -1, -1, -1, -1,
+         7, 11, 10,  7, 10,  5,  9,  1,  0, -1, -1, -1, -1, -1, -1, -1,
+         7, 11, 10,  7, 10,  5,  3,  8,  9,  3,  9,  1, -1, -1, -1, -1,
+         7, 11,  2,  7,  2,  1,  7,  1,  5, -1, -1, -1, -1, -1, -1, -1,
+         7, 11,  2,  7,  2,  1,  7,  1,  5,  3,  8,  0, -1, -1, -1, -1,
+         7, 11,  2,  7,  2,  0,  7,  0,  9,  7,  9,  5, -1, -1, -1, -1,
+         2,  3,  8,  2,  8,  9,  2,  9,  5,  2,  5,  7,  2,  7, 11, -1,
+         7,  3,  2,  7,  2, 10,  7, 10,  5, -1, -1, -1, -1, -1, -1, -1,
+         7,  8,  0,  7,  0,  2,  7,  2, 10,  7, 10,  5, -1, -1, -1, -1,
+         7,  3,  2,  7,  2, 10,  7, 10,  5,  9,  1,  0, -1, -1, -1, -1,
+         7,  8,  9,  7,  9,  1,  7,  1,  2,  7,  2, 10,  7, 10,  5, -1,
+         7,  3,  1,  7,  1,  5, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+         7,  8,  0,  7,  0,  1,  7,  1,  5, -1, -1, -1, -1, -1, -1, -1,
+         7,  3,  0,  7,  0,  9,  7,  9,  5, -1, -1, -1, -1, -1, -1, -1,
+         7,  8,  9,  7,  9,  5, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+         8, 11, 10,  8, 10,  5,  8,  5,  4, -1, -1, -1, -1, -1, -1, -1,
+         3, 11, 10,  3, 10,  5,  3,  5,  4,  3,  4,  0, -1, -1, -1, -1,
+         8, 11, 10,  8, 10,  5,  8,  5,  4,  9,  1,  0, -1, -1, -1, -1,
+         3, 11, 10,  3, 10,  5,  3,  5,  4,  3,  4,  9,  3,  9,  1, -1,
+         8, 11,  2,  8,  2,  1,  8,  1,  5,  8,  5,  4, -1, -1, -1, -1,
+        11,  2,  1, 11,  1,  5, 11,  5,  4, 11,  4,  0, 11,  0,  3, -1,
+        11,  2,  0, 11,  0,  9, 11,  9,  5, 11,  5,  4, 11,  4,  8, -1,
+         3, 11,  2,  9,  5,  4, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+         8,  3,  2,  8,  2, 10,  8, 10,  5,  8,  5,  4, -1, -1, -1, -1,
+        10,  5,  4, 10,  4,  0, 10,  0,  2, -1, -1, -1, -1, -1, -1, -1,
+         8,  3,  2,  8,  2, 10,  8, 10,  5,  8,  5,  4,  9,  1,  0, -1,
+         4,  9,  1,  4,  1,  2,  4,  2, 10,  4, 10,  5, -1, -1, -1, -1,
+         8,  3,  1,  8,  1,  5,  8,  5,  4, -1, -1, -1, -1, -1, -1, -1,
+         1,  5,  4,  1,  4,  0, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+         3,  0,  9,  3,  9,  5,  3,  5,  4,  3,  4,  8, -1, -1, -1, -1,
+         9,  5,  4, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+         7, 11, 10,  7, 10,  9,  7,  9,  4, -1, -1, -1, -1, -1, -1, -1,
+         7, 11, 10,  7, 10,  9,  7,  9,  4,  3,  8,  0, -1, -1, -1, -1,
+         7, 11, 10,  7, 10,  1,  7,  1,  0,  7,  0,  4, -1, -1, -1, -1,
+        10,  1,  3, 10,  3,  8, 10,  8,  4, 10,  4,  7, 10,  7, 11, -1,
+         7, 11,  2,  7,  2,  1,  7,  1,  9,  7,  9,  4, -1, -1, -1, -1,
+         7, 11,  2,  7,  2,  1,  7,  1,  9,  7,  9,  4,  3,  8,  0, -1,
+         7, 11,  2,  7,  2,  0,  7,  0,  4, -1, -1, -1, -1, -1, -1, -1,
+         2,  3,  8,  2,  8,  4,  2,  4,  7,  2,  7, 11, -1, -1, -1, -1,
+         7,  3,  2,  7,  2, 10,  7, 10,  9,  7,  9,  4, -1, -1, -1, -1,
+         7,  8,  0,  7,  0,  2,  7,  2, 10,  7, 10,  9,  7,  9,  4, -1,
+         7,  3,  2,  7,  2, 10,  7, 10,  1,  7,  1,  0,  7,  0,  4, -1,
+         7,  8,  4, 10,  1,  2, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+         7,  3,  1,  7,  1,  9,  7,  9,  4, -1, -1, -1, -1, -1, -1, -1,
+         7,  8,  0,  7,  0,  1,  7,  1,  9,  7,  9,  4, -1, -1, -1, -1,
+         7,  3,  0,  7,  0,  4, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+         7,  8,  4, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+         8, 11, 10,  8, 10,  9, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+         3, 11, 10,  3, 10,  9,  3,  9,  0, -1, -1, -1, -1, -1, -1, -1,
+         8, 11, 10,  8, 10,  1,  8,  1,  0, -1, -1, -1, -1, -1, -1, -1,
+         3, 11, 10,  3, 10,  1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+         8, 11,  2,  8,  2,  1,  8,  1,  9, -1, -1, -1, -1, -1, -1, -1,
+        11,  2,  1, 11,  1,  9, 11,  9,  0, 11,  0,  3, -1, -1, -1, -1,
+         8, 11,  2,  8,  2,  0, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+         3, 11,  2, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+         8,  3,  2,  8,  2, 10,  8, 10,  9, -1, -1, -1, -1, -1, -1, -1,
+        10,  9,  0, 10,  0,  2, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+         8,  3,  2,  8,  2, 10,  8, 10,  1,  8,  1,  0, -1, -1, -1, -1,
+        10,  1,  2, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+         8,  3,  1,  8,  1,  9, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+         1,  9,  0, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+         8,  3,  0, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1
+]
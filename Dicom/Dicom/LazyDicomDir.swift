@@ -0,0 +1,359 @@
+//
+//  LazyDicomDir.swift
+//  Dicom
+//
+//  Created by hanjongwoo on 10/19/26.
+//
+
+import Foundation
+
+// 디렉터리 레코드 하나에서 값들이 놓인 파일 위치 (값은 읽을 때 해석함)
+private struct DirectoryRecord {
+    let fields: [UInt32: Range<Int>]
+}
+
+// 매핑된 파일 위에서 요소 머리를 읽고 값을 건너뛰는 커서
+private struct RecordCursor {
+    let bytes: UnsafeRawBufferPointer
+    let explicit: Bool
+    var index: Int
+
+    func uint16(at offset: Int) throws -> UInt16 {
+        guard offset >= 0 && offset + 2 <= bytes.count else {
+            throw PDUError.malformed("unexpected end of DICOMDIR")
+        }
+        return UInt16(bytes[offset]) | UInt16(bytes[offset + 1]) << 8
+    }
+
+    func uint32(at offset: Int) throws -> UInt32 {
+        UInt32(try uint16(at: offset)) | UInt32(try uint16(at: offset + 2)) << 16
+    }
+
+    // 요소 머리 하나를 읽고 값의 시작으로 옮김 (아이템/구분자에는 VR이 없음)
+    mutating func header() throws -> (tag: UInt32, length: UInt32) {
+        let tag = UInt32(try uint16(at: index)) << 16 | UInt32(try uint16(at: index + 2))
+        guard explicit && tag >> 16 != 0xFFFE else {
+            defer { index += 8 }
+            return (tag, try uint32(at: index + 4))
+        }
+        let vr = try uint16(at: index + 4).byteSwapped
+        if DataSetReencoder.hasLongLength(vr) {
+            defer { index += 12 }
+            return (tag, try uint32(at: index + 8))
+        }
+        defer { index += 8 }
+        return (tag, UInt32(try uint16(at: index + 6)))
+    }
+
+    // 값을 건너뜀. 길이를 모르는 시퀀스/아이템은 안의 요소를 구분자까지 건너뜀
+    mutating func skip(_ length: UInt32) throws {
+        guard length == DataSetReencoder.undefinedLength else {
+            guard index + Int(length) <= bytes.count else {
+                throw PDUError.malformed("element runs past the end of DICOMDIR")
+            }
+            index += Int(length)
+            return
+        }
+        while true {
+            let (tag, nested) = try header()
+            if tag == LazyDicomDir.sequenceDelimiter || tag == LazyDicomDir.itemDelimiter {
+                return
+            }
+            try skip(nested)
+        }
+    }
+}
+
+// DICOMDIR을 매핑만 해 두고 레코드는 getNextEntry/getFirstChildEntry로 닿을 때 그 자리만 읽는 읽기 전용 DICOMDIR
+// 여는 데는 파일 메타와 레코드 시퀀스 앞의 요소 몇 개만 읽음. 읽은 레코드는 오프셋으로 캐시함
+// StudyInstanceUID 찾기는 처음 부를 때 환자/검사 레코드만 따라가며 색인을 만듦 (시리즈/영상 레코드는 읽지 않음)
+final class LazyDicomDir {
+    static let itemTag: UInt32 = 0xFFFE_E000
+    static let itemDelimiter: UInt32 = 0xFFFE_E00D
+    static let sequenceDelimiter: UInt32 = 0xFFFE_E0DD
+    private static let rootOffsetTag: UInt32 = 0x0004_1200
+    private static let recordSequenceTag: UInt32 = 0x0004_1220
+    static let nextOffsetTag: UInt32 = 0x0004_1400
+    static let childOffsetTag: UInt32 = 0x0004_1420
+    static let recordTypeTag: UInt32 = 0x0004_1430
+    static let fileIDTag: UInt32 = 0x0004_1500
+    static let characterSetTag: UInt32 = 0x0008_0005
+
+    private let data: Data
+    private let explicit: Bool
+    private let firstRootOffset: Int
+    private let lock = NSLock()
+    private var records: [Int: DirectoryRecord] = [:]
+    private var studyIndex: [String: Int]?
+
+    init(url: URL) throws {
+        data = try Data(contentsOf: url, options: .alwaysMapped)
+        let located = try data.withUnsafeBytes { try LazyDicomDir.locateRoot($0) }
+        explicit = located.explicit
+        firstRootOffset = located.firstRootOffset
+    }
+
+    var recordCount: Int {
+        lock.lock()
+        defer { lock.unlock() }
+        return records.count
+    }
+
+    func getFirstRootEntry() throws -> LazyDicomDirEntry? {
+        try entry(at: firstRootOffset)
+    }
+
+    // 최상위(환자) 레코드 목록
+    func rootEntries() throws -> [LazyDicomDirEntry] {
+        try LazyDicomDir.siblings(from: getFirstRootEntry())
+    }
+
+    // StudyInstanceUID로 검사 레코드를 바로 찾음
+    func study(uid: String) throws -> LazyDicomDirEntry? {
+        lock.lock()
+        var index = studyIndex
+        lock.unlock()
+        if index == nil {
+            var built: [String: Int] = [:]
+            for patient in try rootEntries() {
+                for study in try LazyDicomDir.siblings(from: patient.getFirstChildEntry()) where study.getTypeString() == "STUDY" {
+                    built[study.string(.enumStudyInstanceUID_0020_000D)] = study.offset
+                }
+            }
+            lock.lock()
+            studyIndex = built
+            lock.unlock()
+            index = built
+        }
+        return try index?[uid].flatMap { try entry(at: $0) }
+    }
+
+    // 오프셋 0은 "없음"
+    func entry(at offset: Int) throws -> LazyDicomDirEntry? {
+        guard offset > 0 else { return nil }
+        lock.lock()
+        let cached = records[offset]
+        lock.unlock()
+        if let cached {
+            return LazyDicomDirEntry(directory: self, offset: offset, record: cached)
+        }
+        let record = try data.withUnsafeBytes { try LazyDicomDir.readRecord($0, at: offset, explicit: explicit) }
+        lock.lock()
+        records[offset] = record
+        lock.unlock()
+        return LazyDicomDirEntry(directory: self, offset: offset, record: record)
+    }
+
+    fileprivate func value(_ range: Range<Int>) -> ArraySlice<UInt8> {
+        data.withUnsafeBytes { ArraySlice(UnsafeRawBufferPointer(rebasing: $0[range])) }
+    }
+
+    fileprivate func offset(_ range: Range<Int>?) -> Int {
+        guard let range, range.count == 4 else { return 0 }
+        return value(range).reversed().reduce(0) { $0 << 8 | Int($1) }
+    }
+
+    private static func siblings(from first: LazyDicomDirEntry?) throws -> [LazyDicomDirEntry] {
+        var entries: [LazyDicomDirEntry] = []
+        var next = first
+        while let entry = next {
+            entries.append(entry)
+            next = try entry.getNextEntry()
+        }
+        return entries
+    }
+
+    // 파일 메타에서 전송 구문을 보고, 데이터셋 앞부분에서 첫 루트 레코드 오프셋을 찾음
+    private static func locateRoot(_ bytes: UnsafeRawBufferPointer) throws -> (explicit: Bool, firstRootOffset: Int) {
+        guard bytes.count >= 132, bytes[128..<132].elementsEqual("DICM".utf8) else {
+            throw PDUError.malformed("not a DICOM part 10 file")
+        }
+        var cursor = RecordCursor(bytes: bytes, explicit: true, index: 132)
+        var transferSyntax = TransferSyntaxKind.explicitLittleEndian
+        while cursor.index + 4 <= bytes.count, try cursor.uint16(at: cursor.index) == 0x0002 {
+            let (tag, length) = try cursor.header()
+            let start = cursor.index
+            try cursor.skip(length)
+            if tag == 0x0002_0010 {
+                transferSyntax = String.trimmedDicom(ArraySlice(UnsafeRawBufferPointer(rebasing: bytes[start..<cursor.index])))
+            }
+        }
+        guard transferSyntax != DicomheroUidExplicitVRBigEndian_1_2_840_10008_1_2_2 else {
+            throw TranscodeError.unsupportedTransferSyntax(transferSyntax)
+        }
+        let explicit = transferSyntax != TransferSyntaxKind.implicitLittleEndian
+        var dataSet = RecordCursor(bytes: bytes, explicit: explicit, index: cursor.index)
+        var rootOffset = 0
+        while dataSet.index + 4 <= bytes.count {
+            let (tag, length) = try dataSet.header()
+            if tag == rootOffsetTag && length == 4 {
+                rootOffset = Int(try dataSet.uint32(at: dataSet.index))
+            } else if tag == recordSequenceTag {
+                // 루트 오프셋이 비어 있으면 시퀀스의 첫 아이템
+                if rootOffset == 0 && length != 0 && (try dataSet.uint16(at: dataSet.index + 2)) == 0xE000 {
+                    rootOffset = dataSet.index
+                }
+                break
+            }
+            try dataSet.skip(length)
+        }
+        return (explicit, rootOffset)
+    }
+
+    private static func readRecord(_ bytes: UnsafeRawBufferPointer, at offset: Int, explicit: Bool) throws -> DirectoryRecord {
+        var cursor = RecordCursor(bytes: bytes, explicit: explicit, index: offset)
+        let (tag, length) = try cursor.header()
+        guard tag == itemTag else {
+            throw PDUError.malformed("no directory record at offset \(offset)")
+        }
+        let end = length == DataSetReencoder.undefinedLength ? bytes.count : cursor.index + Int(length)
+        var fields: [UInt32: Range<Int>] = [:]
+        while cursor.index < end {
+            let (tag, length) = try cursor.header()
+            if tag == itemDelimiter {
+                break
+            }
+            let start = cursor.index
+            try cursor.skip(length)
+            if length != DataSetReencoder.undefinedLength {
+                fields[tag] = start..<cursor.index
+            }
+        }
+        return DirectoryRecord(fields: fields)
+    }
+}
+
+// LazyDicomDir의 레코드 하나 (DicomheroDicomDirEntry와 같은 이름으로 걸어 다님)
+final class LazyDicomDirEntry {
+    let offset: Int
+    private let directory: LazyDicomDir
+    private let record: DirectoryRecord
+    private let characterSet: SpecificCharacterSet
+
+    fileprivate init(directory: LazyDicomDir, offset: Int, record: DirectoryRecord) {
+        self.directory = directory
+        self.offset = offset
+        self.record = record
+        // 확장 문자 집합을 쓰는 레코드는 자기 Specific Character Set(0008,0005)을 가짐 (없으면 기본 문자 집합)
+        characterSet = record.fields[LazyDicomDir.characterSetTag]
+            .map { SpecificCharacterSet(String.trimmedDicom(directory.value($0))) } ?? .default
+    }
+
+    func getTypeString() -> String {
+        string(LazyDicomDir.recordTypeTag)
+    }
+
+    func getNextEntry() throws -> LazyDicomDirEntry? {
+        try directory.entry(at: directory.offset(record.fields[LazyDicomDir.nextOffsetTag]))
+    }
+
+    func getFirstChildEntry() throws -> LazyDicomDirEntry? {
+        try directory.entry(at: directory.offset(record.fields[LazyDicomDir.childOffsetTag]))
+    }
+
+    // Referenced File ID의 경로 요소들
+    func getFileParts() -> [String] {
+        let value = string(LazyDicomDir.fileIDTag)
+        return value.isEmpty ? [] : value.components(separatedBy: "\\")
+    }
+
+    func string(_ tag: DicomheroTagEnum) -> String {
+        string(tag.rawValue)
+    }
+
+    private func string(_ tag: UInt32) -> String {
+        record.fields[tag].map { String.trimmedDicom(directory.value($0), characterSet: characterSet) } ?? ""
+    }
+}
+
+struct LazyDicomDirMeasurement {
+    var images = 0
+    var patients = 0
+    var fileBytes = 0
+    var eagerPatientListSeconds = 0.0 // 전체를 읽어 DicomheroDicomDir로 연 뒤 환자 목록
+    var lazyPatientListSeconds = 0.0
+    var lazyRecordsRead = 0
+    var studyIndexSeconds = 0.0 // 첫 StudyInstanceUID 찾기 (색인 만들기 포함)
+    var studyLookupSeconds = 0.0 // 그 뒤 찾기 한 번 평균
+}
+
+enum LazyDicomDirBenchmark {
+    // 파일 없이 합성 인스턴스로 큰 DICOMDIR을 만들고, 환자 목록을 띄우기까지의 시간을 기존/지연 방식으로 비교
+    static func run(images: Int = 200_000, imagesPerSeries: Int = 100, seriesPerStudy: Int = 4,
+                    studiesPerPatient: Int = 2, lookups: Int = 10_000) -> LazyDicomDirMeasurement {
+        var measurement = LazyDicomDirMeasurement(images: images)
+        let url = FileManager.default.temporaryDirectory.appendingPathComponent("LazyDicomDir-\(UUID().uuidString)")
+        defer { try? FileManager.default.removeItem(at: url) }
+        let uidRoot = "1.2.826.0.1.3680043.10.1234"
+        let studies = max(1, images / (imagesPerSeries * seriesPerStudy))
+        do {
+            let instances = (0..<images).map { image -> DicomDirInstance in
+                let series = image / imagesPerSeries, study = series / seriesPerStudy, patient = study / studiesPerPatient
+                let values: [DicomheroTagEnum: String] = [
+                    .enumPatientID_0010_0020: String(format: "P%07d", patient),
+                    .enumPatientName_0010_0010: "PATIENT^\(patient)",
+                    .enumStudyInstanceUID_0020_000D: "\(uidRoot).1.\(study)",
+                    .enumStudyDate_0008_0020: "20260101",
+                    .enumSeriesInstanceUID_0020_000E: "\(uidRoot).2.\(series)",
+                    .enumModality_0008_0060: "CT",
+                    .enumSOPInstanceUID_0008_0018: "\(uidRoot).3.\(image)",
+                    .enumSOPClassUID_0008_0016: WellKnownUID.string(for: WellKnownUID.ctImageStorage),
+                    .enumTransferSyntaxUID_0002_0010: TransferSyntaxKind.explicitLittleEndian,
+                    .enumInstanceNumber_0020_0013: String(image % imagesPerSeries + 1)
+                ]
+                return DicomDirInstance(fileParts: [String(format: "P%07d", patient), String(format: "I%07d", image)],
+                                        values: DicomDirBuilder.scannedTags.map { values[$0] ?? "" })
+            }
+            var statistics = DicomDirBuilder.Statistics()
+            let dataSet = try DicomDirBuilder().build(instances, statistics: &statistics)
+            try DicomheroCodecFactory.save(toFile: url.path, dataSet: dataSet, codecType: .dicom)
+            measurement.patients = statistics.patients
+            measurement.fileBytes = (try? url.resourceValues(forKeys: [.fileSizeKey]).fileSize) ?? 0
+        } catch {
+            print("caught: \(error)")
+            return measurement
+        }
+
+        do {
+            var start = DispatchTime.now().uptimeNanoseconds
+            let eagerNames = try autoreleasepool { () -> [String] in
+                let dicomDir = try DicomheroDicomDir(dataSet: try DicomheroCodecFactory.load(fromFile: url.path))
+                var names: [String] = []
+                var next: DicomheroDicomDirEntry? = try dicomDir.getFirstRootEntry()
+                while let entry = next {
+                    names.append(try entry.getEntryDataSet().getString(DicomheroTagId(id: .enumPatientName_0010_0010),
+                                                                       elementNumber: 0, defaultValue: ""))
+                    next = entry.getNextEntry()
+                }
+                return names
+            }
+            measurement.eagerPatientListSeconds = elapsed(since: start)
+
+            start = DispatchTime.now().uptimeNanoseconds
+            let lazy = try LazyDicomDir(url: url)
+            let names = try lazy.rootEntries().map { $0.string(.enumPatientName_0010_0010) }
+            measurement.lazyPatientListSeconds = elapsed(since: start)
+            measurement.lazyRecordsRead = lazy.recordCount
+            guard names == eagerNames else {
+                print("patient list mismatch: \(names.count) != \(eagerNames.count)")
+                return measurement
+            }
+
+            start = DispatchTime.now().uptimeNanoseconds
+            _ = try lazy.study(uid: "\(uidRoot).1.0")
+            measurement.studyIndexSeconds = elapsed(since: start)
+            start = DispatchTime.now().uptimeNanoseconds
+            for _ in 0..<lookups {
+                _ = try lazy.study(uid: "\(uidRoot).1.\(Int.random(in: 0..<studies))")
+            }
+            measurement.studyLookupSeconds = elapsed(since: start) / Double(max(1, lookups))
+        } catch {
+            print("caught: \(error)")
+        }
+        return measurement
+    }
+
+    private static func elapsed(since start: UInt64) -> Double {
+        Double(DispatchTime.now().uptimeNanoseconds - start) / 1e9
+    }
+}
@@ -0,0 +1,290 @@
+//
+//  MemoryGovernor.swift
+//  Dicom
+//
+//  Created by hanjongwoo on 10/19/26.
+//
+
+import Foundation
+import os
+
+// 메모리 사용량을 나눠서 집계하는 하위 시스템
+enum MemorySubsystem: Int, CaseIterable {
+    case datasets       // 파싱된 데이터셋 (파일 크기 기준)
+    case decodedImages  // 디코딩된 DicomheroImage
+    case bitmaps        // 화면 표시용 비트맵
+    case volumes        // 조립된 볼륨, 압축 브릭
+}
+
+// 메모리 사용량과 캐시 상태를 모으고 DicomheroMemoryPool 설정을 한곳에서 관리하며
+// 메모리 부족 알림이 오면 등록된 캐시를 비우는 관리자
+// 앱이 기록하는 할당은 라이브러리 풀을 거치지 않으므로 풀 크기는 그 분포가 아니라 풀 자체의 상태로 정함
+//  - 할당/해제를 기록할 때마다 풀의 미사용 메모리(getUnusedMemorySize)를 표본으로 모으고
+//  - tuningInterval개마다, 풀이 상한에 자주 닿았으면(놓은 버퍼를 담지 못하고 버림) 상한을 늘리고
+//    거의 쓰이지 않았으면 줄이며, 프로세스가 더 쓸 수 있는 메모리의 1/8을 넘지 않게 함
+//  - 위험 단계에서는 풀을 최소로 줄이고, 압박이 풀리면 configurePool로 받은 값으로 되돌림
+// 풀의 블록 크기 분포는 공개 API로 알 수 없으므로 최소 블록 크기는 configurePool 값을 유지함
+final class MemoryGovernor {
+    static let shared = MemoryGovernor()
+
+    // 라이브러리 메모리 풀 기본 설정: 16바이트 이상 블록을 최대 64MB까지 재사용 (작은 태그 버퍼도 재사용됨)
+    static let defaultPoolMinimumBlockSize: UInt32 = 16
+    static let defaultPoolMaximumSize: UInt32 = 64 << 20
+
+    // 외부에 보여 주는 집계 값
+    struct Telemetry {
+        var liveBytes: [MemorySubsystem: Int]
+        var totalLiveBytes: Int
+        var highWaterMark: Int          // totalLiveBytes의 최댓값
+        var recycledBytes: Int          // 풀의 미사용 메모리가 줄어든 양의 합 (풀에 남아 있던 버퍼가 다시 쓰인 양)
+        var cacheHitRate: Double        // 등록된 캐시 전체의 적중률
+        var cachedBytes: Int
+        var poolMinimumBlockSize: UInt32
+        var poolMaximumSize: UInt32
+        var pressureEvents: Int
+        var poolResizes: Int            // 자동 조정으로 풀 상한을 바꾼 횟수
+    }
+
+    // 메모리 부족 시 비울 수 있는 캐시
+    // 클로저는 소유자를 약하게 잡아야 함 (소유자가 사라진 뒤에도 관리자가 호출할 수 있음)
+    struct Cache {
+        let name: String
+        let residentBytes: () -> Int
+        let hitsAndMisses: () -> (hits: Int, misses: Int)
+        let shed: () -> Void
+    }
+
+    private let lock = NSLock()
+    private var liveBytes = [Int](repeating: 0, count: MemorySubsystem.allCases.count)
+    private var highWaterMark = 0
+    private var recycledBytes = 0
+    private var pressureEvents = 0
+    private var lastUnusedPoolSize = 0
+    private var caches: [ObjectIdentifier: Registration] = [:]
+    private var configuredMinimumBlockSize: UInt32 = 0
+    private var configuredMaximumSize: UInt32 = 0
+    private var poolMinimumBlockSize: UInt32 = 0
+    private var poolMaximumSize: UInt32 = 0
+    private var poolShrunk = false
+    private var poolResizes = 0
+    // 조정 구간의 풀 표본
+    private var samples = 0
+    private var saturatedSamples = 0   // 미사용 메모리가 상한의 90% 이상이던 표본 수
+    private var peakUnusedPoolSize = 0
+    private var pressureSource: DispatchSourceMemoryPressure?
+
+    private struct Registration {
+        weak var owner: AnyObject?
+        let cache: Cache
+    }
+
+    // 이 횟수만큼 할당/해제가 기록될 때마다 풀 상한을 다시 정함
+    var tuningInterval = 256
+
+    private init() {
+        let source = DispatchSource.makeMemoryPressureSource(eventMask: [.normal, .warning, .critical], queue: .global(qos: .utility))
+        source.setEventHandler { [weak self] in
+            guard let self else { return }
+            let event = source.data
+            if event.contains(.normal) {
+                self.restorePool()
+            } else {
+                self.handlePressure(critical: event.contains(.critical))
+            }
+        }
+        source.resume()
+        pressureSource = source
+    }
+
+    // 하위 시스템이 메모리를 잡았을 때 호출
+    func recordAllocation(_ bytes: Int, in subsystem: MemorySubsystem) {
+        guard bytes > 0 else { return }
+        let unused = Int(DicomheroMemoryPool.getUnusedMemorySize())
+        lock.lock()
+        liveBytes[subsystem.rawValue] += bytes
+        let total = liveBytes.reduce(0, +)
+        highWaterMark = max(highWaterMark, total)
+        let resize = samplePool(unused)
+        lock.unlock()
+
+        if let resize {
+            applyPoolSize(resize)
+        }
+    }
+
+    // 하위 시스템이 메모리를 놓았을 때 호출
+    func recordRelease(_ bytes: Int, in subsystem: MemorySubsystem) {
+        guard bytes > 0 else { return }
+        let unused = Int(DicomheroMemoryPool.getUnusedMemorySize())
+        lock.lock()
+        liveBytes[subsystem.rawValue] -= bytes
+        let resize = samplePool(unused)
+        lock.unlock()
+
+        if let resize {
+            applyPoolSize(resize)
+        }
+    }
+
+    // 잠금 안에서 호출: 풀 표본을 더하고, 조정할 때가 되어 상한을 바꿔야 하면 새 상한을 돌려줌
+    private func samplePool(_ unused: Int) -> UInt32? {
+        // 미사용 메모리가 줄었다면 풀에 남아 있던 버퍼가 다시 쓰인 것 (풀을 비우거나 줄인 뒤에는 기준을 다시 잡음)
+        if unused < lastUnusedPoolSize {
+            recycledBytes += lastUnusedPoolSize - unused
+        }
+        lastUnusedPoolSize = unused
+        peakUnusedPoolSize = max(peakUnusedPoolSize, unused)
+        if poolMaximumSize > 0 && unused >= Int(poolMaximumSize) / 10 * 9 {
+            saturatedSamples += 1
+        }
+        samples += 1
+        guard samples >= tuningInterval else { return nil }
+        defer {
+            samples = 0
+            saturatedSamples = 0
+            peakUnusedPoolSize = 0
+        }
+        guard !poolShrunk && configuredMaximumSize > 0 else { return nil }
+
+        let ceiling = UInt64(max(os_proc_available_memory() / 8, 0))
+        let floor = UInt64(max(configuredMaximumSize / 4, 1 << 20))
+        var target = UInt64(poolMaximumSize)
+        if saturatedSamples * 4 >= samples {
+            target *= 2
+        } else if peakUnusedPoolSize * 4 < Int(poolMaximumSize) {
+            target /= 2
+        }
+        target = max(floor, min(target, ceiling, UInt64(UInt32.max)))
+        let size = UInt32(target)
+        guard size != poolMaximumSize else { return nil }
+        poolMaximumSize = size
+        poolResizes += 1
+        return size
+    }
+
+    // 풀 상한을 바꾸고 미사용 메모리 기준을 다시 잡음 (줄어서 버려진 버퍼를 재사용으로 세지 않음)
+    private func applyPoolSize(_ maximumSize: UInt32) {
+        lock.lock()
+        let minimumBlockSize = poolMinimumBlockSize
+        lock.unlock()
+        DicomheroMemoryPool.setMemoryPoolSize(minimumBlockSize, maxSize: maximumSize)
+        resetPoolBaseline()
+    }
+
+    private func resetPoolBaseline() {
+        let unused = Int(DicomheroMemoryPool.getUnusedMemorySize())
+        lock.lock()
+        lastUnusedPoolSize = unused
+        lock.unlock()
+    }
+
+    // body가 실행되는 동안만 bytes를 사용 중으로 기록
+    func track<Result>(_ bytes: Int, in subsystem: MemorySubsystem, _ body: () throws -> Result) rethrows -> Result {
+        recordAllocation(bytes, in: subsystem)
+        defer { recordRelease(bytes, in: subsystem) }
+        return try body()
+    }
+
+    // 메모리 부족 시 비울 캐시를 등록 (owner는 약하게 잡으며, 해제될 때 unregister 하면 됨)
+    func register(_ cache: Cache, owner: AnyObject) {
+        lock.lock()
+        caches[ObjectIdentifier(owner)] = Registration(owner: owner, cache: cache)
+        lock.unlock()
+    }
+
+    func unregister(owner: AnyObject) {
+        lock.lock()
+        caches[ObjectIdentifier(owner)] = nil
+        lock.unlock()
+    }
+
+    // 살아 있는 캐시를 소유자와 함께 잠금 안에서 복사 (소유자를 잡아 두므로 호출 도중 해제되지 않음)
+    private func registeredCaches() -> [(owner: AnyObject, cache: Cache)] {
+        caches = caches.filter { $0.value.owner != nil }
+        return caches.values.compactMap { registration in
+            registration.owner.map { ($0, registration.cache) }
+        }
+    }
+
+    var telemetry: Telemetry {
+        lock.lock()
+        let registered = registeredCaches()
+        var telemetry = Telemetry(liveBytes: [:], totalLiveBytes: liveBytes.reduce(0, +),
+                                  highWaterMark: highWaterMark, recycledBytes: recycledBytes,
+                                  cacheHitRate: 0, cachedBytes: 0,
+                                  poolMinimumBlockSize: poolMinimumBlockSize, poolMaximumSize: poolMaximumSize,
+                                  pressureEvents: pressureEvents, poolResizes: poolResizes)
+        for subsystem in MemorySubsystem.allCases {
+            telemetry.liveBytes[subsystem] = liveBytes[subsystem.rawValue]
+        }
+        lock.unlock()
+
+        // 캐시는 자체 잠금을 사용하므로 관리자 잠금 밖에서 읽음
+        var hits = 0, misses = 0
+        for (_, cache) in registered {
+            let counts = cache.hitsAndMisses()
+            hits += counts.hits
+            misses += counts.misses
+            telemetry.cachedBytes += cache.residentBytes()
+        }
+        telemetry.cacheHitRate = hits + misses > 0 ? Double(hits) / Double(hits + misses) : 0
+        return telemetry
+    }
+
+    // 라이브러리 메모리 풀 설정을 정함 (앱 시작 시 한 번)
+    // 위험 단계에서 줄인 뒤 압박이 풀리면 이 값으로 되돌림
+    func configurePool(minimumBlockSize: UInt32, maximumSize: UInt32) {
+        lock.lock()
+        configuredMinimumBlockSize = minimumBlockSize
+        configuredMaximumSize = maximumSize
+        let apply = !poolShrunk
+        if apply {
+            poolMinimumBlockSize = minimumBlockSize
+            poolMaximumSize = maximumSize
+        }
+        lock.unlock()
+
+        if apply {
+            DicomheroMemoryPool.setMemoryPoolSize(minimumBlockSize, maxSize: maximumSize)
+            resetPoolBaseline()
+        }
+    }
+
+    // 압박이 풀리면 위험 단계에서 줄였던 풀 설정을 되돌림
+    func restorePool() {
+        lock.lock()
+        guard poolShrunk else {
+            lock.unlock()
+            return
+        }
+        poolShrunk = false
+        poolMinimumBlockSize = configuredMinimumBlockSize
+        poolMaximumSize = configuredMaximumSize
+        let (minimumBlockSize, maximumSize) = (poolMinimumBlockSize, poolMaximumSize)
+        lock.unlock()
+
+        DicomheroMemoryPool.setMemoryPoolSize(minimumBlockSize, maxSize: maximumSize)
+        resetPoolBaseline()
+    }
+
+    // 메모리 부족 알림 처리: 캐시를 비우고 풀에 남은 메모리를 돌려줌
+    // 경고 단계에서는 다음 자동 조정이 남은 메모리에 맞춰 상한을 줄이고
+    // 위험 단계에서는 풀이 더 이상 메모리를 붙잡지 않도록 크기를 최소로 줄이고, restorePool까지 유지
+    func handlePressure(critical: Bool) {
+        lock.lock()
+        pressureEvents += 1
+        let registered = registeredCaches()
+        if critical {
+            poolShrunk = true
+            poolMaximumSize = 0
+        }
+        lock.unlock()
+
+        registered.forEach { $0.cache.shed() }
+        if critical {
+            DicomheroMemoryPool.setMemoryPoolSize(UInt32.max, maxSize: 0)
+        }
+        DicomheroMemoryPool.flush()
+        resetPoolBaseline()
+    }
+}
@@ -0,0 +1,600 @@
+//
+//  MetadataIndex.swift
+//  Dicom
+//
+//  Created by hanjongwoo on 10/19/26.
+//
+
+import Foundation
+import Darwin
+
+enum MetadataIndexError: Error {
+    case system(String, Int32)
+    case corrupt(String) // 매니페스트와 열 파일 크기가 맞지 않음
+}
+
+// 색인 디렉터리의 열 (열마다 파일 하나, 행마다 4바이트: 문자열은 사전 코드, 숫자는 Int32)
+enum MetadataColumn: String, CaseIterable {
+    case patientID, patientName, studyUID, studyDate, accessionNumber, seriesUID, modality, seriesNumber
+    case instanceUID, sopClassUID, instanceNumber, path
+
+    var isString: Bool {
+        switch self {
+        case .studyDate, .seriesNumber, .instanceNumber:
+            return false
+        default:
+            return true
+        }
+    }
+
+    var fileName: String { rawValue + (isString ? ".u32" : ".i32") }
+
+    // 문자열 열에 실제로 나오는 사전 코드 (정렬, 중복 없음)
+    var codesFileName: String { rawValue + ".codes" }
+
+    fileprivate var position: Int { MetadataColumn.allCases.firstIndex(of: self)! }
+}
+
+// 읽기 전용으로 매핑한 파일 하나 (객체가 살아 있는 동안 bytes가 유효함)
+final class MappedFile {
+    let bytes: UnsafeRawBufferPointer
+
+    init(url: URL) throws {
+        let fd = open(url.path, O_RDONLY)
+        guard fd >= 0 else {
+            throw MetadataIndexError.system("open \(url.lastPathComponent)", errno)
+        }
+        defer { close(fd) }
+        var status = stat()
+        guard fstat(fd, &status) == 0 else {
+            throw MetadataIndexError.system("fstat", errno)
+        }
+        let size = Int(status.st_size)
+        guard size > 0 else {
+            bytes = UnsafeRawBufferPointer(start: nil, count: 0)
+            return
+        }
+        guard let address = mmap(nil, size, PROT_READ, MAP_PRIVATE, fd, 0), address != MAP_FAILED else {
+            throw MetadataIndexError.system("mmap", errno)
+        }
+        bytes = UnsafeRawBufferPointer(start: address, count: size)
+    }
+
+    deinit {
+        if let address = bytes.baseAddress {
+            munmap(UnsafeMutableRawPointer(mutating: address), bytes.count)
+        }
+    }
+
+    var words: UnsafeBufferPointer<UInt32> { bytes.bindMemory(to: UInt32.self) }
+}
+
+// 가져온 파일마다 고른 태그 값을 열 파일로 저장해 두는 로컬 색인 (여는 데 파싱이 없음)
+// 문자열은 바이트 순으로 정렬된 사전에 한 번씩만 두고 열에는 코드만 씀: 코드 순서 = 문자열 순서라서
+// 정확히 일치는 이분 탐색 한 번, 와일드카드는 접두어의 코드 범위 안에서만 비교함
+// 사전은 모든 열이 함께 쓰므로, 와일드카드는 열마다 저장한 코드 목록에서 범위 안의 것만 비교함 (UID/경로까지 훑지 않음)
+// 파일 구성: manifest(매직, 버전, 행 수, 사전 크기), strings.dat(문자열 바이트), strings.idx(시작 위치), 열 파일들,
+//           문자열 열마다 .codes(열에 나오는 코드 목록)
+final class MetadataIndex {
+    static let magic: UInt32 = 0x5849_4D44 // "DMIX"
+    static let version: UInt32 = 2
+    static let manifestName = "manifest"
+    static let stringBytesName = "strings.dat"
+    static let stringOffsetsName = "strings.idx"
+
+    let rowCount: Int
+    let stringCount: Int
+    private let columnFiles: [MappedFile]
+    private let codeFiles: [MappedFile?]
+    private let stringBytes: MappedFile
+    private let stringOffsets: MappedFile
+
+    init(directory: URL) throws {
+        let manifestFile = try MappedFile(url: directory.appendingPathComponent(MetadataIndex.manifestName))
+        let manifest = withExtendedLifetime(manifestFile) { Array(manifestFile.words) }
+        guard manifest.count == 4 && manifest[0] == MetadataIndex.magic && manifest[1] == MetadataIndex.version else {
+            throw MetadataIndexError.corrupt(MetadataIndex.manifestName)
+        }
+        rowCount = Int(manifest[2])
+        stringCount = Int(manifest[3])
+        columnFiles = try MetadataColumn.allCases.map { try MappedFile(url: directory.appendingPathComponent($0.fileName)) }
+        codeFiles = try MetadataColumn.allCases.map {
+            $0.isString ? try MappedFile(url: directory.appendingPathComponent($0.codesFileName)) : nil
+        }
+        stringBytes = try MappedFile(url: directory.appendingPathComponent(MetadataIndex.stringBytesName))
+        stringOffsets = try MappedFile(url: directory.appendingPathComponent(MetadataIndex.stringOffsetsName))
+        if let column = MetadataColumn.allCases.first(where: { columnFiles[$0.position].bytes.count != rowCount * 4 }) {
+            throw MetadataIndexError.corrupt(column.fileName)
+        }
+        if let column = MetadataColumn.allCases.first(where: { codeFiles[$0.position]?.words.last.map { $0 >= stringCount } ?? false }) {
+            throw MetadataIndexError.corrupt(column.codesFileName)
+        }
+        guard stringOffsets.words.count == stringCount + 1 && Int(stringOffsets.words[stringCount]) == stringBytes.bytes.count else {
+            throw MetadataIndexError.corrupt(MetadataIndex.stringOffsetsName)
+        }
+    }
+
+    func column(_ column: MetadataColumn) -> UnsafeBufferPointer<UInt32> {
+        columnFiles[column.position].words
+    }
+
+    // 사전의 바이트는 UTF-8 (가져올 때 파일의 Specific Character Set으로 이미 변환해 둠)
+    func string(_ code: UInt32) -> String {
+        String(decoding: bytes(of: code), as: UTF8.self)
+    }
+
+    func value(_ column: MetadataColumn, row: Int) -> String {
+        let raw = self.column(column)[row]
+        if column.isString {
+            return string(raw)
+        }
+        let number = Int32(bitPattern: raw)
+        return number == 0 ? "" : String(number)
+    }
+
+    func path(row: Int) -> String {
+        value(.path, row: row)
+    }
+
+    func entry(row: Int) -> StudyCatalogue.Entry {
+        func number(_ column: MetadataColumn) -> Int32 { Int32(bitPattern: self.column(column)[row]) }
+        return StudyCatalogue.Entry(
+            patientID: value(.patientID, row: row), patientName: value(.patientName, row: row),
+            studyUID: value(.studyUID, row: row), studyDate: value(.studyDate, row: row),
+            accessionNumber: value(.accessionNumber, row: row), seriesUID: value(.seriesUID, row: row),
+            modality: value(.modality, row: row), seriesNumber: number(.seriesNumber),
+            instanceUID: value(.instanceUID, row: row), sopClassUID: value(.sopClassUID, row: row),
+            instanceNumber: number(.instanceNumber))
+    }
+
+    // 사전에 있으면 그 코드
+    func code(for value: String) -> UInt32? {
+        var value = value
+        return value.withUTF8 { raw in
+            let target = UnsafeRawBufferPointer(raw)
+            let code = partition(UInt32(stringCount)) { compare($0, target) < 0 }
+            return code < stringCount && compare(code, target) == 0 ? code : nil
+        }
+    }
+
+    // 조건에 맞는 행 번호 (열을 나눠 병렬로 훑음). 검사/시리즈/환자 단계면 그 키마다 첫 행만 남김
+    func filter(_ query: CatalogueQuery) -> [Int32] {
+        guard rowCount > 0 else { return [] }
+        var predicates: [(column: UnsafeBufferPointer<UInt32>, codes: CodeFilter)] = []
+        let matchers: [(MetadataColumn, ValueMatcher?)] = [
+            (.patientID, query.patientID), (.patientName, query.patientName),
+            (.accessionNumber, query.accessionNumber), (.modality, query.modality),
+            (.studyUID, query.studyUID.map { ValueMatcher.exact($0) }), (.seriesUID, query.seriesUID.map { ValueMatcher.exact($0) }),
+            (.instanceUID, query.instanceUID.map { ValueMatcher.exact($0) })
+        ]
+        for case let (column, matcher?) in matchers {
+            let codes = filter(for: matcher, in: column)
+            guard !codes.range.isEmpty else { return [] }
+            predicates.append((column: self.column(column), codes: codes))
+        }
+        predicates.sort { $0.codes.range.count < $1.codes.range.count } // 좁은 조건부터
+
+        let conditions = predicates, dates = query.studyDates, dateColumn = column(.studyDate)
+        let chunks = max(1, min(rowCount / 4096, ProcessInfo.processInfo.activeProcessorCount * 4))
+        let chunkSize = (rowCount + chunks - 1) / chunks
+        var parts = [[Int32]](repeating: [], count: chunks)
+        let lock = NSLock()
+        DispatchQueue.concurrentPerform(iterations: chunks) { chunk in
+            var local: [Int32] = []
+            for row in min(rowCount, chunk * chunkSize)..<min(rowCount, (chunk + 1) * chunkSize) {
+                if let dates, !dates.contains(Int32(bitPattern: dateColumn[row])) {
+                    continue
+                }
+                if conditions.allSatisfy({ $0.codes.matches($0.column[row]) }) {
+                    local.append(Int32(row))
+                }
+            }
+            lock.lock()
+            parts[chunk] = local
+            lock.unlock()
+        }
+        let rows = Array(parts.joined())
+        guard let key = query.level.keyColumn else {
+            return rows
+        }
+        let keys = column(key)
+        var seen = Set<UInt32>()
+        return rows.filter { seen.insert(keys[Int($0)]).inserted }
+    }
+
+    // 받아들일 사전 코드: 범위 안이면서 accepted(와일드카드에서 미리 걸러 둔 표)가 참인 것
+    private struct CodeFilter {
+        let range: Range<UInt32>
+        let accepted: [Bool]?
+
+        func matches(_ code: UInt32) -> Bool {
+            range.contains(code) && (accepted.map { $0[Int(code - range.lowerBound)] } ?? true)
+        }
+    }
+
+    private func filter(for matcher: ValueMatcher, in column: MetadataColumn) -> CodeFilter {
+        switch matcher {
+        case .exact(let value):
+            return CodeFilter(range: code(for: value).map { $0..<$0 + 1 } ?? 0..<0, accepted: nil)
+        case .wildcard(let prefix, _):
+            var prefix = prefix
+            let range = prefix.withUTF8 { raw -> Range<UInt32> in
+                let target = UnsafeRawBufferPointer(raw)
+                let lower = partition(UInt32(stringCount)) { compare($0, target) < 0 }
+                let upper = partition(UInt32(stringCount)) { compare($0, target) < 0 || hasPrefix($0, target) }
+                return lower..<upper
+            }
+            // 이 열에 나오는 코드 중 접두어 범위 안의 것만 문자열로 바꿔 비교
+            let present = codeFiles[column.position]?.words ?? UnsafeBufferPointer(start: nil, count: 0)
+            let lower = Int(partition(UInt32(present.count)) { present[Int($0)] < range.lowerBound })
+            let upper = Int(partition(UInt32(present.count)) { present[Int($0)] < range.upperBound })
+            let matched = present[lower..<upper].filter { matcher.matches(string($0)) }
+            guard let first = matched.first, let last = matched.last else {
+                return CodeFilter(range: 0..<0, accepted: nil)
+            }
+            var accepted = [Bool](repeating: false, count: Int(last - first) + 1)
+            matched.forEach { accepted[Int($0 - first)] = true }
+            return CodeFilter(range: first..<last + 1, accepted: accepted)
+        }
+    }
+
+    private func bytes(of code: UInt32) -> UnsafeRawBufferPointer {
+        let offsets = stringOffsets.words
+        return UnsafeRawBufferPointer(rebasing: stringBytes.bytes[Int(offsets[Int(code)])..<Int(offsets[Int(code) + 1])])
+    }
+
+    private func compare(_ code: UInt32, _ value: UnsafeRawBufferPointer) -> Int {
+        let stored = bytes(of: code)
+        let common = min(stored.count, value.count)
+        let order = common == 0 ? 0 : Int(memcmp(stored.baseAddress!, value.baseAddress!, common))
+        return order != 0 ? order : stored.count - value.count
+    }
+
+    private func hasPrefix(_ code: UInt32, _ prefix: UnsafeRawBufferPointer) -> Bool {
+        let stored = bytes(of: code)
+        return stored.count >= prefix.count && (prefix.isEmpty || memcmp(stored.baseAddress!, prefix.baseAddress!, prefix.count) == 0)
+    }
+
+    // 0..<count에서 precedes가 처음 false가 되는 위치 (정렬된 사전이나 코드 목록)
+    private func partition(_ count: UInt32, _ precedes: (UInt32) -> Bool) -> UInt32 {
+        var low: UInt32 = 0, high = count
+        while low < high {
+            let middle = low + (high - low) / 2
+            if precedes(middle) {
+                low = middle + 1
+            } else {
+                high = middle
+            }
+        }
+        return low
+    }
+}
+
+private extension QueryLevel {
+    var keyColumn: MetadataColumn? {
+        switch self {
+        case .patient: return .patientID
+        case .study: return .studyUID
+        case .series: return .seriesUID
+        case .image: return nil
+        }
+    }
+}
+
+// 가져오기 쪽: 행을 메모리에 모았다가 write(to:)로 색인 디렉터리를 새로 씀
+// 기존 색인에 더할 때는 init(appendingTo:)로 사전과 열을 그대로 옮겨 온 뒤 새 파일만 읽음
+final class MetadataIndexWriter {
+    private var codes: [String: UInt32] = [:]
+    private var strings: [String] = []
+    private var columns = [[UInt32]](repeating: [], count: MetadataColumn.allCases.count)
+    private var instances = Set<UInt32>()
+
+    var rowCount: Int { columns[0].count }
+
+    init() {}
+
+    init(appendingTo index: MetadataIndex) {
+        strings = (0..<index.stringCount).map { index.string(UInt32($0)) }
+        codes = Dictionary(uniqueKeysWithValues: strings.enumerated().map { ($0.element, UInt32($0.offset)) })
+        columns = MetadataColumn.allCases.map { Array(index.column($0)) }
+        instances = Set(columns[MetadataColumn.instanceUID.position])
+    }
+
+    func contains(instanceUID: String) -> Bool {
+        codes[instanceUID].map { instances.contains($0) } ?? false
+    }
+
+    // 이미 있는 SOP Instance UID면 넣지 않음
+    @discardableResult
+    func append(_ entry: StudyCatalogue.Entry, path: String) -> Bool {
+        let instance = code(entry.instanceUID)
+        guard instances.insert(instance).inserted else {
+            return false
+        }
+        // MetadataColumn.allCases 순서
+        let row: [UInt32] = [
+            code(entry.patientID), code(entry.patientName), code(entry.studyUID),
+            UInt32(bitPattern: Int32(entry.studyDate) ?? 0), code(entry.accessionNumber), code(entry.seriesUID),
+            code(entry.modality), UInt32(bitPattern: entry.seriesNumber), instance, code(entry.sopClassUID),
+            UInt32(bitPattern: entry.instanceNumber), code(path)
+        ]
+        for (position, value) in row.enumerated() {
+            columns[position].append(value)
+        }
+        return true
+    }
+
+    // 파일들을 병렬로 헤더만 읽어 넣음. 새로 넣은 행 수를 돌려줌
+    // place가 있으면 새로 넣을 파일마다 불러 색인에 기록할 경로를 받음 (nil을 돌려주면 그 파일은 넣지 않음)
+    func importFiles(_ urls: [URL], readers: Int = ProcessInfo.processInfo.activeProcessorCount,
+                     place: ((URL, StudyCatalogue.Entry) -> String?)? = nil) -> Int {
+        let readers = max(1, min(readers, urls.count))
+        var parts = [[(StudyCatalogue.Entry, URL)]](repeating: [], count: readers)
+        let lock = NSLock()
+        DispatchQueue.concurrentPerform(iterations: readers) { reader in
+            var local: [(StudyCatalogue.Entry, URL)] = []
+            for index in stride(from: reader, to: urls.count, by: readers) {
+                autoreleasepool {
+                    do {
+                        let dataSet = try DicomheroCodecFactory.load(fromFileMaxSize: urls[index].path, maxBufferSize: 2048)
+                        local.append((StudyCatalogue.entry(dataSet: dataSet), urls[index]))
+                    } catch {
+                        print("caught: \(error)")
+                    }
+                }
+            }
+            lock.lock()
+            parts[reader] = local
+            lock.unlock()
+        }
+        return parts.joined().reduce(0) { count, part in
+            let (entry, url) = part
+            guard !contains(instanceUID: entry.instanceUID) else {
+                return count
+            }
+            let path: String?
+            if let place {
+                path = place(url, entry)
+            } else {
+                path = url.path
+            }
+            guard let path else {
+                return count
+            }
+            return count + (append(entry, path: path) ? 1 : 0)
+        }
+    }
+
+    // 사전을 바이트 순으로 정렬해 코드를 다시 매긴 뒤 열 파일들을 쓰고, 매니페스트는 마지막에 씀
+    func write(to directory: URL) throws {
+        try FileManager.default.createDirectory(at: directory, withIntermediateDirectories: true)
+        let order = strings.indices.sorted { strings[$0].utf8.lexicographicallyPrecedes(strings[$1].utf8) }
+        var remap = [UInt32](repeating: 0, count: strings.count)
+        var bytes: [UInt8] = []
+        var offsets: [UInt32] = [0]
+        offsets.reserveCapacity(strings.count + 1)
+        for (rank, code) in order.enumerated() {
+            remap[code] = UInt32(rank)
+            bytes.append(contentsOf: strings[code].utf8)
+            offsets.append(UInt32(bytes.count))
+        }
+        for column in MetadataColumn.allCases {
+            guard column.isString else {
+                try MetadataIndexWriter.write(columns[column.position], to: directory.appendingPathComponent(column.fileName))
+                continue
+            }
+            let values = columns[column.position].map { remap[Int($0)] }
+            try MetadataIndexWriter.write(values, to: directory.appendingPathComponent(column.fileName))
+            try MetadataIndexWriter.write(Array(Set(values)).sorted(), to: directory.appendingPathComponent(column.codesFileName))
+        }
+        try MetadataIndexWriter.write(bytes, to: directory.appendingPathComponent(MetadataIndex.stringBytesName))
+        try MetadataIndexWriter.write(offsets, to: directory.appendingPathComponent(MetadataIndex.stringOffsetsName))
+        try MetadataIndexWriter.write([MetadataIndex.magic, MetadataIndex.version, UInt32(rowCount), UInt32(strings.count)],
+                                      to: directory.appendingPathComponent(MetadataIndex.manifestName))
+    }
+
+    private func code(_ value: String) -> UInt32 {
+        if let existing = codes[value] {
+            return existing
+        }
+        let code = UInt32(strings.count)
+        strings.append(value)
+        codes[value] = code
+        return code
+    }
+
+    private static func write<Value>(_ values: [Value], to url: URL) throws {
+        try values.withUnsafeBytes { try Data($0).write(to: url, options: .atomic) }
+    }
+}
+
+// 앱의 로컬 색인: 가져온 파일의 헤더만 읽어 색인에 더하고, 검사 목록은 파일을 다시 열지 않고 색인에서 만듦
+// 새로 쓸 때 파일을 원자적으로 바꾸므로 열려 있던 색인의 매핑은 예전 파일을 그대로 가리킴
+// 문서 선택기가 준 경로는 보안 범위 접근이 끝나면 다시 열 수 없으므로, 새 파일은 앱 컨테이너(filesDirectory)에
+// 복사하고 색인의 경로 열에는 사본의 경로를 씀
+final class MetadataLibrary {
+    static let shared = MetadataLibrary(directory: FileManager.default.urls(for: .applicationSupportDirectory, in: .userDomainMask)[0]
+        .appendingPathComponent("MetadataIndex"))
+
+    let directory: URL
+    let filesDirectory: URL
+    private let lock = NSLock()       // index 교체만 보호 (studies가 긴 가져오기를 기다리지 않게 함)
+    private let importLock = NSLock() // 가져오기와 색인 쓰기를 한 번에 하나씩
+    private var index: MetadataIndex?
+
+    init(directory: URL) {
+        self.directory = directory
+        filesDirectory = directory.appendingPathComponent("Files")
+        index = try? MetadataIndex(directory: directory)
+    }
+
+    // 새로 넣은 행 수를 돌려줌 (이미 색인된 SOP Instance UID는 건너뜀)
+    // 호출하는 쪽은 돌아올 때까지 urls의 보안 범위 접근을 유지해야 함 (복사가 끝난 뒤 놓아도 됨)
+    @discardableResult
+    func importFiles(_ urls: [URL]) -> Int {
+        importLock.lock()
+        defer { importLock.unlock() }
+        lock.lock()
+        let current = index
+        lock.unlock()
+        do {
+            try FileManager.default.createDirectory(at: filesDirectory, withIntermediateDirectories: true)
+        } catch {
+            print("caught: \(error)")
+            return 0
+        }
+        let writer = current.map { MetadataIndexWriter(appendingTo: $0) } ?? MetadataIndexWriter()
+        let added = writer.importFiles(urls) { url, entry in self.copy(url, instanceUID: entry.instanceUID) }
+        guard added > 0 else {
+            return 0
+        }
+        do {
+            try writer.write(to: directory)
+            let updated = try MetadataIndex(directory: directory)
+            lock.lock()
+            index = updated
+            lock.unlock()
+        } catch {
+            print("caught: \(error)")
+        }
+        return added
+    }
+
+    // 파일을 <SOP Instance UID>.dcm으로 복사하고 사본의 경로를 돌려줌 (지난번 가져오기에서 남은 사본이 있으면 그대로 씀)
+    private func copy(_ url: URL, instanceUID: String) -> String? {
+        let name = instanceUID.isEmpty || instanceUID.contains("/") ? UUID().uuidString : instanceUID
+        let destination = filesDirectory.appendingPathComponent(name + ".dcm")
+        do {
+            if !FileManager.default.fileExists(atPath: destination.path) {
+                try FileManager.default.copyItem(at: url, to: destination)
+            }
+            return destination.path
+        } catch {
+            print("caught: \(error)")
+            return nil
+        }
+    }
+
+    // 검사마다 첫 인스턴스의 항목 (검사 날짜가 최근인 것부터)
+    func studies(_ query: CatalogueQuery = CatalogueQuery(level: .study)) -> [StudyCatalogue.Entry] {
+        lock.lock()
+        let index = self.index
+        lock.unlock()
+        guard let index else {
+            return []
+        }
+        var query = query
+        query.level = .study
+        return index.filter(query).map { index.entry(row: Int($0)) }.sorted { $0.studyDate > $1.studyDate }
+    }
+}
+
+struct MetadataIndexMeasurement {
+    var rows = 0
+    var strings = 0
+    var fileBytes = 0
+    var writeSeconds = 0.0
+    var openMilliseconds = 0.0
+    var queries: [CatalogueQueryStatistics] = []
+}
+
+enum MetadataIndexBenchmark {
+    // CatalogueBenchmark와 같은 합성 인스턴스 rows개로 색인을 쓰고, 다시 여는 시간과 질의별 전체 훑기 시간을 잼
+    static func run(rows: Int = 1_000_000, queriesPerKind: Int = 50) -> MetadataIndexMeasurement {
+        var measurement = MetadataIndexMeasurement(rows: rows)
+        let directory = FileManager.default.temporaryDirectory.appendingPathComponent("MetadataIndex-\(UUID().uuidString)")
+        defer { try? FileManager.default.removeItem(at: directory) }
+        let seriesPerStudy = 4, instancesPerSeries = 25
+        let studies = max(1, rows / (seriesPerStudy * instancesPerSeries))
+        let surnames = ["KIM", "LEE", "PARK", "CHOI", "JUNG", "KANG", "CHO", "YOON", "JANG", "LIM"]
+        let modalities = ["CT", "MR", "CR", "US"]
+        let root = "1.2.826.0.1.3680043.10.1234"
+
+        let writer = MetadataIndexWriter()
+        for study in 0..<studies {
+            let patient = study / 3
+            var entry = StudyCatalogue.Entry()
+            entry.patientID = String(format: "P%07d", patient)
+            entry.patientName = "\(surnames[patient % surnames.count])^\(patient)"
+            entry.studyUID = "\(root).1.\(study)"
+            entry.studyDate = String(20150101 + (study % 10) * 10000 + (study % 12) * 100 + study % 28)
+            entry.accessionNumber = "A\(study)"
+            for series in 0..<seriesPerStudy {
+                entry.seriesUID = "\(root).2.\(study).\(series)"
+                entry.modality = modalities[(study + series) % modalities.count]
+                entry.seriesNumber = Int32(series + 1)
+                for instance in 0..<instancesPerSeries {
+                    entry.instanceUID = "\(root).3.\(study).\(series).\(instance)"
+                    entry.sopClassUID = WellKnownUID.string(for: WellKnownUID.ctImageStorage)
+                    entry.instanceNumber = Int32(instance + 1)
+                    writer.append(entry, path: "/studies/\(study)/\(series)/\(instance).dcm")
+                }
+            }
+        }
+        var start = DispatchTime.now().uptimeNanoseconds
+        do {
+            try writer.write(to: directory)
+        } catch {
+            print("caught: \(error)")
+            return measurement
+        }
+        measurement.writeSeconds = Double(DispatchTime.now().uptimeNanoseconds - start) / 1e9
+        measurement.fileBytes = ((try? FileManager.default.contentsOfDirectory(at: directory, includingPropertiesForKeys: [.fileSizeKey])) ?? [])
+            .reduce(0) { $0 + ((try? $1.resourceValues(forKeys: [.fileSizeKey]).fileSize) ?? 0) }
+
+        start = DispatchTime.now().uptimeNanoseconds
+        let index: MetadataIndex
+        do {
+            index = try MetadataIndex(directory: directory)
+        } catch {
+            print("caught: \(error)")
+            return measurement
+        }
+        measurement.openMilliseconds = Double(DispatchTime.now().uptimeNanoseconds - start) / 1e6
+        measurement.rows = index.rowCount
+        measurement.strings = index.stringCount
+
+        let kinds: [(String, () -> CatalogueQuery)] = [
+            ("studies by date range (1 month) + modality", {
+                var query = CatalogueQuery(level: .study)
+                let year = 2015 + Int.random(in: 0..<10)
+                query.studyDates = CatalogueQuery.dateRange("\(year)0301-\(year)0331")
+                query.modality = ValueMatcher("MR")
+                return query
+            }),
+            ("studies by PatientName wildcard", {
+                var query = CatalogueQuery(level: .study)
+                query.patientName = ValueMatcher("\(surnames[Int.random(in: 0..<surnames.count)])^1*7")
+                return query
+            }),
+            ("images of a study", {
+                var query = CatalogueQuery(level: .image)
+                query.studyUID = "\(root).1.\(Int.random(in: 0..<studies))"
+                return query
+            }),
+            ("series by modality", {
+                var query = CatalogueQuery(level: .series)
+                query.modality = ValueMatcher(modalities[Int.random(in: 0..<modalities.count)])
+                return query
+            })
+        ]
+        measurement.queries = kinds.map { name, makeQuery in
+            let queries = (0..<queriesPerKind).map { _ in makeQuery() }
+            var statistics = CatalogueQueryStatistics(name: name, queries: queries.count)
+            var latencies: [Double] = []
+            latencies.reserveCapacity(queries.count)
+            let start = DispatchTime.now().uptimeNanoseconds
+            for query in queries {
+                let begin = DispatchTime.now().uptimeNanoseconds
+                statistics.matches += index.filter(query).count
+                latencies.append(Double(DispatchTime.now().uptimeNanoseconds - begin) / 1e3)
+            }
+            statistics.seconds = Double(DispatchTime.now().uptimeNanoseconds - start) / 1e9
+            latencies.sort()
+            statistics.p50Microseconds = latencies[latencies.count / 2]
+            statistics.p99Microseconds = latencies[min(latencies.count - 1, latencies.count * 99 / 100)]
+            return statistics
+        }
+        return measurement
+    }
+}
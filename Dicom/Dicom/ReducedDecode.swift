@@ -0,0 +1,375 @@
+//
+//  ReducedDecode.swift
+//  Dicom
+//
+//  Created by hanjongwoo on 10/19/26.
+//
+
+import UIKit
+import ImageIO
+
+// 축소 디코딩 배율 (가로/세로를 1/2, 1/4, 1/8로 줄임)
+enum DecodeScale: Int, CaseIterable {
+    case half = 2
+    case quarter = 4
+    case eighth = 8
+
+    // 긴 변이 maxPixelSize 이상으로 남는 가장 작은 배율 (원본이 이미 작으면 nil)
+    static func fitting(width: Int, height: Int, maxPixelSize: Int) -> DecodeScale? {
+        allCases.reversed().first { max(width, height) / $0.rawValue >= maxPixelSize }
+    }
+}
+
+// 썸네일/미리보기를 위해 원본 해상도로 디코딩하지 않고 바로 작은 이미지를 만드는 디코더
+//  - JPEG Baseline: ImageIO의 subsample 옵션으로 DCT 단계에서 축소 (고주파 IDCT 생략)
+//  - 비압축(LE): 매핑한 파일에서 픽셀 데이터를 복사 없이 읽어 scale×scale 블록 평균 (행 누적은 SIMD 8개씩)
+//  - RLE Lossless: PackBits를 풀면서 필요한 화소만 기록
+//  - 그 외(팔레트 컬러, 다채널, 유한하지 않은 Rescale 값 포함): 전체 디코딩 후 축소
+// 광도 해석(MONOCHROME1/2)은 원본을 따르고, 결과 값이 Int16 범위를 넘으면 S32 이미지로 만듦
+enum ReducedDecoder {
+    private static let pixelDataTag: DicomheroTagId = DicomheroTagId(id: .enumPixelData_7FE0_0010)
+    private static let jpegBaseline = UIDTable.shared.intern(DicomheroUidJPEGBaselineProcess1_1_2_840_10008_1_2_4_50)
+    private static let rleLossless = WellKnownUID.rleLossless
+
+    // 표시용 썸네일 (VOI 적용 완료), url은 dataSet을 읽은 파일
+    static func thumbnail(url: URL, dataSet: DicomheroDataSet, scale: DecodeScale) throws -> UIImage? {
+        let transferSyntax = UIDTable.shared.intern(try dataSet.getString(DicomheroTagId(id: .enumTransferSyntaxUID_0002_0010), elementNumber: 0, defaultValue: ""))
+        if transferSyntax == jpegBaseline, let image = try jpegThumbnail(dataSet: dataSet, scale: scale) {
+            return image
+        }
+        return try VolumeReslicer.render(reducedImage(url: url, dataSet: dataSet, frame: 0, scale: scale))
+    }
+
+    static func thumbnail(url: URL, maxPixelSize: Int) throws -> UIImage? {
+        let dataset = try DicomheroCodecFactory.load(fromFileMaxSize: url.path, maxBufferSize: 2048)
+        let estimate = try DecodeEstimate(dataSet: dataset)
+        guard let scale = DecodeScale.fitting(width: estimate.columns, height: estimate.rows, maxPixelSize: maxPixelSize) else {
+            return try VolumeReslicer.render(dataset.getImageApplyModalityTransform(0))
+        }
+        return try thumbnail(url: url, dataSet: dataset, scale: scale)
+    }
+
+    // 축소 디코딩 방식
+    private enum Path {
+        case uncompressed
+        case rle
+    }
+
+    private static func path(dataSet: DicomheroDataSet, layout: PixelLayout) throws -> Path? {
+        guard layout.samplesPerPixel == 1 && (layout.bitsAllocated == 8 || layout.bitsAllocated == 16) else {
+            return nil
+        }
+        // 팔레트 컬러 등은 라이브러리가 색 변환까지 하도록 맡김
+        guard layout.photometricInterpretation == "MONOCHROME1" || layout.photometricInterpretation == "MONOCHROME2" else {
+            return nil
+        }
+        guard layout.slope.isFinite && layout.intercept.isFinite else {
+            return nil
+        }
+        // 저장 비트가 할당 비트 안에 들어가지 않으면 라이브러리에 맡김
+        guard (1...layout.bitsAllocated).contains(layout.bitsStored),
+              (layout.bitsStored - 1..<layout.bitsAllocated).contains(layout.highBit) else {
+            return nil
+        }
+        let transferSyntax = UIDTable.shared.intern(try dataSet.getString(DicomheroTagId(id: .enumTransferSyntaxUID_0002_0010), elementNumber: 0, defaultValue: ""))
+        if WellKnownUID.isUncompressed(transferSyntax) {
+            return .uncompressed
+        }
+        if transferSyntax == rleLossless, layout.frames == 1 {
+            return .rle
+        }
+        return nil
+    }
+
+    // 원본 해상도로 디코딩하지 않고 축소 이미지를 만들 수 있는지 (디코딩 허가 시 축소 배율을 고를 때 사용)
+    static func canDecodeReduced(dataSet: DicomheroDataSet) -> Bool {
+        guard let layout = try? PixelLayout(dataSet: dataSet) else {
+            return false
+        }
+        return (try? path(dataSet: dataSet, layout: layout)) != nil
+    }
+
+    // 모달리티 변환까지 적용된 축소 이미지 (원본의 MONOCHROME1/2, S16이고 범위를 넘으면 S32)
+    // url은 dataSet을 읽은 파일 (비압축 픽셀 데이터를 파일 매핑으로 직접 읽음)
+    static func reducedImage(url: URL, dataSet: DicomheroDataSet, frame: Int, scale: DecodeScale) throws -> DicomheroImage {
+        let layout = try PixelLayout(dataSet: dataSet)
+        switch try path(dataSet: dataSet, layout: layout) {
+        case .uncompressed:
+            let mapped = try Data(contentsOf: url, options: .alwaysMapped)
+            guard let range = try CompactDataSet(part10: mapped, stopAfter: 0x7FE0_0010).pixelDataRange else {
+                throw DicomVolumeError.unsupportedImage
+            }
+            return try boxAverage(mapped, pixelData: range, layout: layout, frame: frame, scale: scale.rawValue)
+        case .rle:
+            // 압축된 프레임 조각 하나만 복사
+            let data = try pixelBuffer(dataSet: dataSet, buffer: 1)
+            return try decodeRLE(data, layout: layout, scale: scale.rawValue)
+        case nil:
+            return try dataSet.getImageApplyModalityTransform(UInt32(frame)).downsampled(by: scale.rawValue)
+        }
+    }
+
+    // 축소 디코딩에 필요한 헤더 값
+    private struct PixelLayout {
+        let rows: Int
+        let columns: Int
+        let frames: Int
+        let bitsAllocated: Int
+        let bitsStored: Int
+        let highBit: Int
+        let samplesPerPixel: Int
+        let photometricInterpretation: String
+        let isSigned: Bool
+        let slope: Double
+        let intercept: Double
+
+        init(dataSet: DicomheroDataSet) throws {
+            let estimate = try DecodeEstimate(dataSet: dataSet)
+            rows = estimate.rows
+            columns = estimate.columns
+            frames = estimate.frames
+            bitsAllocated = estimate.bitsAllocated
+            let stored = Int(try dataSet.getUint32(DicomheroTagId(id: .enumBitsStored_0028_0101), elementNumber: 0, defaultValue: UInt32(estimate.bitsAllocated)))
+            bitsStored = stored
+            highBit = Int(try dataSet.getUint32(DicomheroTagId(id: .enumHighBit_0028_0102), elementNumber: 0, defaultValue: UInt32(max(stored, 1) - 1)))
+            samplesPerPixel = estimate.samplesPerPixel
+            photometricInterpretation = try dataSet.getString(DicomheroTagId(id: .enumPhotometricInterpretation_0028_0004), elementNumber: 0, defaultValue: "MONOCHROME2")
+                .trimmingCharacters(in: .whitespaces)
+            isSigned = try dataSet.getUint32(DicomheroTagId(id: .enumPixelRepresentation_0028_0103), elementNumber: 0, defaultValue: 0) == 1
+            slope = try dataSet.getDouble(DicomheroTagId(id: .enumRescaleSlope_0028_1053), elementNumber: 0, defaultValue: 1)
+            intercept = try dataSet.getDouble(DicomheroTagId(id: .enumRescaleIntercept_0028_1052), elementNumber: 0, defaultValue: 0)
+        }
+
+        // 할당된 비트에서 저장 비트만 꺼내고 부호가 있으면 부호 확장 (왼쪽으로 밀었다가 산술 시프트로 되돌림)
+        @inline(__always)
+        func stored(_ raw: Int) -> Int {
+            let value = Int32(truncatingIfNeeded: raw >> (highBit + 1 - bitsStored)) & Int32(truncatingIfNeeded: 1 << bitsStored - 1)
+            return Int(isSigned ? value << (32 - bitsStored) >> (32 - bitsStored) : value)
+        }
+
+        @inline(__always)
+        func stored(_ raw: SIMD8<Int32>) -> SIMD8<Int32> {
+            let value = (raw &>> Int32(highBit + 1 - bitsStored)) & Int32(truncatingIfNeeded: 1 << bitsStored - 1)
+            return isSigned ? value &<< Int32(32 - bitsStored) &>> Int32(32 - bitsStored) : value
+        }
+
+        // slope/intercept는 path에서 유한한지 확인함. 결과가 Int32 범위를 넘으면 끝값으로 자름
+        @inline(__always)
+        func rescaled(_ value: Double) -> Int32 {
+            Int32(max(min((value * slope + intercept).rounded(), Double(Int32.max)), Double(Int32.min)))
+        }
+    }
+
+    private static func pixelBuffer(dataSet: DicomheroDataSet, buffer: UInt32) throws -> Data {
+        guard let data = try dataSet.getReadingDataHandlerRaw(pixelDataTag, bufferId: buffer).getMemory().data() else {
+            throw DicomVolumeError.unsupportedImage
+        }
+        return data
+    }
+
+    // 비압축 픽셀 데이터를 scale×scale 블록 평균으로 축소
+    // 출력 행을 작업 수만큼 묶어 나누고, 묶음마다 하나의 열 누적 버퍼에 입력 scale개 행을 더한 뒤 가로 방향 scale개씩 합침
+    // 매핑된 파일을 그대로 읽으므로 해당 프레임에서 읽는 페이지만 메모리에 올라옴
+    private static func boxAverage(_ mapped: Data, pixelData: Range<Int>, layout: PixelLayout, frame: Int, scale: Int) throws -> DicomheroImage {
+        let width = layout.columns, height = layout.rows
+        let outputWidth = max(width / scale, 1), outputHeight = max(height / scale, 1)
+        let bytesPerSample = layout.bitsAllocated / 8
+        let frameOffset = pixelData.lowerBound + frame * width * height * bytesPerSample
+        guard frameOffset + width * height * bytesPerSample <= pixelData.upperBound else {
+            throw DicomVolumeError.unsupportedImage
+        }
+        var output = [Int32](repeating: 0, count: outputWidth * outputHeight)
+        let chunks = min(outputHeight, ProcessInfo.processInfo.activeProcessorCount * 4)
+
+        mapped.withUnsafeBytes { raw in
+            let base = raw.baseAddress! + frameOffset
+            output.withUnsafeMutableBufferPointer { buffer in
+                let result = buffer
+                DispatchQueue.concurrentPerform(iterations: chunks) { chunk in
+                    var accumulator = [Int32](repeating: 0, count: width)
+                    for oy in (chunk * outputHeight / chunks)..<((chunk + 1) * outputHeight / chunks) {
+                        let rowCount = min(scale, height - oy * scale)
+                        accumulator.withUnsafeMutableBufferPointer { sums in
+                            sums.update(repeating: 0)
+                            let vectorWidth = width & ~7
+                            for k in 0..<rowCount {
+                                let row = base + ((oy * scale + k) * width) * bytesPerSample
+                                // 8개씩 읽어 저장 비트 추출/부호 확장과 누적을 SIMD로 처리 (파일은 리틀 엔디언, 기기도 리틀 엔디언)
+                                let lanes = UnsafeMutableRawPointer(sums.baseAddress!)
+                                for x in stride(from: 0, to: vectorWidth, by: 8) {
+                                    let raw = bytesPerSample == 1
+                                        ? SIMD8<Int32>(truncatingIfNeeded: row.loadUnaligned(fromByteOffset: x, as: SIMD8<UInt8>.self))
+                                        : SIMD8<Int32>(truncatingIfNeeded: row.loadUnaligned(fromByteOffset: x * 2, as: SIMD8<UInt16>.self))
+                                    let sum = lanes.loadUnaligned(fromByteOffset: x * 4, as: SIMD8<Int32>.self) &+ layout.stored(raw)
+                                    lanes.storeBytes(of: sum, toByteOffset: x * 4, as: SIMD8<Int32>.self)
+                                }
+                                for x in vectorWidth..<width {
+                                    let sample = bytesPerSample == 1
+                                        ? Int(row.load(fromByteOffset: x, as: UInt8.self))
+                                        : Int(UInt16(littleEndian: row.loadUnaligned(fromByteOffset: x * 2, as: UInt16.self)))
+                                    sums[x] &+= Int32(layout.stored(sample))
+                                }
+                            }
+                            for ox in 0..<outputWidth {
+                                var sum: Int32 = 0
+                                for column in (ox * scale)..<min(ox * scale + scale, width) {
+                                    sum &+= sums[column]
+                                }
+                                let count = Double(rowCount * min(scale, width - ox * scale))
+                                result[oy * outputWidth + ox] = layout.rescaled(Double(sum) / count)
+                            }
+                        }
+                    }
+                }
+            }
+        }
+        return try makeImage(output, width: outputWidth, height: outputHeight, colorSpace: layout.photometricInterpretation)
+    }
+
+    // 값이 모두 Int16 범위면 S16, 아니면 S32 이미지를 만듦 (colorSpace는 원본의 MONOCHROME1/2)
+    private static func makeImage(_ values: [Int32], width: Int, height: Int, colorSpace: String) throws -> DicomheroImage {
+        let fitsInt16 = values.allSatisfy { Int16(exactly: $0) != nil }
+        let image: DicomheroImage = DicomheroImage(width: UInt32(width), height: UInt32(height), depth: fitsInt16 ? .s16 : .s32,
+                                                   colorSpace: colorSpace, highBit: fitsInt16 ? 15 : 31)
+        let handler = try image.getWritingDataHandler()
+        if fitsInt16 {
+            try values.map { Int16($0) }.withUnsafeBytes { try handler.assign(Data($0)) }
+        } else {
+            try values.withUnsafeBytes { try handler.assign(Data($0)) }
+        }
+        handler.commit()
+        return image
+    }
+
+    // RLE Lossless 프레임을 풀면서 scale 간격의 화소만 기록
+    // 16비트는 상위 바이트 세그먼트와 하위 바이트 세그먼트로 나뉘어 있으므로 두 세그먼트를 각각 표본 추출 후 합침
+    private static func decodeRLE(_ data: Data, layout: PixelLayout, scale: Int) throws -> DicomheroImage {
+        let width = layout.columns, height = layout.rows
+        let outputWidth = max(width / scale, 1), outputHeight = max(height / scale, 1)
+        let bytesPerSample = layout.bitsAllocated / 8
+
+        var planes = [[UInt8]](repeating: [UInt8](repeating: 0, count: outputWidth * outputHeight), count: bytesPerSample)
+        try data.withUnsafeBytes { raw in
+            guard raw.count >= 64 else {
+                throw DicomVolumeError.unsupportedImage
+            }
+            let segmentCount = Int(raw.loadUnaligned(as: UInt32.self).littleEndian)
+            guard segmentCount == bytesPerSample else {
+                throw DicomVolumeError.unsupportedImage
+            }
+            for segment in 0..<segmentCount {
+                let start = Int(raw.loadUnaligned(fromByteOffset: 4 + segment * 4, as: UInt32.self).littleEndian)
+                let end = segment + 1 < segmentCount ? Int(raw.loadUnaligned(fromByteOffset: 8 + segment * 4, as: UInt32.self).littleEndian) : raw.count
+                guard start < end, end <= raw.count else {
+                    throw DicomVolumeError.unsupportedImage
+                }
+                planes[segment].withUnsafeMutableBufferPointer { plane in
+                    unpackBits(UnsafeRawBufferPointer(rebasing: raw[start..<end]), width: width, height: height,
+                               scale: scale, outputWidth: outputWidth, outputHeight: outputHeight, into: plane)
+                }
+            }
+        }
+
+        var output = [Int32](repeating: 0, count: outputWidth * outputHeight)
+        for i in output.indices {
+            // 세그먼트 0이 최상위 바이트
+            var value = 0
+            for plane in planes {
+                value = value << 8 | Int(plane[i])
+            }
+            output[i] = layout.rescaled(Double(layout.stored(value)))
+        }
+        return try makeImage(output, width: outputWidth, height: outputHeight, colorSpace: layout.photometricInterpretation)
+    }
+
+    // PackBits 세그먼트를 순서대로 풀되 (행, 열)이 모두 scale의 배수인 바이트만 출력에 기록
+    private static func unpackBits(_ source: UnsafeRawBufferPointer, width: Int, height: Int, scale: Int,
+                                   outputWidth: Int, outputHeight: Int, into plane: UnsafeMutableBufferPointer<UInt8>) {
+        var x = 0, y = 0, position = 0
+        @inline(__always)
+        func emit(_ byte: UInt8) {
+            if y % scale == 0 && x % scale == 0 && x / scale < outputWidth && y / scale < outputHeight {
+                plane[(y / scale) * outputWidth + x / scale] = byte
+            }
+            x += 1
+            if x == width {
+                x = 0
+                y += 1
+            }
+        }
+        while position < source.count && y < height {
+            let control = Int8(bitPattern: source[position])
+            position += 1
+            if control >= 0 {
+                let count = min(Int(control) + 1, source.count - position)
+                for i in 0..<count where y < height {
+                    emit(source[position + i])
+                }
+                position += count
+            } else if control != -128, position < source.count {
+                let byte = source[position]
+                position += 1
+                for _ in 0..<(1 - Int(control)) where y < height {
+                    emit(byte)
+                }
+            }
+        }
+    }
+
+    // 캡슐화된 JPEG Baseline 프레임을 ImageIO로 축소 디코딩
+    // 여러 프레임이면 첫 번째 조각만 사용 (프레임당 조각 하나인 일반적인 경우)
+    private static func jpegThumbnail(dataSet: DicomheroDataSet, scale: DecodeScale) throws -> UIImage? {
+        let tag = try dataSet.getTag(pixelDataTag)
+        let frames = try DecodeEstimate(dataSet: dataSet).frames
+        let fragments = Int(tag.getBuffersCount())
+        guard fragments > 1 else {
+            return nil
+        }
+        var stream = Data()
+        for buffer in 1..<(frames == 1 ? fragments : 2) {
+            if let fragment = try tag.getReadingDataHandlerRaw(UInt32(buffer)).getMemory().data() {
+                stream.append(fragment)
+            }
+        }
+        guard let source = CGImageSourceCreateWithData(stream as CFData, nil) else {
+            return nil
+        }
+        let options = [kCGImageSourceSubsampleFactor: scale.rawValue,
+                       kCGImageSourceShouldCacheImmediately: true] as CFDictionary
+        return CGImageSourceCreateImageAtIndex(source, 0, options).map { UIImage(cgImage: $0) }
+    }
+}
+
+// 썸네일 생성 방식별 처리량 비교
+struct ThumbnailStatistics {
+    var files = 0
+    var fullDecodeSeconds = 0.0    // 전체 해상도 디코딩 후 축소
+    var reducedDecodeSeconds = 0.0 // 축소 디코딩
+
+    var speedup: Double { reducedDecodeSeconds > 0 ? fullDecodeSeconds / reducedDecodeSeconds : 0 }
+}
+
+enum ThumbnailBenchmark {
+    static func run(urls: [URL], scale: DecodeScale = .quarter) -> ThumbnailStatistics {
+        var statistics = ThumbnailStatistics()
+        for url in urls {
+            autoreleasepool {
+                do {
+                    var start = DispatchTime.now().uptimeNanoseconds
+                    let full = try DicomheroCodecFactory.load(fromFileMaxSize: url.path, maxBufferSize: 2048)
+                    _ = try VolumeReslicer.render(full.getImageApplyModalityTransform(0).downsampled(by: scale.rawValue))
+                    statistics.fullDecodeSeconds += Double(DispatchTime.now().uptimeNanoseconds - start) / 1e9
+
+                    start = DispatchTime.now().uptimeNanoseconds
+                    let reduced = try DicomheroCodecFactory.load(fromFileMaxSize: url.path, maxBufferSize: 2048)
+                    _ = try ReducedDecoder.thumbnail(url: url, dataSet: reduced, scale: scale)
+                    statistics.reducedDecodeSeconds += Double(DispatchTime.now().uptimeNanoseconds - start) / 1e9
+                    statistics.files += 1
+                } catch {
+                    print("caught: \(error)")
+                }
+            }
+        }
+        return statistics
+    }
+}
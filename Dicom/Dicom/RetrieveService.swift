@@ -0,0 +1,329 @@
+//
+//  RetrieveService.swift
+//  Dicom
+//
+//  Created by hanjongwoo on 10/19/26.
+//
+
+import Foundation
+
+// C-MOVE/C-GET 하위 연산 수
+struct SubOperationCounts: Equatable {
+    var remaining = 0
+    var completed = 0
+    var failed = 0
+    var warning = 0
+
+    mutating func record(_ outcome: SubOperationOutcome) {
+        remaining = max(0, remaining - 1)
+        switch outcome {
+        case .completed: completed += 1
+        case .warning: warning += 1
+        case .failed: failed += 1
+        }
+    }
+}
+
+// 하위 연산 스레드가 기록하고, 연결 스레드가 Pending 응답용으로 읽는 진행 상황
+final class RetrieveProgress {
+    private let condition = NSCondition()
+    private var counts: SubOperationCounts
+    private var finished = false
+
+    init(total: Int) {
+        counts = SubOperationCounts(remaining: total)
+    }
+
+    func record(_ outcome: SubOperationOutcome) {
+        condition.lock()
+        counts.record(outcome)
+        condition.broadcast()
+        condition.unlock()
+    }
+
+    func finish() {
+        condition.lock()
+        finished = true
+        condition.broadcast()
+        condition.unlock()
+    }
+
+    // last와 달라질 때까지 기다렸다가 interval 동안 쌓인 변화를 한 번에 돌려줌, 끝났으면 nil
+    // 응답 하나가 하위 연산 하나마다 나가지 않게 해 진행 보고가 전송을 늦추지 않음
+    func next(after last: SubOperationCounts, interval: TimeInterval) -> SubOperationCounts? {
+        condition.lock()
+        defer { condition.unlock() }
+        while counts == last && !finished {
+            condition.wait()
+        }
+        let deadline = Date(timeIntervalSinceNow: interval)
+        while !finished && condition.wait(until: deadline) {}
+        return finished ? nil : counts
+    }
+
+    var current: SubOperationCounts {
+        condition.lock()
+        defer { condition.unlock() }
+        return counts
+    }
+}
+
+// 카탈로그에서 찾은 인스턴스를 StorageSCP 저장 폴더에서 읽어 C-MOVE/C-GET 하위 C-STORE로 보냄
+// 파일 읽기는 reader들이 앞서 채우고, 전송은 응답을 기다리지 않고 창 크기만큼 겹쳐 보냄
+// C-MOVE는 목적지로 여러 연결을 열어 나눠 보내고, C-GET은 요청이 온 연결 하나로 보냄
+final class RetrieveService {
+    let configuration: StorageSCP.Configuration
+    let catalogue: StudyCatalogue
+
+    init(configuration: StorageSCP.Configuration, catalogue: StudyCatalogue) {
+        self.configuration = configuration
+        self.catalogue = catalogue
+    }
+
+    private func retrieveItems(for command: DicomheroDimseCommand) throws -> [(sopClassUID: String, sopInstanceUID: String, fileName: String)] {
+        catalogue.retrieveItems(CatalogueQuery(identifier: try command.getPayloadDataSet()))
+    }
+
+    // 카탈로그가 색인한 저장 파일 이름 (데이터셋의 SOP Instance UID가 아니라 저장할 때 쓴 이름)
+    private func url(for fileName: String) -> URL {
+        configuration.directory.appendingPathComponent(fileName)
+    }
+
+    func move(_ move: DicomheroCMoveCommand, service: DicomheroDimseService) throws {
+        let destinationAET = try move.getDestinationAET()
+        guard let destination = configuration.moveDestinations[destinationAET] else {
+            try service.sendCommandOrResponse(DicomheroCMoveResponse(
+                withcommand: move, responseCode: .moveDestinationUnknown,
+                remainingSubOperations: 0, completedSubOperations: 0, failedSubOperations: 0, warningSubOperations: 0))
+            return
+        }
+        let items = try retrieveItems(for: move)
+        let progress = RetrieveProgress(total: items.count)
+        let sender = BulkStoreSender(configuration: BulkStoreSender.Configuration(
+            node: destination.node, port: destination.port,
+            callingAET: configuration.aeTitle, calledAET: destinationAET,
+            associations: min(configuration.retrieveAssociations, max(1, items.count)),
+            window: min(configuration.retrieveWindow, destination.window), readers: configuration.retrieveReaders,
+            dimseTimeoutSeconds: configuration.dimseTimeoutSeconds))
+        sender.onOutcome = progress.record
+        DispatchQueue.global(qos: .userInitiated).async {
+            _ = sender.send(urls: items.map { self.url(for: $0.fileName) })
+            progress.finish()
+        }
+
+        var last = progress.current
+        while let counts = progress.next(after: last, interval: configuration.progressInterval) {
+            try service.sendCommandOrResponse(DicomheroCMoveResponse(
+                withcommand: move, responseCode: .pending,
+                remainingSubOperations: UInt32(counts.remaining), completedSubOperations: UInt32(counts.completed),
+                failedSubOperations: UInt32(counts.failed), warningSubOperations: UInt32(counts.warning)))
+            last = counts
+        }
+        let counts = RetrieveService.final(progress.current, total: items.count)
+        try service.sendCommandOrResponse(DicomheroCMoveResponse(
+            withcommand: move, responseCode: RetrieveService.status(counts),
+            remainingSubOperations: 0, completedSubOperations: UInt32(counts.completed),
+            failedSubOperations: UInt32(counts.failed), warningSubOperations: UInt32(counts.warning)))
+    }
+
+    // C-GET은 하위 C-STORE와 Pending 응답이 같은 연결로 나가므로 연결 스레드 하나에서 번갈아 보냄
+    func get(_ get: DicomheroCGetCommand, service: DicomheroDimseService) throws {
+        let items = try retrieveItems(for: get)
+        let buffer = BoundedBuffer<BulkStoreSender.Item>(capacity: configuration.retrievePrefetch)
+        var counts = SubOperationCounts(remaining: items.count)
+        let readFailures = NSLock()
+        var unreadable = 0
+        let readers = max(1, configuration.retrieveReaders)
+        DispatchQueue.global(qos: .userInitiated).async {
+            let next = NSLock()
+            var index = 0
+            DispatchQueue.concurrentPerform(iterations: readers) { _ in
+                while true {
+                    next.lock()
+                    let i = index
+                    index += 1
+                    next.unlock()
+                    guard i < items.count else { return }
+                    if let item = BulkStoreSender.read(self.url(for: items[i].fileName), repetition: 0) {
+                        buffer.put(item)
+                    } else {
+                        readFailures.lock()
+                        unreadable += 1
+                        readFailures.unlock()
+                    }
+                }
+            }
+            buffer.finish()
+        }
+        defer { buffer.cancel() }
+
+        // 요청자가 받아들인 창을 넘겨 보내지 않도록 설정한 C-GET 창만큼만 응답 없이 보냄
+        let window = max(1, configuration.getWindow)
+        var outstanding: [DicomheroCStoreCommand] = []
+        var lastReport = DispatchTime.now().uptimeNanoseconds
+        func collectOldest() throws {
+            counts.record(SubOperationOutcome(status: try service.getCStoreResponse(outstanding.removeFirst()).status))
+            readFailures.lock()
+            for _ in 0..<unreadable {
+                counts.record(.failed)
+            }
+            unreadable = 0
+            readFailures.unlock()
+            let now = DispatchTime.now().uptimeNanoseconds
+            if Double(now - lastReport) / 1e9 >= configuration.progressInterval {
+                lastReport = now
+                try service.sendCommandOrResponse(DicomheroCGetResponse(
+                    withcommand: get, responseCode: .pending,
+                    remainingSubOperations: UInt32(counts.remaining), completedSubOperations: UInt32(counts.completed),
+                    failedSubOperations: UInt32(counts.failed), warningSubOperations: UInt32(counts.warning)))
+            }
+        }
+
+        while let item = buffer.take() {
+            try autoreleasepool {
+                // 요청자가 원본 전송 구문을 받아들이지 않았으면 협상된 구문으로 바꿔 보냄
+                do {
+                    _ = try DataSetTranscoder.conform(item.dataSet, to: service.getTransferSyntax(item.sopClassUID))
+                } catch {
+                    print("caught: \(error)")
+                    counts.record(.failed)
+                    return
+                }
+                let command = DicomheroCStoreCommand(
+                    abstractSyntax: item.sopClassUID,
+                    messageID: service.getNextCommandID(),
+                    priority: .medium,
+                    affectedSopClassUid: item.sopClassUID,
+                    affectedSopInstanceUid: item.sopInstanceUID,
+                    originatorAET: "", originatorMessageID: 0,
+                    payload: item.dataSet)
+                try service.sendCommandOrResponse(command)
+                outstanding.append(command)
+                if outstanding.count >= window {
+                    try collectOldest()
+                }
+            }
+        }
+        while !outstanding.isEmpty {
+            try collectOldest()
+        }
+        counts = RetrieveService.final(counts, total: items.count)
+        try service.sendCommandOrResponse(DicomheroCGetResponse(
+            withcommand: get, responseCode: RetrieveService.status(counts),
+            remainingSubOperations: 0, completedSubOperations: UInt32(counts.completed),
+            failedSubOperations: UInt32(counts.failed), warningSubOperations: UInt32(counts.warning)))
+    }
+
+    // 끝까지 결과가 오지 않은 하위 연산(연결 끊김 등)은 실패로 셈
+    private static func final(_ counts: SubOperationCounts, total: Int) -> SubOperationCounts {
+        var counts = counts
+        counts.failed = total - counts.completed - counts.warning
+        counts.remaining = 0
+        return counts
+    }
+
+    private static func status(_ counts: SubOperationCounts) -> DicomheroDimseStatusCode {
+        counts.failed > 0 || counts.warning > 0 ? .subOperationCompletedWithErrors : .success
+    }
+}
+
+struct RetrieveMeasurement {
+    var associations = 0
+    var window = 0
+    var instances = 0
+    var completed = 0
+    var seconds = 0.0
+
+    var instancesPerSecond: Double { seconds > 0 ? Double(completed) / seconds : 0 }
+}
+
+enum RetrieveBenchmark {
+    // urls를 StorageSCP 저장 폴더 형태(<SOP Instance UID>.dcm)로 복사하고 색인함
+    // 검사 UID마다 파일 크기의 합을 돌려줌
+    static func stage(urls: [URL], in directory: URL, catalogue: StudyCatalogue) -> [String: Int] {
+        try? FileManager.default.removeItem(at: directory)
+        try? FileManager.default.createDirectory(at: directory, withIntermediateDirectories: true)
+        var studies: [String: Int] = [:]
+        for url in urls {
+            do {
+                let dataSet = try DicomheroCodecFactory.load(fromFile: url.path)
+                let instanceUID = try dataSet.getString(DicomheroTagId(id: .enumSOPInstanceUID_0008_0018), elementNumber: 0)
+                try FileManager.default.copyItem(at: url, to: directory.appendingPathComponent(instanceUID + ".dcm"))
+                catalogue.insert(dataSet: dataSet, fileName: instanceUID + ".dcm")
+                let studyUID = try dataSet.getString(DicomheroTagId(id: .enumStudyInstanceUID_0020_000D), elementNumber: 0)
+                studies[studyUID, default: 0] += (try? url.resourceValues(forKeys: [.fileSizeKey]).fileSize) ?? 0
+            } catch {
+                print("caught: \(error)")
+            }
+        }
+        return studies
+    }
+
+    // urls를 저장 폴더에 옮겨 색인한 뒤, 검사 단위 C-MOVE로 루프백 비동기 SCP에 보내며 잼
+    // (1, 1, 1)이 한 장씩 읽고 보내고 응답을 기다리던 방식에 해당
+    static func run(urls: [URL], settings: [(associations: Int, window: Int, readers: Int)] = [(1, 1, 1), (1, 8, 2), (4, 8, 2)],
+                    port: Int = 11117, destinationPort: Int = 11118) -> [RetrieveMeasurement] {
+        let directory = FileManager.default.temporaryDirectory.appendingPathComponent("RetrieveBenchmark")
+        defer { try? FileManager.default.removeItem(at: directory) }
+        let catalogue = StudyCatalogue()
+        let studies = stage(urls: urls, in: directory, catalogue: catalogue).keys.sorted()
+
+        let destination = AssociationMultiplexer(configuration: AssociationMultiplexer.Configuration(
+            aeTitle: "RETRIEVEDEST", port: destinationPort, maxPDULength: 1 << 20, maxPerformedOperations: 64))
+        do {
+            try destination.start()
+        } catch {
+            print("caught: \(error)")
+            return []
+        }
+        defer { destination.stop() }
+
+        return settings.map { setting in
+            var configuration = StorageSCP.Configuration(port: port, directory: directory)
+            configuration.moveDestinations = [destination.configuration.aeTitle: StorageSCP.MoveDestination(
+                node: "127.0.0.1", port: destinationPort, window: Int(destination.configuration.maxPerformedOperations))]
+            configuration.retrieveAssociations = setting.associations
+            configuration.retrieveWindow = setting.window
+            configuration.retrieveReaders = setting.readers
+            let scp = StorageSCP(configuration: configuration, catalogue: catalogue)
+            var measurement = RetrieveMeasurement(associations: setting.associations, window: setting.window, instances: catalogue.instanceCount)
+            do {
+                try scp.start()
+                defer { scp.stop() }
+                let stream = try DicomheroTCPStream(address: DicomheroTCPActiveAddress(node: "127.0.0.1", service: String(port)))
+                let association = try DicomheroAssociationSCU(
+                    thisAET: "DICOMAPP", otherAET: configuration.aeTitle,
+                    maxInvokedOperations: 1, maxPerformedOperations: 1,
+                    presentationContexts: StorageSCP.presentationContexts(),
+                    reader: DicomheroStreamReader(inputStream: stream.getStreamInput()),
+                    writer: DicomheroStreamWriter(outputStream: stream.getStreamOutput()),
+                    dimseTimeoutSeconds: configuration.dimseTimeoutSeconds)
+                let service = DicomheroDimseService(association: association)
+                let start = DispatchTime.now().uptimeNanoseconds
+                for studyUID in studies {
+                    let identifier = DicomheroDataSet(transferSyntax: WellKnownUID.string(for: WellKnownUID.explicitVRLittleEndian))
+                    try identifier.setString(DicomheroTagId(id: .enumQueryRetrieveLevel_0008_0052), newValue: QueryLevel.study.rawValue)
+                    try identifier.setString(DicomheroTagId(id: .enumStudyInstanceUID_0020_000D), newValue: studyUID)
+                    let abstractSyntax = DicomheroUidStudyRootQueryRetrieveInformationModelMOVE_1_2_840_10008_5_1_4_1_2_2_2
+                    let move = DicomheroCMoveCommand(
+                        abstractSyntax: abstractSyntax, messageID: service.getNextCommandID(), priority: .medium,
+                        affectedSopClassUid: abstractSyntax, destinationAET: destination.configuration.aeTitle,
+                        identifier: identifier)
+                    try service.sendCommandOrResponse(move)
+                    while true {
+                        let response = try service.getCMoveResponse(move)
+                        if response.status != .pending {
+                            measurement.completed += Int(try response.getCompletedSubOperations())
+                            break
+                        }
+                    }
+                }
+                measurement.seconds = Double(DispatchTime.now().uptimeNanoseconds - start) / 1e9
+                try association.release()
+            } catch {
+                print("caught: \(error)")
+            }
+            return measurement
+        }
+    }
+}
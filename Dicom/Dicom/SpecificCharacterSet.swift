@@ -0,0 +1,159 @@
+//
+//  SpecificCharacterSet.swift
+//  Dicom
+//
+//  Created by hanjongwoo on 10/19/26.
+//
+
+import Foundation
+
+// Specific Character Set (0008,0005) 값에 따라 문자열 VR의 원시 바이트를 String으로 바꿈
+// 라이브러리의 getString은 이 변환을 해 주지만, 원시 바이트를 직접 읽는 경로(압축 데이터셋, 일괄 조회,
+// DICOMDIR 지연 읽기 등)는 이 타입으로 변환해야 함
+//  - 기본 문자 집합(값 없음, ISO_IR 6)과 ASCII만 있는 값은 변환 없이 바로 만듦
+//  - ISO 2022 IR 149(한글)는 ESC 지정 시퀀스를 걷어 내고 KS X 1001(EUC-KR)로 해석
+//  - IR 13(JIS X 0201 반각 가타카나/로마자)은 Shift-JIS의 한 바이트 부분과 같으므로 Shift-JIS로,
+//    IR 87/159(JIS X 0208/0212 한자)는 ISO-2022-JP로 해석
+struct SpecificCharacterSet: Equatable {
+    static let `default` = SpecificCharacterSet(encoding: .ascii, usesEscapes: false)
+
+    let encoding: String.Encoding
+    let usesEscapes: Bool // ISO 2022 코드 확장: 값 안의 ESC 시퀀스로 G0/G1을 바꿈
+
+    private init(encoding: String.Encoding, usesEscapes: Bool) {
+        self.encoding = encoding
+        self.usesEscapes = usesEscapes
+    }
+
+    // (0008,0005)의 원시 값 (여러 값이면 백슬래시로 구분)
+    init(_ value: String) {
+        let terms = value.split(separator: "\\", omittingEmptySubsequences: false)
+            .map { $0.trimmingCharacters(in: .whitespaces) }
+        let extended = terms.contains { $0.hasPrefix("ISO 2022") }
+        // 첫 값이 비어 있으면 기본 문자 집합이고, 실제 변환은 두 번째 이후 값이 정함
+        // 일본어는 IR 13과 IR 87/159를 함께 쓰는 경우가 많아 한자 집합이 있으면 그것을 따름 (가타카나는 decodeJapanese가 처리)
+        let kanji = terms.first { $0 == "ISO 2022 IR 87" || $0 == "ISO 2022 IR 159" }
+        let term = kanji ?? terms.first { !$0.isEmpty && $0 != "ISO 2022 IR 6" && $0 != "ISO_IR 6" } ?? ""
+        self.init(encoding: SpecificCharacterSet.encoding(of: term), usesEscapes: extended)
+    }
+
+    init(dataSet: DicomheroDataSet) {
+        let value = (try? dataSet.getString(DicomheroTagId(id: .enumSpecificCharacterSet_0008_0005), elementNumber: 0, defaultValue: "")) ?? ""
+        self.init(value)
+    }
+
+    private static func encoding(of term: String) -> String.Encoding {
+        func cf(_ encoding: CFStringEncodings) -> String.Encoding {
+            String.Encoding(rawValue: CFStringConvertEncodingToNSStringEncoding(CFStringEncoding(encoding.rawValue)))
+        }
+        switch term {
+        case "ISO_IR 100", "ISO 2022 IR 100": return .isoLatin1
+        case "ISO_IR 101", "ISO 2022 IR 101": return .isoLatin2
+        case "ISO_IR 109", "ISO 2022 IR 109": return cf(.isoLatin3)
+        case "ISO_IR 110", "ISO 2022 IR 110": return cf(.isoLatin4)
+        case "ISO_IR 144", "ISO 2022 IR 144": return cf(.isoLatinCyrillic)
+        case "ISO_IR 127", "ISO 2022 IR 127": return cf(.isoLatinArabic)
+        case "ISO_IR 126", "ISO 2022 IR 126": return cf(.isoLatinGreek)
+        case "ISO_IR 138", "ISO 2022 IR 138": return cf(.isoLatinHebrew)
+        case "ISO_IR 148", "ISO 2022 IR 148": return cf(.isoLatin5)
+        case "ISO_IR 166", "ISO 2022 IR 166": return cf(.isoLatinThai)
+        case "ISO_IR 13", "ISO 2022 IR 13": return .shiftJIS
+        case "ISO 2022 IR 87", "ISO 2022 IR 159": return .iso2022JP
+        case "ISO_IR 149", "ISO 2022 IR 149": return cf(.EUC_KR)
+        case "ISO 2022 IR 58": return cf(.GB_2312_80)
+        case "ISO_IR 192": return .utf8
+        case "GB18030", "GBK": return cf(.GB_18030_2000)
+        default: return .ascii
+        }
+    }
+
+    // 원시 바이트를 문자열로 (앞뒤 공백/NUL은 호출하는 쪽에서 제거)
+    func decode(_ bytes: UnsafeRawBufferPointer) -> String {
+        // ASCII만 있으면 어느 문자 집합이든 결과가 같음
+        if !bytes.contains(where: { $0 >= 0x80 || $0 == 0x1B }) {
+            return String(decoding: bytes, as: UTF8.self)
+        }
+        switch encoding {
+        case .ascii, .utf8:
+            return String(decoding: bytes, as: UTF8.self)
+        case .iso2022JP:
+            return SpecificCharacterSet.decodeJapanese(bytes)
+        default:
+            let data = usesEscapes ? SpecificCharacterSet.removingEscapes(bytes) : Data(bytes)
+            return String(data: data, encoding: encoding) ?? String(decoding: bytes, as: UTF8.self)
+        }
+    }
+
+    func decode(_ bytes: ArraySlice<UInt8>) -> String {
+        bytes.withUnsafeBytes { decode($0) }
+    }
+
+    // IR 13과 IR 87/159를 함께 쓰면 G1의 반각 가타카나(0xA1-0xDF)는 8비트 그대로 오고
+    // 한자는 ESC로 G0에 지정된 7비트 JIS X 0208/0212로 옴. ISO-2022-JP 변환기는 8비트 바이트를 받지 않으므로
+    // 8비트 구간은 Shift-JIS로, 7비트 구간은 그때의 G0 지정을 앞에 붙여 ISO-2022-JP 변환기로 해석
+    private static func decodeJapanese(_ bytes: UnsafeRawBufferPointer) -> String {
+        var result = ""
+        var g0: [UInt8] = []         // 지금 G0에 지정된 시퀀스 (없으면 ASCII)
+        var segment: [UInt8] = []
+        var katakanaSegment = false
+        func flush() {
+            defer { segment.removeAll() }
+            guard !segment.isEmpty else { return }
+            if katakanaSegment {
+                result += String(bytes: segment, encoding: .shiftJIS) ?? ""
+            } else {
+                result += String(bytes: segment + [0x1B, 0x28, 0x42], encoding: .iso2022JP) ?? String(decoding: segment, as: UTF8.self)
+            }
+        }
+        var i = 0
+        while i < bytes.count {
+            let byte = bytes[i]
+            if byte == 0x1B {
+                var end = i + 1
+                while end < bytes.count && (0x20...0x2F).contains(bytes[end]) { end += 1 }
+                let sequence = Array(bytes[i..<min(end + 1, bytes.count)])
+                i = end + 1
+                // G0 지정(ESC ( F, ESC $ F, ESC $ ( F)만 남김. G1 지정(ESC ) I 등)은 8비트 바이트로 구분되므로 버림
+                let designatesG0 = sequence.count >= 3 &&
+                    (sequence[1] == 0x28 || (sequence[1] == 0x24 && (sequence.count == 3 || sequence[2] == 0x28)))
+                guard designatesG0 else { continue }
+                g0 = sequence
+                if !katakanaSegment {
+                    segment += sequence
+                }
+                continue
+            }
+            let katakana = byte >= 0x80
+            if katakana != katakanaSegment {
+                flush()
+                katakanaSegment = katakana
+                if !katakana {
+                    segment = g0
+                }
+            }
+            segment.append(byte)
+            i += 1
+        }
+        flush()
+        return result
+    }
+
+    // ESC로 시작하는 지정 시퀀스(예: ESC $ ) C, ESC ( B)를 걷어 냄
+    // G1에 지정된 문자 집합은 최상위 비트로 구분되므로 시퀀스를 빼도 EUC 형식으로 해석할 수 있음
+    private static func removingEscapes(_ bytes: UnsafeRawBufferPointer) -> Data {
+        var output = Data(capacity: bytes.count)
+        var i = 0
+        while i < bytes.count {
+            guard bytes[i] == 0x1B else {
+                output.append(bytes[i])
+                i += 1
+                continue
+            }
+            // 중간 바이트(0x20-0x2F)들 다음의 마지막 바이트(0x30-0x7E)까지가 한 시퀀스
+            i += 1
+            while i < bytes.count && (0x20...0x2F).contains(bytes[i]) { i += 1 }
+            i += 1
+        }
+        return output
+    }
+}
@@ -0,0 +1,564 @@
+//
+//  StorageSCP.swift
+//  Dicom
+//
+//  Created by hanjongwoo on 10/19/26.
+//
+
+import Foundation
+
+// 받은 인스턴스를 파일로 쓰는 작업을 연결 처리와 분리하는 쓰기 지연 큐
+// 연결 스레드는 데이터셋을 넘기고 바로 다음 명령을 받으며, 실제 저장은 writer 큐들이 나눠서 함
+// C-STORE 응답은 저장이 끝난 뒤 completion에서 보냄 (실패하면 실패 상태로)
+final class WriteBehindQueue {
+    let directory: URL
+    private let queues: [DispatchQueue]
+    private let group = DispatchGroup()
+    private let lock = NSLock()
+    private var next = 0
+    private(set) var writtenFiles = 0
+    private(set) var writtenBytes = 0
+    private(set) var failedWrites = 0
+
+    init(directory: URL, writers: Int) {
+        self.directory = directory
+        queues = (0..<max(1, writers)).map { DispatchQueue(label: "WriteBehindQueue.\($0)", qos: .utility) }
+    }
+
+    // completion은 writer 큐에서 호출됨 (저장된 바이트 수, 실패하면 nil)
+    func enqueue(_ dataSet: DicomheroDataSet, fileName: String, completion: @escaping (Int?) -> Void) {
+        let queue = locked { () -> DispatchQueue in
+            next = (next + 1) % queues.count
+            return queues[next]
+        }
+        let url = directory.appendingPathComponent(fileName)
+        queue.async(group: group) {
+            var bytes: Int?
+            do {
+                try DicomheroCodecFactory.save(toFile: url.path, dataSet: dataSet, codecType: .dicom)
+                bytes = (try? FileManager.default.attributesOfItem(atPath: url.path)[.size] as? Int) ?? 0
+            } catch {
+                print("caught: \(error)")
+            }
+            self.locked {
+                if let bytes {
+                    self.writtenFiles += 1
+                    self.writtenBytes += bytes
+                } else {
+                    self.failedWrites += 1
+                }
+            }
+            completion(bytes)
+        }
+    }
+
+    // 큐에 들어간 모든 쓰기가 끝날 때까지 대기
+    func flush() {
+        group.wait()
+    }
+
+    func resetCounters() {
+        locked {
+            writtenFiles = 0
+            writtenBytes = 0
+            failedWrites = 0
+        }
+    }
+
+    private func locked<Result>(_ body: () -> Result) -> Result {
+        lock.lock()
+        defer { lock.unlock() }
+        return body()
+    }
+}
+
+// DicomheroTCPListener 위에서 동작하는 C-STORE SCP
+// 받은 연결(association)은 worker 풀이 하나씩 맡아 DIMSE 명령을 받음. worker는 필요할 때 maxAssociations개까지 늘고
+// 연결이 끝나도 남아서 다음 연결을 맡음. 동시 연결 수와 연결당 저장 대기 인스턴스 수를 제한함
+final class StorageSCP {
+    struct MoveDestination {
+        var node: String
+        var port: Int
+        var window = 1 // 목적지가 받아들이는 비동기 연산 창 (확인할 수 없으므로 알고 있는 값을 설정)
+    }
+
+    struct Configuration {
+        var aeTitle = "DICOM"
+        var node = "0.0.0.0"
+        var port = 11112
+        var directory: URL
+        var maxAssociations = 64
+        var maxPendingWritesPerAssociation = 8 // 한 연결이 쓰기 큐를 독차지하지 못하게 하는 상한
+        var writers = 4
+        var dimseTimeoutSeconds: UInt32 = 30
+        var artimTimeoutSeconds: UInt32 = 30
+        // C-MOVE/C-GET: 목적지 AE 타이틀 -> 주소, 목적지당 연결 수, 연결당 응답 없이 보낼 C-STORE 수, 미리 읽기
+        var moveDestinations: [String: MoveDestination] = [:]
+        var retrieveAssociations = 4
+        var retrieveWindow = 8
+        // C-GET: 요청한 연결로 응답 없이 보낼 C-STORE 수. 요청자가 받아들인 비동기 연산 창은 DicomheroAssociationSCP가
+        // 알려 주지 않으므로 확인할 수 없음. 요청자가 받아들이는 값을 알 때만 1보다 크게 설정 (기본은 동기 연산)
+        var getWindow = 1
+        var retrieveReaders = 2
+        var retrievePrefetch = 32
+        var progressInterval: TimeInterval = 0.1 // Pending 응답 사이 최소 간격
+    }
+
+    struct Statistics {
+        var acceptedAssociations = 0
+        var rejectedAssociations = 0
+        var activeAssociations = 0
+        var receivedInstances = 0
+        var answeredQueries = 0
+    }
+
+    // 저장을 받아들이는 SOP 클래스와 전송 구문 (WellKnownUID 목록에서 가져옴)
+    static let storageSOPClasses: [String] = [
+        WellKnownUID.ctImageStorage, WellKnownUID.enhancedCTImageStorage,
+        WellKnownUID.mrImageStorage, WellKnownUID.enhancedMRImageStorage,
+        WellKnownUID.secondaryCaptureImageStorage
+    ].map { WellKnownUID.string(for: $0) }
+
+    static let transferSyntaxes: [String] = [
+        WellKnownUID.explicitVRLittleEndian, WellKnownUID.implicitVRLittleEndian,
+        WellKnownUID.jpegBaseline, WellKnownUID.jpeg2000Lossless, WellKnownUID.jpeg2000, WellKnownUID.rleLossless
+    ].map { WellKnownUID.string(for: $0) }
+
+    // 카탈로그가 있을 때 받아들이는 검색 SOP 클래스
+    static let querySOPClasses: [String] = [
+        DicomheroUidStudyRootQueryRetrieveInformationModelFIND_1_2_840_10008_5_1_4_1_2_2_1,
+        DicomheroUidPatientRootQueryRetrieveInformationModelFIND_1_2_840_10008_5_1_4_1_2_1_1
+    ]
+
+    static let retrieveSOPClasses: [String] = [
+        DicomheroUidStudyRootQueryRetrieveInformationModelMOVE_1_2_840_10008_5_1_4_1_2_2_2,
+        DicomheroUidStudyRootQueryRetrieveInformationModelGET_1_2_840_10008_5_1_4_1_2_2_3,
+        DicomheroUidPatientRootQueryRetrieveInformationModelMOVE_1_2_840_10008_5_1_4_1_2_1_2,
+        DicomheroUidPatientRootQueryRetrieveInformationModelGET_1_2_840_10008_5_1_4_1_2_1_3
+    ]
+
+    // 저장 SOP 클래스는 C-GET 하위 연산을 위해 SCU/SCP 역할을 모두 받아들임
+    static func presentationContexts() -> DicomheroPresentationContexts {
+        let contexts = DicomheroPresentationContexts()
+        for abstractSyntax in storageSOPClasses + querySOPClasses + retrieveSOPClasses + [WellKnownUID.string(for: WellKnownUID.verification)] {
+            let context = storageSOPClasses.contains(abstractSyntax)
+                ? DicomheroPresentationContext(abstractSyntax: abstractSyntax, scuRole: true, scpRole: true)
+                : DicomheroPresentationContext(abstractSyntax: abstractSyntax)
+            transferSyntaxes.forEach { context.addTransferSyntax($0) }
+            contexts.addPresentationContext(context)
+        }
+        return contexts
+    }
+
+    let configuration: Configuration
+    let writeBehind: WriteBehindQueue
+    let catalogue: StudyCatalogue?
+    private let retrieve: RetrieveService?
+    private let lock = NSLock()
+    // worker 풀: 받은 연결 대기열과 worker 수 (connections로 보호)
+    private let connections = NSCondition()
+    private var waiting: [DicomheroTCPStream] = []
+    private var workers = 0
+    private var idleWorkers = 0
+    private var busyWorkers = 0
+    private var stopping = false
+    private var listener: DicomheroTCPListener?
+    private var statistics = Statistics()
+
+    // catalogue를 주면 저장된 인스턴스를 색인하고 C-FIND/C-MOVE/C-GET에 답함
+    init(configuration: Configuration, catalogue: StudyCatalogue? = nil) {
+        self.configuration = configuration
+        self.catalogue = catalogue
+        retrieve = catalogue.map { RetrieveService(configuration: configuration, catalogue: $0) }
+        writeBehind = WriteBehindQueue(directory: configuration.directory, writers: configuration.writers)
+    }
+
+    var currentStatistics: Statistics {
+        lock.lock()
+        defer { lock.unlock() }
+        return statistics
+    }
+
+    func start() throws {
+        let address = try DicomheroTCPPassiveAddress(node: configuration.node, service: String(configuration.port))
+        let listener = try DicomheroTCPListener(address: address)
+        self.listener = listener
+        connections.lock()
+        stopping = false
+        connections.unlock()
+        // 리스너가 끝날 때까지 스레드가 SCP를 잡고 있음 (stop()이 리스너를 끝내면 놓음)
+        let thread = Thread {
+            self.acceptLoop(listener)
+        }
+        thread.name = "StorageSCP.listener"
+        thread.start()
+    }
+
+    // 새 연결을 막고 남은 저장을 모두 끝냄 (진행 중인 연결은 상대가 해제할 때 끝나고, 쉬던 worker는 바로 끝남)
+    func stop() {
+        listener?.terminate()
+        listener = nil
+        connections.lock()
+        stopping = true
+        connections.broadcast()
+        connections.unlock()
+        writeBehind.flush()
+    }
+
+    private func acceptLoop(_ listener: DicomheroTCPListener) {
+        while true {
+            let stream: DicomheroTCPStream
+            do {
+                stream = try listener.waitForConnection()
+            } catch {
+                return // terminate() 호출
+            }
+            // 연결 수 상한을 넘으면 스트림을 바로 닫아 거절
+            connections.lock()
+            let accepted = waiting.count + busyWorkers < configuration.maxAssociations
+            if accepted {
+                waiting.append(stream)
+                if idleWorkers < waiting.count && workers < configuration.maxAssociations {
+                    startWorker(workers)
+                    workers += 1
+                }
+                connections.signal()
+            }
+            connections.unlock()
+            update {
+                $0.acceptedAssociations += accepted ? 1 : 0
+                $0.rejectedAssociations += accepted ? 0 : 1
+            }
+        }
+    }
+
+    private func startWorker(_ index: Int) {
+        let thread = Thread {
+            self.workLoop()
+        }
+        thread.name = "StorageSCP.worker.\(index)"
+        thread.start()
+    }
+
+    // 대기열에서 연결을 꺼내 상대가 해제할 때까지 처리하고 다음 연결을 기다림 (stop() 뒤 대기열이 비면 끝남)
+    private func workLoop() {
+        while true {
+            connections.lock()
+            idleWorkers += 1
+            while waiting.isEmpty && !stopping {
+                connections.wait()
+            }
+            idleWorkers -= 1
+            guard !waiting.isEmpty else {
+                workers -= 1
+                connections.unlock()
+                return
+            }
+            let stream = waiting.removeFirst()
+            busyWorkers += 1
+            connections.unlock()
+
+            update { $0.activeAssociations += 1 }
+            serve(input: stream.getStreamInput(), output: stream.getStreamOutput())
+            update { $0.activeAssociations -= 1 }
+            connections.lock()
+            busyWorkers -= 1
+            connections.unlock()
+        }
+    }
+
+    // 연결 하나를 상대가 해제할 때까지 처리 (호출한 스레드에서 돌아감)
+    // 리스너를 거치지 않는 프로세스 안 연결(DicomheroPipeStream 한 쌍)도 이것으로 처리함
+    // 저장 대기 중인 인스턴스의 응답이 모두 나간 뒤에 돌아옴
+    func serve(input: DicomheroBaseStreamInput, output: DicomheroBaseStreamOutput) {
+        let pending = DispatchSemaphore(value: configuration.maxPendingWritesPerAssociation)
+        defer {
+            // 남은 저장을 기다린 뒤 처음 값으로 되돌려 둠 (만든 값보다 작은 채로 해제되면 libdispatch가 멈춤)
+            for _ in 0..<configuration.maxPendingWritesPerAssociation {
+                pending.wait()
+            }
+            for _ in 0..<configuration.maxPendingWritesPerAssociation {
+                pending.signal()
+            }
+        }
+        do {
+            let reader = DicomheroStreamReader(inputStream: input)
+            let writer = DicomheroStreamWriter(outputStream: output)
+            let association = try DicomheroAssociationSCP(
+                thisAET: configuration.aeTitle,
+                maxInvokedOperations: UInt32(max(1, configuration.getWindow)),
+                maxPerformedOperations: UInt32(configuration.maxPendingWritesPerAssociation),
+                presentationContexts: StorageSCP.presentationContexts(),
+                reader: reader, writer: writer,
+                dimseTimeoutSeconds: configuration.dimseTimeoutSeconds,
+                artimTimeoutSeconds: configuration.artimTimeoutSeconds)
+            let service = DicomheroDimseService(association: association)
+
+            while true {
+                try autoreleasepool {
+                    let command = try service.getCommand()
+                    if let store = command as? DicomheroCStoreCommand {
+                        try receive(store, service: service, pending: pending)
+                    } else if let find = command as? DicomheroCFindCommand {
+                        try answer(find, service: service)
+                    } else if let move = command as? DicomheroCMoveCommand {
+                        if let retrieve {
+                            try retrieve.move(move, service: service)
+                        } else {
+                            try service.sendCommandOrResponse(DicomheroCMoveResponse(
+                                withcommand: move, responseCode: .unsupportedSOPClass,
+                                remainingSubOperations: 0, completedSubOperations: 0, failedSubOperations: 0, warningSubOperations: 0))
+                        }
+                    } else if let get = command as? DicomheroCGetCommand {
+                        if let retrieve {
+                            try retrieve.get(get, service: service)
+                        } else {
+                            try service.sendCommandOrResponse(DicomheroCGetResponse(
+                                withcommand: get, responseCode: .unsupportedSOPClass,
+                                remainingSubOperations: 0, completedSubOperations: 0, failedSubOperations: 0, warningSubOperations: 0))
+                        }
+                    } else if let echo = command as? DicomheroCEchoCommand {
+                        try service.sendCommandOrResponse(DicomheroCEchoResponse(withcommand: echo, responseCode: .success))
+                    } else if command is DicomheroCCancelCommand {
+                        // C-CANCEL에는 응답하지 않음 (조회는 한 번에 끝까지 답함)
+                    } else if let response = StorageSCP.unrecognizedOperationResponse(to: command) {
+                        try service.sendCommandOrResponse(response)
+                    }
+                }
+            }
+        } catch {
+            // 상대의 A-RELEASE, 연결 끊김, 타임아웃 모두 여기서 연결 처리를 끝냄
+        }
+    }
+
+    // 받은 인스턴스를 쓰기 지연 큐에 넣고, 저장이 끝나면 writer 큐에서 응답을 보냄
+    // (DicomheroDimseService.sendCommandOrResponse는 여러 스레드에서 불러도 됨)
+    private func receive(_ store: DicomheroCStoreCommand, service: DicomheroDimseService, pending: DispatchSemaphore) throws {
+        let payload = try store.getPayloadDataSet()
+        let instanceUID = try store.getAffectedSopInstanceUid()
+        // UID로 파일 이름을 만들므로 형식이 맞지 않으면 저장하지 않고 실패로 답함
+        guard UIDTable.isValid(instanceUID) else {
+            try service.sendCommandOrResponse(DicomheroCStoreResponse(withcommand: store, responseCode: .unableToProcess))
+            return
+        }
+        // 이 연결의 저장 대기 수가 상한이면 앞선 저장이 끝날 때까지 다음 명령을 받지 않음
+        pending.wait()
+        update { $0.receivedInstances += 1 }
+        // 파일이 디스크에 있어야 C-MOVE/C-GET으로 꺼낼 수 있으므로 저장이 끝난 뒤 색인함
+        let fileName = instanceUID + ".dcm"
+        writeBehind.enqueue(payload, fileName: fileName) { [catalogue] bytes in
+            if bytes != nil {
+                catalogue?.insert(dataSet: payload, fileName: fileName)
+            }
+            do {
+                try service.sendCommandOrResponse(DicomheroCStoreResponse(withcommand: store, responseCode: bytes != nil ? .success : .outOfResources))
+            } catch {
+                print("caught: \(error)")
+            }
+            pending.signal()
+        }
+    }
+
+    // 처리하지 않는 N-서비스 명령에는 Unrecognized Operation(0211H)으로 답함
+    private static func unrecognizedOperationResponse(to command: DicomheroDimseCommand) -> DicomheroDimseResponse? {
+        let status = DicomheroDimseStatusCode(rawValue: 0x0211) ?? .unableToProcess
+        switch command {
+        case let command as DicomheroNEventReportCommand: return DicomheroNEventReportResponse(withcommand: command, responseCode: status)
+        case let command as DicomheroNGetCommand: return DicomheroNGetResponse(withcommand: command, responseCode: status)
+        case let command as DicomheroNSetCommand: return DicomheroNSetResponse(withcommand: command, responseCode: status)
+        case let command as DicomheroNActionCommand: return DicomheroNActionResponse(withcommand: command, responseCode: status)
+        case let command as DicomheroNCreateCommand: return DicomheroNCreateResponse(withcommand: command, responseCode: status)
+        case let command as DicomheroNDeleteCommand: return DicomheroNDeleteResponse(withcommand: command, responseCode: status)
+        default: return nil
+        }
+    }
+
+    private static let nonTextVRs: Set<DicomheroTagType> = [.sq, .ob, .ow, .of, .od, .ol, .ov, .un, .sb]
+
+    // 일치 항목마다 pending 응답 하나, 마지막에 success 응답
+    // 응답에는 식별자에 있던 키만 채움 (카탈로그에 없는 키는 빈 값)
+    private func answer(_ find: DicomheroCFindCommand, service: DicomheroDimseService) throws {
+        guard let catalogue = catalogue else {
+            try service.sendCommandOrResponse(DicomheroCFindResponse(withcommand: find, responseCode: .unsupportedSOPClass))
+            return
+        }
+        let identifier = try find.getPayloadDataSet()
+        let query = CatalogueQuery(identifier: identifier)
+        // 시퀀스와 이진 VR 키는 문자열로 채울 수 없으므로 응답에 넣지 않음
+        let keys = (identifier.getTags() as? [DicomheroTagId] ?? []).compactMap { tag -> (tag: DicomheroTagId, rawValue: UInt32)? in
+            guard let vr = try? identifier.getDataType(tag), !StorageSCP.nonTextVRs.contains(vr) else {
+                return nil
+            }
+            return (tag, UInt32(tag.groupId) << 16 | UInt32(tag.tagId))
+        }
+        let transferSyntax = WellKnownUID.string(for: WellKnownUID.explicitVRLittleEndian)
+        for match in catalogue.search(query) {
+            try autoreleasepool {
+                let result = DicomheroDataSet(transferSyntax: transferSyntax)
+                for key in keys {
+                    // 값 하나를 쓰지 못해도 나머지 키와 다음 일치 항목은 계속 답함
+                    do {
+                        try result.setString(key.tag, newValue: catalogue.value(key.rawValue, for: match, level: query.level) ?? "")
+                    } catch {
+                        print("caught: \(error)")
+                    }
+                }
+                try service.sendCommandOrResponse(DicomheroCFindResponse(command: find, identifier: result))
+            }
+        }
+        update { $0.answeredQueries += 1 }
+        try service.sendCommandOrResponse(DicomheroCFindResponse(withcommand: find, responseCode: .success))
+    }
+
+    private func update(_ body: (inout Statistics) -> Void) {
+        lock.lock()
+        body(&statistics)
+        lock.unlock()
+    }
+}
+
+// 같은 인스턴스들을 여러 연결로 동시에 보내는 C-STORE SCU 부하 생성기
+enum StorageLoadGenerator {
+    struct Instance {
+        let url: URL
+        let dataSet: DicomheroDataSet
+        let sopClassUID: String
+        let sopInstanceUID: String
+    }
+
+    static func load(urls: [URL]) -> [Instance] {
+        urls.compactMap { url in
+            do {
+                let dataSet = try DicomheroCodecFactory.load(fromFile: url.path)
+                return Instance(
+                    url: url,
+                    dataSet: dataSet,
+                    sopClassUID: try dataSet.getString(DicomheroTagId(id: .enumSOPClassUID_0008_0016), elementNumber: 0),
+                    sopInstanceUID: try dataSet.getString(DicomheroTagId(id: .enumSOPInstanceUID_0008_0018), elementNumber: 0))
+            } catch {
+                print("caught: \(error)")
+                return nil
+            }
+        }
+    }
+
+    // associations개의 연결을 동시에 열어 각각 instancesPerAssociation개를 보냄. 성공한 C-STORE 수를 돌려줌
+    // 같은 데이터셋을 여러 번 보내므로 SOP Instance UID에 연결/순번을 붙여 SCP에 저장되는 인스턴스가 겹치지 않게 함
+    // 명령과 데이터셋의 UID가 같아야 하므로 연결마다 데이터셋을 새로 읽어 그 사본의 (0008,0018)을 고쳐서 보냄
+    static func send(_ instances: [Instance], node: String = "127.0.0.1", port: Int, calledAET: String,
+                     associations: Int, instancesPerAssociation: Int) -> Int {
+        guard !instances.isEmpty else { return 0 }
+        let group = DispatchGroup()
+        let lock = NSLock()
+        var stored = 0
+        for index in 0..<associations {
+            group.enter()
+            let thread = Thread {
+                let count = sendAssociation(instances, node: node, port: port, calledAET: calledAET,
+                                            association: index, count: instancesPerAssociation)
+                lock.lock()
+                stored += count
+                lock.unlock()
+                group.leave()
+            }
+            thread.name = "StorageLoadGenerator.\(index)"
+            thread.start()
+        }
+        group.wait()
+        return stored
+    }
+
+    private static func sendAssociation(_ instances: [Instance], node: String, port: Int, calledAET: String,
+                                        association index: Int, count: Int) -> Int {
+        var stored = 0
+        let copies = load(urls: instances.map(\.url))
+        guard !copies.isEmpty else { return 0 }
+        do {
+            let stream = try DicomheroTCPStream(address: DicomheroTCPActiveAddress(node: node, service: String(port)))
+            let association = try DicomheroAssociationSCU(
+                thisAET: "LOADGEN\(index)", otherAET: calledAET,
+                maxInvokedOperations: 1, maxPerformedOperations: 1,
+                presentationContexts: StorageSCP.presentationContexts(),
+                reader: DicomheroStreamReader(inputStream: stream.getStreamInput()),
+                writer: DicomheroStreamWriter(outputStream: stream.getStreamOutput()),
+                dimseTimeoutSeconds: 30)
+            let service = DicomheroDimseService(association: association)
+            for i in 0..<count {
+                try autoreleasepool {
+                    let instance = copies[i % copies.count]
+                    let instanceUID = "\(instance.sopInstanceUID).\(index).\(i)"
+                    // 응답을 받은 뒤 다음 전송을 하므로 같은 사본을 다시 고쳐 써도 됨
+                    try instance.dataSet.setString(DicomheroTagId(id: .enumSOPInstanceUID_0008_0018), newValue: instanceUID)
+                    let command = DicomheroCStoreCommand(
+                        abstractSyntax: instance.sopClassUID,
+                        messageID: service.getNextCommandID(),
+                        priority: .medium,
+                        affectedSopClassUid: instance.sopClassUID,
+                        affectedSopInstanceUid: instanceUID,
+                        originatorAET: "", originatorMessageID: 0,
+                        payload: instance.dataSet)
+                    try service.sendCommandOrResponse(command)
+                    if try service.getCStoreResponse(command).status == .success {
+                        stored += 1
+                    }
+                }
+            }
+            try association.release()
+        } catch {
+            print("caught: \(error)")
+        }
+        return stored
+    }
+}
+
+// 연결 수별 저장 처리량 (응답을 모두 받고 쓰기 지연 큐까지 비운 시점까지)
+struct StorageThroughput {
+    var associations = 0
+    var instances = 0
+    var bytes = 0
+    var seconds = 0.0
+
+    var instancesPerSecond: Double { seconds > 0 ? Double(instances) / seconds : 0 }
+    var megabytesPerSecond: Double { seconds > 0 ? Double(bytes) / seconds / 1_048_576 : 0 }
+}
+
+enum StorageBenchmark {
+    // 루프백으로 SCP를 띄우고 연결 수를 1에서 64까지 늘려 가며 측정
+    static func run(urls: [URL], associationCounts: [Int] = [1, 2, 4, 8, 16, 32, 64],
+                    instancesPerAssociation: Int = 32, port: Int = 11112) -> [StorageThroughput] {
+        let directory = FileManager.default.temporaryDirectory.appendingPathComponent("StorageBenchmark-\(UUID().uuidString)")
+        defer { try? FileManager.default.removeItem(at: directory) }
+        do {
+            try FileManager.default.createDirectory(at: directory, withIntermediateDirectories: true)
+        } catch {
+            print("caught: \(error)")
+            return []
+        }
+
+        let scp = StorageSCP(configuration: StorageSCP.Configuration(
+            port: port, directory: directory, maxAssociations: associationCounts.max() ?? 64))
+        do {
+            try scp.start()
+        } catch {
+            print("caught: \(error)")
+            return []
+        }
+        defer { scp.stop() }
+
+        let instances = StorageLoadGenerator.load(urls: urls)
+        var results: [StorageThroughput] = []
+        for associations in associationCounts {
+            scp.writeBehind.resetCounters()
+            let start = DispatchTime.now().uptimeNanoseconds
+            let stored = StorageLoadGenerator.send(instances, port: port, calledAET: scp.configuration.aeTitle,
+                                                   associations: associations,
+                                                   instancesPerAssociation: instancesPerAssociation)
+            scp.writeBehind.flush()
+            var result = StorageThroughput(associations: associations, instances: stored)
+            result.seconds = Double(DispatchTime.now().uptimeNanoseconds - start) / 1e9
+            result.bytes = scp.writeBehind.writtenBytes
+            results.append(result)
+        }
+        return results
+    }
+}
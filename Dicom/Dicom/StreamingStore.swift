@@ -0,0 +1,325 @@
+//
+//  StreamingStore.swift
+//  Dicom
+//
+//  Created by hanjongwoo on 10/19/26.
+//
+
+import Foundation
+import Darwin
+
+// 받은 데이터셋 앞에 붙이는 파일 메타 정보(그룹 0002, 명시적 VR 리틀 엔디언)
+enum DicomMetaHeader {
+    static func encode(sopClassUID: String, sopInstanceUID: String, transferSyntax: String, sourceAET: String) -> [UInt8] {
+        var elements = ByteWriter()
+        func element(_ element: UInt16, _ vr: String, _ value: [UInt8]) {
+            elements.uint16LE(0x0002)
+            elements.uint16LE(element)
+            elements.bytes.append(contentsOf: vr.utf8)
+            if vr == "OB" {
+                elements.uint16LE(0)
+                elements.uint32LE(UInt32(value.count))
+            } else {
+                elements.uint16LE(UInt16(value.count))
+            }
+            elements.bytes.append(contentsOf: value)
+        }
+        func padded(_ value: String, with padding: UInt8) -> [UInt8] {
+            var bytes = Array(value.utf8)
+            if bytes.count % 2 == 1 {
+                bytes.append(padding)
+            }
+            return bytes
+        }
+        element(0x0001, "OB", [0, 1])
+        element(0x0002, "UI", padded(sopClassUID, with: 0))
+        element(0x0003, "UI", padded(sopInstanceUID, with: 0))
+        element(0x0010, "UI", padded(transferSyntax, with: 0))
+        element(0x0012, "UI", padded(AssociationPDU.implementationClassUID, with: 0))
+        if !sourceAET.isEmpty {
+            element(0x0016, "AE", padded(sourceAET, with: 0x20))
+        }
+
+        var writer = ByteWriter()
+        writer.zeros(128)
+        writer.bytes.append(contentsOf: "DICM".utf8)
+        writer.uint16LE(0x0002)
+        writer.uint16LE(0x0000)
+        writer.bytes.append(contentsOf: "UL".utf8)
+        writer.uint16LE(4)
+        writer.uint32LE(UInt32(elements.bytes.count))
+        writer.bytes.append(contentsOf: elements.bytes)
+        return writer.bytes
+    }
+}
+
+// 조각으로 들어오는 데이터셋 바이트에서 지정한 최상위 태그의 값만 골라내는 스캐너
+// 나머지 값(픽셀 데이터 등)은 건너뛰기만 하고, 지정한 태그 중 가장 큰 태그를 지나면 더 보지 않음
+struct StreamingTagScanner {
+    let wanted: Set<UInt32>
+    let explicitVR: Bool
+    private let lastWanted: UInt32
+    private(set) var values: [UInt32: [UInt8]] = [:]
+    private(set) var isDone: Bool
+    private var header: [UInt8] = []
+    private var depth = 0          // 정의되지 않은 길이의 시퀀스/항목 안에 들어간 깊이
+    private var skipRemaining = 0
+    private var capturing: UInt32?
+    private var captureRemaining = 0
+
+    init(tags: Set<UInt32>, transferSyntax: String) {
+        wanted = tags
+        lastWanted = tags.max() ?? 0
+        explicitVR = transferSyntax != TransferSyntaxKind.implicitLittleEndian
+        // 압축된(deflate) 데이터셋은 풀지 않고 그대로 저장하므로 태그를 읽지 않음
+        isDone = tags.isEmpty || transferSyntax == TransferSyntaxKind.deflated
+        header.reserveCapacity(12)
+    }
+
+    mutating func consume(_ bytes: ArraySlice<UInt8>) {
+        var index = bytes.startIndex
+        while index < bytes.endIndex && !isDone {
+            if skipRemaining > 0 {
+                let count = min(skipRemaining, bytes.endIndex - index)
+                skipRemaining -= count
+                index += count
+            } else if let tag = capturing {
+                let count = min(captureRemaining, bytes.endIndex - index)
+                values[tag, default: []].append(contentsOf: bytes[index..<index + count])
+                captureRemaining -= count
+                index += count
+                if captureRemaining == 0 {
+                    capturing = nil
+                    isDone = values.count == wanted.count
+                }
+            } else {
+                header.append(bytes[index])
+                index += 1
+                if header.count >= 6, header.count == headerLength() {
+                    element()
+                    header.removeAll(keepingCapacity: true)
+                }
+            }
+        }
+    }
+
+    private var group: UInt16 { UInt16(header[0]) | UInt16(header[1]) << 8 }
+
+    private func headerLength() -> Int {
+        guard explicitVR && group != 0xFFFE else {
+            return 8
+        }
+        switch (header[4], header[5]) {
+        case (0x4F, _), (0x53, 0x51), (0x55, 0x43), (0x55, 0x52), (0x55, 0x54), (0x55, 0x4E), (0x53, 0x56), (0x55, 0x56):
+            return 12 // OB/OD/OF/OL/OV/OW, SQ, UC, UR, UT, UN, SV, UV
+        default:
+            return 8
+        }
+    }
+
+    private mutating func element() {
+        func uint32(at offset: Int) -> UInt32 {
+            UInt32(header[offset]) | UInt32(header[offset + 1]) << 8 | UInt32(header[offset + 2]) << 16 | UInt32(header[offset + 3]) << 24
+        }
+        let element = UInt16(header[2]) | UInt16(header[3]) << 8
+        let tag = UInt32(group) << 16 | UInt32(element)
+        let length: UInt32
+        if header.count == 12 {
+            length = uint32(at: 8)
+        } else if explicitVR && group != 0xFFFE {
+            length = UInt32(header[6]) | UInt32(header[7]) << 8
+        } else {
+            length = uint32(at: 4)
+        }
+        let undefined = length == 0xFFFF_FFFF
+
+        if group == 0xFFFE {
+            switch element {
+            case 0xE000: // 항목: 길이가 정해져 있으면 통째로 건너뜀
+                if undefined { depth += 1 } else { skipRemaining = Int(length) }
+            case 0xE00D, 0xE0DD: // 항목/시퀀스 끝
+                depth = max(0, depth - 1)
+            default:
+                break
+            }
+            return
+        }
+        if depth == 0 && tag > lastWanted {
+            isDone = true
+            return
+        }
+        if undefined {
+            depth += 1 // 정의되지 않은 길이의 시퀀스 또는 캡슐화된 픽셀 데이터
+        } else if depth == 0 && wanted.contains(tag) {
+            values[tag] = []
+            capturing = length > 0 ? tag : nil
+            captureRemaining = Int(length)
+            if length == 0 {
+                isDone = values.count == wanted.count
+            }
+        } else {
+            skipRemaining = Int(length)
+        }
+    }
+}
+
+// C-STORE 데이터셋을 메모리에 모으지 않고, 생성한 메타 헤더 뒤에 PDV 조각을 그대로 이어 써서 파일로 저장
+// 라우팅/색인에 쓸 몇 개 태그만 쓰는 도중에 읽으므로, 큰 다중 프레임 객체도 일정한 메모리로 받음
+final class StreamingStoreReceiver {
+    struct StoredInstance {
+        let url: URL
+        let sopClassUID: String
+        let sopInstanceUID: String
+        let transferSyntax: String
+        let callingAET: String
+        let bytes: Int
+        let values: [UInt32: [UInt8]] // 선택한 태그의 원시 값
+
+        func string(_ tag: DicomheroTagEnum) -> String? {
+            values[tag.rawValue].map { String.trimmedDicom($0[...]) }
+        }
+    }
+
+    static let defaultTags: [DicomheroTagEnum] = [
+        .enumPatientID_0010_0020, .enumStudyInstanceUID_0020_000D,
+        .enumSeriesInstanceUID_0020_000E, .enumModality_0008_0060
+    ]
+
+    let directory: URL
+    let tags: Set<UInt32>
+    // 파일을 다 쓴 뒤 워커 큐에서 호출됨
+    var onStored: ((StoredInstance) -> Void)?
+
+    init(directory: URL, tags: [DicomheroTagEnum] = StreamingStoreReceiver.defaultTags) {
+        self.directory = directory
+        self.tags = Set(tags.map { $0.rawValue })
+    }
+
+    // AssociationMultiplexer의 payloadStreams로 넘김
+    func makeStream(_ command: DimseCommandSet, _ context: AssociationMultiplexer.NegotiatedContext) -> AssociationMultiplexer.PayloadStream? {
+        guard command.command == DimseCommandSet.cStoreRequest,
+              let sopInstanceUID = command.string(DimseCommandSet.affectedSOPInstanceUID) else {
+            return nil
+        }
+        let sopClassUID = command.string(DimseCommandSet.affectedSOPClassUID) ?? context.abstractSyntax
+        // UID로 파일 이름을 만들므로 형식이 맞지 않으면 받은 바이트는 버리고 처리 불가로 응답
+        guard UIDTable.isValid(sopInstanceUID) else {
+            return AssociationMultiplexer.PayloadStream(append: { _ in }, finish: { 0xC000 }, abort: {})
+        }
+        let partial = directory.appendingPathComponent(".\(UUID().uuidString).part")
+        let fd = open(partial.path, O_WRONLY | O_CREAT | O_TRUNC, 0o644)
+        guard fd >= 0 else {
+            print("caught: \(SocketError.system("open", errno))")
+            return nil
+        }
+        var scanner = StreamingTagScanner(tags: tags, transferSyntax: context.transferSyntax)
+        var written = 0
+        var failed = false
+
+        func write(_ bytes: ArraySlice<UInt8>) {
+            bytes.withUnsafeBytes { buffer in
+                var offset = 0
+                while offset < buffer.count && !failed {
+                    let count = Darwin.write(fd, buffer.baseAddress! + offset, buffer.count - offset)
+                    if count > 0 {
+                        offset += count
+                    } else if count < 0 && errno == EINTR {
+                        continue
+                    } else {
+                        failed = true // 0바이트 쓰기도 진행이 없으므로 실패로 봄
+                    }
+                }
+            }
+            written += bytes.count
+        }
+        write(DicomMetaHeader.encode(sopClassUID: sopClassUID, sopInstanceUID: sopInstanceUID,
+                                     transferSyntax: context.transferSyntax, sourceAET: context.callingAET)[...])
+
+        return AssociationMultiplexer.PayloadStream(
+            append: { bytes in
+                scanner.consume(bytes)
+                write(bytes)
+            },
+            finish: { [weak self] in
+                let closed = close(fd) == 0
+                let url = self?.directory.appendingPathComponent(sopInstanceUID + ".dcm")
+                guard let url, !failed, closed, rename(partial.path, url.path) == 0 else {
+                    unlink(partial.path)
+                    return 0xA700 // 자원 부족
+                }
+                self?.onStored?(StoredInstance(
+                    url: url, sopClassUID: sopClassUID, sopInstanceUID: sopInstanceUID,
+                    transferSyntax: context.transferSyntax, callingAET: context.callingAET,
+                    bytes: written, values: scanner.values))
+                return 0
+            },
+            abort: {
+                close(fd)
+                unlink(partial.path)
+            })
+    }
+}
+
+// 같은 인스턴스들을 데이터셋으로 받는 기존 SCP와 파일로 흘려 쓰는 SCP로 받아 처리량과 최대 메모리를 비교
+struct StreamingStoreMeasurement {
+    var model = ""
+    var result = BulkStoreSender.Result()
+    var peakFootprintBytes = 0
+}
+
+enum StreamingStoreBenchmark {
+    static func run(urls: [URL], instanceCount: Int = 500, port: Int = 11116) -> [StreamingStoreMeasurement] {
+        let directory = FileManager.default.temporaryDirectory.appendingPathComponent("StreamingStore-\(UUID().uuidString)")
+        defer { try? FileManager.default.removeItem(at: directory) }
+        do {
+            try FileManager.default.createDirectory(at: directory, withIntermediateDirectories: true)
+        } catch {
+            print("caught: \(error)")
+            return []
+        }
+
+        let materialized = StorageSCP(configuration: StorageSCP.Configuration(port: port, directory: directory))
+        let receiver = StreamingStoreReceiver(directory: directory)
+        let streaming = AssociationMultiplexer(
+            configuration: AssociationMultiplexer.Configuration(port: port + 1, maxPDULength: 1 << 20),
+            payloadStreams: receiver.makeStream)
+        return [
+            measure(model: "materialized dataset", urls: urls, count: instanceCount, port: port,
+                    start: { try materialized.start() }, stop: { materialized.stop() }),
+            measure(model: "streamed to disk", urls: urls, count: instanceCount, port: port + 1,
+                    start: { try streaming.start() }, stop: { streaming.stop() })
+        ]
+    }
+
+    private static func measure(model: String, urls: [URL], count: Int, port: Int,
+                                start: () throws -> Void, stop: () -> Void) -> StreamingStoreMeasurement {
+        var measurement = StreamingStoreMeasurement(model: model)
+        do {
+            try start()
+        } catch {
+            print("caught: \(error)")
+            return measurement
+        }
+        // 전송하는 동안 phys_footprint 최댓값을 기록
+        let sampler = DispatchSource.makeTimerSource(queue: DispatchQueue(label: "StreamingStoreBenchmark.sampler"))
+        let lock = NSLock()
+        var peak = 0
+        sampler.schedule(deadline: .now(), repeating: .milliseconds(10))
+        sampler.setEventHandler {
+            let footprint = MultiplexerBenchmark.physicalFootprint()
+            lock.lock()
+            peak = max(peak, footprint)
+            lock.unlock()
+        }
+        sampler.resume()
+
+        let sender = BulkStoreSender(configuration: BulkStoreSender.Configuration(port: port, associations: 4, window: 8))
+        measurement.result = sender.send(urls: urls, count: count)
+        stop()
+        sampler.cancel()
+        lock.lock()
+        measurement.peakFootprintBytes = peak
+        lock.unlock()
+        return measurement
+    }
+}
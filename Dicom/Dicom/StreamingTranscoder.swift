@@ -0,0 +1,803 @@
+//
+//  StreamingTranscoder.swift
+//  Dicom
+//
+//  Created by hanjongwoo on 10/19/26.
+//
+
+import Foundation
+
+enum TranscodeError: Error {
+    case unsupportedTransferSyntax(String)
+    case missingPixelData
+    case noPresentationContext(String)
+}
+
+// 전송 구문 분류 (빅 엔디언은 다루지 않음)
+enum TransferSyntaxKind {
+    static let implicitLittleEndian = WellKnownUID.string(for: WellKnownUID.implicitVRLittleEndian)
+    static let explicitLittleEndian = WellKnownUID.string(for: WellKnownUID.explicitVRLittleEndian)
+    static let deflated = WellKnownUID.string(for: WellKnownUID.deflatedExplicitVRLittleEndian)
+    static let jpegLossless = DicomheroUidJPEGLosslessNonHierarchicalFirstOrderPredictionProcess14SelectionValue1_1_2_840_10008_1_2_4_70
+
+    static func isNative(_ uid: String) -> Bool {
+        uid == implicitLittleEndian || uid == explicitLittleEndian
+    }
+
+    static func isSupported(_ uid: String) -> Bool {
+        uid != deflated && uid != DicomheroUidExplicitVRBigEndian_1_2_840_10008_1_2_2
+    }
+
+    static func isLossy(_ uid: String) -> Bool {
+        uid == WellKnownUID.string(for: WellKnownUID.jpegBaseline) || uid == WellKnownUID.string(for: WellKnownUID.jpeg2000)
+    }
+}
+
+// 라이브러리 DIMSE로 보내는 데이터셋(BulkStoreSender, C-MOVE, C-GET)을 상대와 협상된 전송 구문에 맞춤
+// 비압축끼리는 라이브러리가 보낼 때 협상된 VR 방식으로 쓰므로 그대로 두고,
+// 한쪽이라도 압축이면 프레임을 모두 디코드한 뒤 협상된 구문으로 다시 넣음. 바꿨으면 true
+enum DataSetTranscoder {
+    static func conform(_ dataSet: DicomheroDataSet, to target: String,
+                        quality: DicomheroImageQuality = .veryHigh) throws -> Bool {
+        let transferSyntaxTag = DicomheroTagId(id: .enumTransferSyntaxUID_0002_0010)
+        let source = try dataSet.getString(transferSyntaxTag, elementNumber: 0, defaultValue: TransferSyntaxKind.implicitLittleEndian)
+        guard source != target && !(TransferSyntaxKind.isNative(source) && TransferSyntaxKind.isNative(target)) else {
+            return false
+        }
+        guard TransferSyntaxKind.isSupported(source) && TransferSyntaxKind.isSupported(target) else {
+            throw TranscodeError.unsupportedTransferSyntax(TransferSyntaxKind.isSupported(target) ? source : target)
+        }
+        let numberOfFrames = try dataSet.getString(DicomheroTagId(id: .enumNumberOfFrames_0028_0008), elementNumber: 0, defaultValue: "1")
+        let frames = max(1, Int(numberOfFrames.trimmingCharacters(in: .whitespaces)) ?? 1)
+        // 새 구문으로 넣기 시작하면 원래 픽셀 데이터가 바뀌므로 먼저 모든 프레임을 디코드해 둠
+        let images = try (0..<frames).map { try dataSet.getImage(UInt32($0)) }
+        try dataSet.setString(transferSyntaxTag, newValue: target)
+        for (frame, image) in images.enumerated() {
+            try dataSet.setImage(UInt32(frame), image: image, quality: quality)
+        }
+        if TransferSyntaxKind.isLossy(target) {
+            try dataSet.setString(DicomheroTagId(id: .enumLossyImageCompression_0028_2110), newValue: "01")
+        }
+        return true
+    }
+}
+
+// 픽셀 데이터 앞의 데이터셋 요소를 다른 VR 방식(암시적/명시적 리틀 엔디언)으로 다시 씀
+// 값 바이트는 그대로 두고, 시퀀스와 항목은 길이를 다시 계산하지 않도록 정의되지 않은 길이와 구분자로 씀
+struct DataSetReencoder {
+    static let undefinedLength: UInt32 = 0xFFFFFFFF
+    static let un: UInt16 = 0x554E
+    static let cs: UInt16 = 0x4353
+
+    let explicitIn: Bool
+    let explicitOut: Bool
+
+    // OB/OD/OF/OL/OV/OW, SQ, UC, UR, UT, UN, SV, UV는 4바이트 길이
+    static func hasLongLength(_ vr: UInt16) -> Bool {
+        switch vr {
+        case ValueRepresentation.sq, ValueRepresentation.sv, ValueRepresentation.uv,
+             0x5543, 0x5552, 0x5554, un:
+            return true
+        default:
+            return vr >> 8 == 0x4F
+        }
+    }
+
+    // 최상위 요소를 (태그, 다시 쓴 바이트)로 나눔. 픽셀 데이터 태그에서 멈추고 그 위치를 돌려줌
+    // stopAtPixelData가 false면 끝까지 나눔 (픽셀 데이터 뒤에 오는 요소)
+    func topLevel(_ bytes: ArraySlice<UInt8>,
+                  stopAtPixelData: Bool = true) throws -> (elements: [(tag: UInt32, bytes: [UInt8])], pixelDataIndex: Int?) {
+        var reader = ByteReader(bytes)
+        var elements: [(tag: UInt32, bytes: [UInt8])] = []
+        while bytes.endIndex - reader.index >= 4 {
+            let i = reader.index
+            let tag = UInt32(bytes[i + 1]) << 24 | UInt32(bytes[i]) << 16 | UInt32(bytes[i + 3]) << 8 | UInt32(bytes[i + 2])
+            if stopAtPixelData && tag >= 0x7FE0_0010 {
+                return (elements, tag == 0x7FE0_0010 ? i : nil)
+            }
+            var writer = ByteWriter()
+            try element(&reader, into: &writer)
+            elements.append((tag, writer.bytes))
+        }
+        return (elements, nil)
+    }
+
+    func header(_ writer: inout ByteWriter, tag: UInt32, vr: UInt16, length: UInt32) {
+        writer.uint16LE(UInt16(tag >> 16))
+        writer.uint16LE(UInt16(tag & 0xFFFF))
+        guard explicitOut else {
+            writer.uint32LE(length)
+            return
+        }
+        writer.uint16BE(vr)
+        if DataSetReencoder.hasLongLength(vr) {
+            writer.uint16LE(0)
+            writer.uint32LE(length)
+        } else {
+            writer.uint16LE(UInt16(length))
+        }
+    }
+
+    // 값 하나를 짝수 길이로 맞춰 씀 (문자열은 공백, 그 밖은 NUL)
+    func encode(tag: UInt32, vr: UInt16, value: [UInt8]) -> [UInt8] {
+        var writer = ByteWriter()
+        let padded = value.count % 2 == 0 ? value : value + [vr == DataSetReencoder.cs ? 0x20 : 0]
+        header(&writer, tag: tag, vr: vr, length: UInt32(padded.count))
+        writer.bytes.append(contentsOf: padded)
+        return writer.bytes
+    }
+
+    private func element(_ reader: inout ByteReader, into writer: inout ByteWriter) throws {
+        let tag = UInt32(try reader.uint16LE()) << 16 | UInt32(try reader.uint16LE())
+        var vr: UInt16
+        let length: UInt32
+        if explicitIn {
+            vr = try reader.uint16BE()
+            if DataSetReencoder.hasLongLength(vr) {
+                _ = try reader.take(2)
+                length = try reader.uint32LE()
+            } else {
+                length = UInt32(try reader.uint16LE())
+            }
+        } else {
+            length = try reader.uint32LE()
+            vr = length == DataSetReencoder.undefinedLength ? ValueRepresentation.sq : DataSetReencoder.dictionaryVR(tag)
+        }
+        if vr == ValueRepresentation.sq {
+            header(&writer, tag: tag, vr: vr, length: DataSetReencoder.undefinedLength)
+            try sequence(&reader, length: length, into: &writer)
+            writer.uint16LE(0xFFFE)
+            writer.uint16LE(0xE0DD)
+            writer.uint32LE(0)
+            return
+        }
+        guard length != DataSetReencoder.undefinedLength else {
+            throw PDUError.malformed("undefined length outside a sequence")
+        }
+        let value = try reader.take(Int(length))
+        if explicitOut && !DataSetReencoder.hasLongLength(vr) && length > 0xFFFF {
+            vr = DataSetReencoder.un
+        }
+        header(&writer, tag: tag, vr: vr, length: length)
+        writer.bytes.append(contentsOf: value)
+    }
+
+    private func sequence(_ reader: inout ByteReader, length: UInt32, into writer: inout ByteWriter) throws {
+        let end = length == DataSetReencoder.undefinedLength ? nil : reader.index + Int(length)
+        while end.map({ reader.index < $0 }) ?? true {
+            let group = try reader.uint16LE(), element = try reader.uint16LE()
+            let itemLength = try reader.uint32LE()
+            if group == 0xFFFE && element == 0xE0DD {
+                return
+            }
+            guard group == 0xFFFE && element == 0xE000 else {
+                throw PDUError.malformed("expected a sequence item")
+            }
+            writer.uint16LE(0xFFFE)
+            writer.uint16LE(0xE000)
+            writer.uint32LE(DataSetReencoder.undefinedLength)
+            let itemEnd = itemLength == DataSetReencoder.undefinedLength ? nil : reader.index + Int(itemLength)
+            while itemEnd.map({ reader.index < $0 }) ?? true {
+                if itemEnd == nil && reader.bytes[reader.index...].starts(with: [0xFE, 0xFF, 0x0D, 0xE0]) {
+                    _ = try reader.take(8)
+                    break
+                }
+                try self.element(&reader, into: &writer)
+            }
+            writer.uint16LE(0xFFFE)
+            writer.uint16LE(0xE00D)
+            writer.uint32LE(0)
+        }
+    }
+
+    // 암시적 VR 입력: 사전에서 VR을 찾고, 모르는 태그(사설 태그 등)는 UN
+    static func dictionaryVR(_ tag: UInt32) -> UInt16 {
+        if tag & 0xFFFF == 0 {
+            return ValueRepresentation.ul
+        }
+        let tagId = DicomheroTagId(group: UInt16(tag >> 16), tag: UInt16(tag & 0xFFFF))
+        return (try? DicomheroDicomDictionary.getTagType(tagId).rawValue) ?? un
+    }
+}
+
+// 프레임을 여러 worker가 앞서 변환해 두고, 네트워크 쪽은 순서대로 꺼내 감
+// 꺼내 간 프레임보다 lookahead개 넘게 앞서 나가지 않으므로 메모리에는 변환된 프레임 몇 개만 남음
+final class FramePipeline<Frame> {
+    private let condition = NSCondition()
+    private let frameCount: Int
+    private let lookahead: Int
+    private var ready: [Int: Result<Frame, Error>] = [:]
+    private var nextFrame = 0
+    private var consumed = 0
+    private var cancelled = false
+
+    // transcode는 여러 worker가 동시에 부름 (원본 데이터셋은 모든 worker가 함께 읽음)
+    init(frameCount: Int, workers: Int, lookahead: Int, transcode: @escaping (Int) throws -> Frame) {
+        self.frameCount = frameCount
+        self.lookahead = max(1, lookahead)
+        for _ in 0..<max(1, min(workers, frameCount)) {
+            DispatchQueue.global(qos: .userInitiated).async {
+                self.work(transcode)
+            }
+        }
+    }
+
+    private func work(_ transcode: (Int) throws -> Frame) {
+        while true {
+            condition.lock()
+            while !cancelled && nextFrame < frameCount && nextFrame >= consumed + lookahead {
+                condition.wait()
+            }
+            guard !cancelled && nextFrame < frameCount else {
+                condition.unlock()
+                return
+            }
+            let index = nextFrame
+            nextFrame += 1
+            condition.unlock()
+
+            let result = Result { try autoreleasepool { try transcode(index) } }
+            condition.lock()
+            ready[index] = result
+            condition.broadcast()
+            condition.unlock()
+        }
+    }
+
+    func frame(_ index: Int) throws -> Frame {
+        condition.lock()
+        defer { condition.unlock() }
+        // worker의 오류는 그 프레임의 결과로 담겨 있다가 여기서 던져짐
+        while ready[index] == nil {
+            condition.wait()
+        }
+        consumed = index + 1
+        condition.broadcast()
+        return try ready.removeValue(forKey: index)!.get()
+    }
+
+    func cancel() {
+        condition.lock()
+        cancelled = true
+        condition.broadcast()
+        condition.unlock()
+    }
+}
+
+// 데이터셋 바이트를 받는 대로 최대 PDU 길이 단위의 P-DATA-TF로 내보냄 (객체 전체를 모으지 않음)
+// scatterGather면 PDU마다 12바이트 머리만 따로 만들고, 큰 영역(픽셀 데이터)은 복사 없이 가리킨 채 writev로 씀
+// 짧은 요소 머리 등은 한 조각 크기의 버퍼에 모았다가 다음 PDU의 앞부분이 됨
+final class DataSetPDVStream {
+    private static let headerLength = 12 // PDU 머리 6 + PDV 길이 4 + 컨텍스트 ID 1 + 제어 헤더 1
+    private static let pdusPerWrite = 256
+
+    private let client: SimpleAssociationClient
+    private let contextID: UInt8
+    private let fragment: Int
+    private let scatterGather: Bool
+    private var pending: [UInt8] = []
+    private let staging: UnsafeMutableRawBufferPointer // 모아 둔 바이트 (writev가 가리키므로 주소가 바뀌지 않아야 함)
+    private var stagedCount = 0
+    private let headers: UnsafeMutableRawBufferPointer
+    private let vectors: UnsafeMutableBufferPointer<iovec>
+    private var vectorCount = 0
+    private var headerCount = 0
+    private(set) var sentBytes = 0
+    private(set) var pdus = 0
+    private(set) var systemCalls = 0
+
+    init(client: SimpleAssociationClient, contextID: UInt8, scatterGather: Bool = true) {
+        self.client = client
+        self.contextID = contextID
+        self.scatterGather = scatterGather
+        // PDV 머리(6바이트)를 뺀 만큼씩 나눔. 상대가 0(제한 없음)을 보냈으면 기본 16KB 단위로 보냄
+        // (1~6은 associate가 받아들이지 않으므로 여기에 오지 않음)
+        let maxPDULength = Int(client.accepted?.maxPDULength ?? 16384)
+        fragment = maxPDULength == 0 ? 16384 - 6 : maxPDULength - 6
+        staging = .allocate(byteCount: scatterGather ? fragment : 0, alignment: 16)
+        headers = .allocate(byteCount: scatterGather ? DataSetPDVStream.pdusPerWrite * DataSetPDVStream.headerLength : 0, alignment: 4)
+        vectors = .allocate(capacity: scatterGather ? min(Sockets.maxVectors, DataSetPDVStream.pdusPerWrite * 3) : 0)
+        if !scatterGather {
+            pending.reserveCapacity(fragment * 2)
+        }
+    }
+
+    deinit {
+        staging.deallocate()
+        headers.deallocate()
+        vectors.deallocate()
+    }
+
+    func write<Bytes: Collection>(_ bytes: Bytes) throws where Bytes.Element == UInt8 {
+        sentBytes += bytes.count
+        guard scatterGather else {
+            pending.append(contentsOf: bytes)
+            var offset = 0
+            while pending.count - offset > fragment {
+                try client.write(PDataTransfer.pdu(contextID: contextID, pending[offset..<offset + fragment], isCommand: false, isLast: false))
+                offset += fragment
+                pdus += 1
+                systemCalls += 1
+            }
+            pending.removeFirst(offset)
+            return
+        }
+        var index = bytes.startIndex
+        while index != bytes.endIndex {
+            // 가득 찬 버퍼는 뒤에 바이트가 더 올 때에만 마지막이 아닌 PDU로 내보냄
+            if stagedCount == fragment {
+                try frame(isLast: false, (stagingStart, fragment))
+                try flush()
+                stagedCount = 0
+            }
+            let end = bytes.index(index, offsetBy: fragment - stagedCount, limitedBy: bytes.endIndex) ?? bytes.endIndex
+            UnsafeMutableRawBufferPointer(rebasing: staging[stagedCount...]).copyBytes(from: bytes[index..<end])
+            stagedCount += bytes.distance(from: index, to: end)
+            index = end
+        }
+    }
+
+    // region은 돌아오기 전에 모두 소켓에 쓰므로 호출한 쪽은 바로 메모리를 풀거나 매핑을 닫아도 됨
+    func write(region: UnsafeRawBufferPointer) throws {
+        guard scatterGather && region.count >= fragment, let base = region.baseAddress else {
+            try write(region)
+            return
+        }
+        var offset = 0
+        if stagedCount > 0 {
+            offset = fragment - stagedCount
+            try frame(isLast: false, (stagingStart, stagedCount), (base, offset))
+        }
+        // 끝부분(1바이트 이상)은 남겨서 finish가 마지막 PDU로 보내게 함
+        while region.count - offset > fragment {
+            try frame(isLast: false, (base + offset, fragment))
+            offset += fragment
+        }
+        try flush()
+        stagedCount = 0
+        sentBytes += offset
+        try write(UnsafeRawBufferPointer(rebasing: region[offset...]))
+    }
+
+    func finish() throws {
+        guard scatterGather else {
+            try client.write(PDataTransfer.pdu(contextID: contextID, pending[...], isCommand: false, isLast: true))
+            pending.removeAll(keepingCapacity: true)
+            pdus += 1
+            systemCalls += 1
+            return
+        }
+        try frame(isLast: true, (stagingStart, stagedCount))
+        try flush()
+        stagedCount = 0
+    }
+
+    private var stagingStart: UnsafeRawPointer {
+        UnsafeRawPointer(staging.baseAddress!)
+    }
+
+    // PDU 하나의 머리를 만들고 머리와 내용 조각들을 iovec으로 이어 붙임
+    private func frame(isLast: Bool, _ parts: (UnsafeRawPointer, Int)...) throws {
+        if headerCount == DataSetPDVStream.pdusPerWrite || vectorCount + parts.count + 1 > vectors.count {
+            try flush()
+        }
+        let length = parts.reduce(0) { $0 + $1.1 }
+        let header = headers.baseAddress! + headerCount * DataSetPDVStream.headerLength
+        let fields: [UInt8] = [0x04, 0] + bigEndian(UInt32(length + 6)) + bigEndian(UInt32(length + 2)) + [contextID, isLast ? 0x02 : 0x00]
+        UnsafeMutableRawBufferPointer(start: header, count: DataSetPDVStream.headerLength).copyBytes(from: fields)
+        vectors[vectorCount] = iovec(iov_base: header, iov_len: DataSetPDVStream.headerLength)
+        vectorCount += 1
+        headerCount += 1
+        for (start, count) in parts where count > 0 {
+            vectors[vectorCount] = iovec(iov_base: UnsafeMutableRawPointer(mutating: start), iov_len: count)
+            vectorCount += 1
+        }
+        pdus += 1
+    }
+
+    private func flush() throws {
+        guard vectorCount > 0 else { return }
+        systemCalls += try Sockets.writeAll(client.fd, UnsafeMutableBufferPointer(rebasing: vectors[0..<vectorCount]))
+        vectorCount = 0
+        headerCount = 0
+    }
+
+    private func bigEndian(_ value: UInt32) -> [UInt8] {
+        [UInt8(value >> 24), UInt8(value >> 16 & 0xFF), UInt8(value >> 8 & 0xFF), UInt8(value & 0xFF)]
+    }
+}
+
+// 상대가 받아들인 전송 구문이 저장된 것과 다르면 보내면서 프레임 단위로 변환하는 C-STORE SCU
+// - 같으면 파일의 데이터셋 바이트를 그대로 흘려 보냄
+// - 둘 다 비압축이면 머리 요소의 VR 방식만 바꾸고 픽셀 바이트는 파일에서 그대로 복사
+// - 그 밖에는 프레임마다 디코드/인코드를 병렬로 미리 해 두고, 변환된 프레임 순서대로 조각(item)을 씀
+final class TranscodingStoreSender {
+    struct Configuration {
+        var node = "127.0.0.1"
+        var port = 11112
+        var callingAET = "DICOMAPP"
+        var calledAET = "DICOM"
+        // 선호 순서대로 제안하는 전송 구문 (상대가 이 중 하나를 고름)
+        var transferSyntaxes = [DicomheroUidRLELossless_1_2_840_10008_1_2_5, TransferSyntaxKind.explicitLittleEndian]
+        var quality = DicomheroImageQuality.veryHigh
+        var workers = ProcessInfo.processInfo.activeProcessorCount
+        var lookahead = 8
+        var maxPDULength: UInt32 = 1 << 20
+        var scatterGather = true // false면 PDU마다 조각을 복사해 만드는 기존 방식
+    }
+
+    struct Result {
+        var requested = 0
+        var stored = 0
+        var transcoded = 0
+        var skipped = 0 // 보내기 전에 걸러진 인스턴스 (맞는 프레젠테이션 컨텍스트나 전송 구문이 없음)
+        var fileBytes = 0
+        var sentBytes = 0
+        var pdus = 0
+        var systemCalls = 0
+        var seconds = 0.0
+
+        var instancesPerSecond: Double { seconds > 0 ? Double(stored) / seconds : 0 }
+        var sentMegabytesPerSecond: Double { seconds > 0 ? Double(sentBytes) / seconds / 1_048_576 : 0 }
+    }
+
+    private struct Instance {
+        let url: URL
+        let sopClassUID: String
+        let sopInstanceUID: String
+        let transferSyntax: String
+        let frames: Int
+        let bitsAllocated: Int
+        let fileSize: Int
+    }
+
+    private struct TranscodedFrame {
+        var fragments: [[UInt8]]
+        var pixelModule: [UInt32: [UInt8]] = [:] // 첫 프레임에만: 바뀐 픽셀 모듈 요소 (인코딩된 바이트)
+    }
+
+    private static let pixelDataTag: UInt32 = 0x7FE0_0010
+
+    let configuration: Configuration
+
+    init(configuration: Configuration) {
+        self.configuration = configuration
+    }
+
+    func send(urls: [URL]) -> Result {
+        var result = Result(requested: urls.count)
+        let instances = urls.compactMap(TranscodingStoreSender.inspect)
+        let sopClasses = Array(Set(instances.map(\.sopClassUID))).sorted()
+        let start = DispatchTime.now().uptimeNanoseconds
+        do {
+            let client = try SimpleAssociationClient(node: configuration.node, port: configuration.port)
+            try client.associate(callingAET: configuration.callingAET, calledAET: configuration.calledAET,
+                                 abstractSyntaxes: sopClasses, transferSyntaxes: configuration.transferSyntaxes,
+                                 maxPDULength: configuration.maxPDULength)
+            for instance in instances {
+                do {
+                    let sent = try store(instance, client: client, proposed: sopClasses)
+                    result.stored += sent.status == 0 ? 1 : 0
+                    result.transcoded += sent.transcoded ? 1 : 0
+                    result.fileBytes += instance.fileSize
+                    result.sentBytes += sent.stream.sentBytes
+                    result.pdus += sent.stream.pdus
+                    result.systemCalls += sent.stream.systemCalls
+                } catch TranscodeError.noPresentationContext, TranscodeError.unsupportedTransferSyntax {
+                    // 바이트를 보내기 전에 던져지므로 연결은 그대로 쓸 수 있음
+                    result.skipped += 1
+                }
+            }
+            try client.release()
+        } catch {
+            print("caught: \(error)")
+        }
+        result.seconds = Double(DispatchTime.now().uptimeNanoseconds - start) / 1e9
+        return result
+    }
+
+    private static func inspect(_ url: URL) -> Instance? {
+        do {
+            // 큰 태그(픽셀 데이터)는 읽지 않고 파일에 남겨 둠
+            let dataSet = try DicomheroCodecFactory.load(fromFileMaxSize: url.path, maxBufferSize: 4096)
+            func string(_ tag: DicomheroTagEnum) throws -> String {
+                try dataSet.getString(DicomheroTagId(id: tag), elementNumber: 0, defaultValue: "")
+            }
+            return Instance(
+                url: url,
+                sopClassUID: try string(.enumSOPClassUID_0008_0016),
+                sopInstanceUID: try string(.enumSOPInstanceUID_0008_0018),
+                transferSyntax: try string(.enumTransferSyntaxUID_0002_0010),
+                frames: max(1, Int(try string(.enumNumberOfFrames_0028_0008)) ?? 1),
+                bitsAllocated: Int(try dataSet.getUint32(DicomheroTagId(id: .enumBitsAllocated_0028_0100), elementNumber: 0, defaultValue: 16)),
+                fileSize: (try? url.resourceValues(forKeys: [.fileSizeKey]).fileSize) ?? 0)
+        } catch {
+            print("caught: \(error)")
+            return nil
+        }
+    }
+
+    private func store(_ instance: Instance, client: SimpleAssociationClient,
+                       proposed: [String]) throws -> (status: UInt16, transcoded: Bool, stream: DataSetPDVStream) {
+        guard let contextID = client.contextID(for: instance.sopClassUID, proposed: proposed),
+              let target = client.accepted?.presentationContexts.first(where: { $0.id == contextID })?.transferSyntaxes.first else {
+            throw TranscodeError.noPresentationContext(instance.sopClassUID)
+        }
+        guard TransferSyntaxKind.isSupported(instance.transferSyntax) && TransferSyntaxKind.isSupported(target) else {
+            throw TranscodeError.unsupportedTransferSyntax(TransferSyntaxKind.isSupported(target) ? instance.transferSyntax : target)
+        }
+        try client.send(contextID: contextID, command: DimseCommandSet.request(
+            DimseCommandSet.cStoreRequest, messageID: client.makeMessageID(), sopClassUID: instance.sopClassUID,
+            sopInstanceUID: instance.sopInstanceUID, hasDataSet: true))
+        let stream = DataSetPDVStream(client: client, contextID: contextID, scatterGather: configuration.scatterGather)
+        let file = try FileHandle(forReadingFrom: instance.url)
+        defer { try? file.close() }
+        // 파일을 매핑해 두고 그대로 흘려 보낼 부분은 매핑된 메모리에서 바로 소켓으로 씀
+        let mapped = try Data(contentsOf: instance.url, options: .alwaysMapped)
+
+        let transcoded = instance.transferSyntax != target
+        if transcoded {
+            try transcode(instance, to: target, file: file, mapped: mapped, into: stream)
+        } else {
+            try send(mapped, from: try TranscodingStoreSender.dataSetOffset(file), count: Int.max, into: stream)
+        }
+        try stream.finish()
+        let status = try client.receive().command.uint16(DimseCommandSet.status) ?? 0xFFFF
+        return (status, transcoded, stream)
+    }
+
+    private func transcode(_ instance: Instance, to target: String, file: FileHandle, mapped: Data,
+                           into stream: DataSetPDVStream) throws {
+        let reencoder = DataSetReencoder(explicitIn: instance.transferSyntax != TransferSyntaxKind.implicitLittleEndian,
+                                         explicitOut: target != TransferSyntaxKind.implicitLittleEndian)
+        let (elements, pixelOffset) = try TranscodingStoreSender.headerElements(file, reencoder: reencoder)
+
+        // 비압축끼리: 픽셀 값은 파일에서 그대로 복사
+        if TransferSyntaxKind.isNative(instance.transferSyntax) && TransferSyntaxKind.isNative(target) {
+            try elements.forEach { try stream.write($0.bytes) }
+            try file.seek(toOffset: UInt64(pixelOffset))
+            let sourceHeader = [UInt8](try file.read(upToCount: reencoder.explicitIn ? 12 : 8) ?? Data())
+            guard sourceHeader.count >= 8 else { throw TranscodeError.missingPixelData }
+            let length = sourceHeader.suffix(4).reversed().reduce(0) { $0 << 8 | Int($1) }
+            var writer = ByteWriter()
+            reencoder.header(&writer, tag: TranscodingStoreSender.pixelDataTag,
+                             vr: instance.bitsAllocated > 8 ? 0x4F57 : 0x4F42, length: UInt32(length))
+            try stream.write(writer.bytes)
+            try send(mapped, from: pixelOffset + sourceHeader.count, count: length, into: stream)
+            try TranscodingStoreSender.trailingElements(mapped, pixelOffset: pixelOffset, reencoder: reencoder).forEach {
+                try stream.write($0.bytes)
+            }
+            return
+        }
+
+        let encapsulated = !TransferSyntaxKind.isNative(target)
+        let quality = configuration.quality
+        // 원본은 한 번만 읽고 모든 worker가 같이 씀 (픽셀 데이터는 파일에 남겨 두고 프레임을 꺼낼 때 읽음)
+        let source = try DicomheroCodecFactory.load(fromFileMaxSize: instance.url.path, maxBufferSize: 4096)
+        let pipeline = FramePipeline<TranscodedFrame>(
+            frameCount: instance.frames, workers: configuration.workers, lookahead: configuration.lookahead) { frame in
+            let scratch = DicomheroDataSet(transferSyntax: target)
+            try scratch.setImage(0, image: try source.getImage(UInt32(frame)), quality: quality)
+            let tag = try scratch.getTag(DicomheroTagId(id: .enumPixelData_7FE0_0010))
+            let buffers = encapsulated ? Array(1..<max(1, Int(tag.getBuffersCount()))) : [0]
+            var transcoded = TranscodedFrame(fragments: try buffers.map {
+                [UInt8](try tag.getReadingDataHandlerRaw(UInt32($0)).getMemory().data() ?? Data())
+            })
+            if frame == 0 {
+                transcoded.pixelModule = try TranscodingStoreSender.pixelModule(scratch, reencoder: reencoder, lossy: TransferSyntaxKind.isLossy(target))
+            }
+            return transcoded
+        }
+        defer { pipeline.cancel() }
+
+        // 첫 프레임의 픽셀 모듈(광도 해석, 비트 수 등)로 머리 요소를 고친 뒤 태그 순서대로 씀
+        let first = try pipeline.frame(0)
+        var merged = Dictionary(elements.map { ($0.tag, $0.bytes) }, uniquingKeysWith: { $1 })
+        merged.merge(first.pixelModule, uniquingKeysWith: { $1 })
+        for tag in merged.keys.sorted() {
+            try stream.write(merged[tag]!)
+        }
+
+        var writer = ByteWriter()
+        if encapsulated {
+            reencoder.header(&writer, tag: TranscodingStoreSender.pixelDataTag, vr: 0x4F42, length: DataSetReencoder.undefinedLength)
+            TranscodingStoreSender.item(&writer, length: 0) // 비어 있는 기본 오프셋 테이블
+        } else {
+            let frameLength = first.fragments.first?.count ?? 0
+            let length = frameLength * instance.frames
+            reencoder.header(&writer, tag: TranscodingStoreSender.pixelDataTag,
+                             vr: instance.bitsAllocated > 8 ? 0x4F57 : 0x4F42, length: UInt32(length + length % 2))
+        }
+        try stream.write(writer.bytes)
+
+        var written = 0
+        for index in 0..<instance.frames {
+            let frame = index == 0 ? first : try pipeline.frame(index)
+            for fragment in frame.fragments {
+                if encapsulated {
+                    var item = ByteWriter()
+                    TranscodingStoreSender.item(&item, length: UInt32(fragment.count + fragment.count % 2))
+                    try stream.write(item.bytes)
+                }
+                try fragment.withUnsafeBytes { try stream.write(region: $0) }
+                if encapsulated && fragment.count % 2 == 1 {
+                    try stream.write([0])
+                }
+                written += fragment.count
+            }
+        }
+        if encapsulated {
+            var delimiter = ByteWriter()
+            delimiter.uint16LE(0xFFFE)
+            delimiter.uint16LE(0xE0DD)
+            delimiter.uint32LE(0)
+            try stream.write(delimiter.bytes)
+        } else if written % 2 == 1 {
+            try stream.write([0])
+        }
+        try TranscodingStoreSender.trailingElements(mapped, pixelOffset: pixelOffset, reencoder: reencoder).forEach {
+            try stream.write($0.bytes)
+        }
+    }
+
+    private static func item(_ writer: inout ByteWriter, length: UInt32) {
+        writer.uint16LE(0xFFFE)
+        writer.uint16LE(0xE000)
+        writer.uint32LE(length)
+    }
+
+    // 변환으로 바뀔 수 있는 픽셀 모듈 요소를 새 인코딩 결과에서 읽어 옴
+    private static func pixelModule(_ dataSet: DicomheroDataSet, reencoder: DataSetReencoder, lossy: Bool) throws -> [UInt32: [UInt8]] {
+        var elements: [UInt32: [UInt8]] = [:]
+        let unsigned: [DicomheroTagEnum] = [
+            .enumSamplesPerPixel_0028_0002, .enumPlanarConfiguration_0028_0006, .enumBitsAllocated_0028_0100,
+            .enumBitsStored_0028_0101, .enumHighBit_0028_0102, .enumPixelRepresentation_0028_0103
+        ]
+        for tag in unsigned {
+            guard let value = try? dataSet.getUint32(DicomheroTagId(id: tag), elementNumber: 0) else { continue }
+            elements[tag.rawValue] = reencoder.encode(tag: tag.rawValue, vr: ValueRepresentation.us,
+                                                      value: [UInt8(value & 0xFF), UInt8(value >> 8 & 0xFF)])
+        }
+        let photometric = DicomheroTagEnum.enumPhotometricInterpretation_0028_0004.rawValue
+        if let value = try? dataSet.getString(DicomheroTagId(id: .enumPhotometricInterpretation_0028_0004), elementNumber: 0) {
+            elements[photometric] = reencoder.encode(tag: photometric, vr: DataSetReencoder.cs, value: Array(value.utf8))
+        }
+        if lossy {
+            let lossyCompression = DicomheroTagEnum.enumLossyImageCompression_0028_2110.rawValue
+            elements[lossyCompression] = reencoder.encode(tag: lossyCompression, vr: DataSetReencoder.cs, value: Array("01".utf8))
+        }
+        return elements
+    }
+
+    // 프리앰블과 메타 정보(그룹 0002) 다음, 데이터셋이 시작하는 파일 위치
+    private static func dataSetOffset(_ file: FileHandle) throws -> Int {
+        try file.seek(toOffset: 0)
+        let bytes = [UInt8](try file.read(upToCount: 144) ?? Data())
+        guard bytes.count == 144, bytes[128..<132].elementsEqual("DICM".utf8) else {
+            throw PDUError.malformed("not a DICOM part 10 file")
+        }
+        return 144 + bytes[140..<144].reversed().reduce(0) { $0 << 8 | Int($1) }
+    }
+
+    // 머리 요소를 다시 쓰고 픽셀 데이터 요소의 파일 위치를 찾음 (앞부분만 읽고, 모자라면 더 읽음)
+    private static func headerElements(_ file: FileHandle,
+                                       reencoder: DataSetReencoder) throws -> ([(tag: UInt32, bytes: [UInt8])], Int) {
+        let start = try dataSetOffset(file)
+        var prefix = 64 << 10
+        while true {
+            try file.seek(toOffset: 0)
+            let bytes = [UInt8](try file.read(upToCount: start + prefix) ?? Data())
+            let complete = bytes.count < start + prefix
+            do {
+                let (elements, pixelDataIndex) = try reencoder.topLevel(bytes[start...])
+                if let pixelDataIndex {
+                    return (elements, pixelDataIndex)
+                }
+                if complete {
+                    throw TranscodeError.missingPixelData
+                }
+            } catch PDUError.malformed(_) where !complete {
+                // 앞부분이 요소 중간에서 끊김
+            }
+            prefix *= 4
+        }
+    }
+
+    // 픽셀 데이터 뒤에 오는 최상위 요소(데이터셋 끝 채움, 서명 등)를 다시 씀
+    // 원본 픽셀 데이터가 정의되지 않은 길이(압축)면 조각들을 건너뛰며 구분자를 찾음
+    private static func trailingElements(_ mapped: Data, pixelOffset: Int,
+                                         reencoder: DataSetReencoder) throws -> [(tag: UInt32, bytes: [UInt8])] {
+        func uint32(_ offset: Int) throws -> UInt32 {
+            guard offset >= 0 && offset + 4 <= mapped.count else { throw TranscodeError.missingPixelData }
+            return mapped[offset..<offset + 4].reversed().reduce(0) { $0 << 8 | UInt32($1) }
+        }
+        let headerLength = reencoder.explicitIn ? 12 : 8
+        let length = try uint32(pixelOffset + headerLength - 4)
+        var end = pixelOffset + headerLength
+        if length == DataSetReencoder.undefinedLength {
+            while true {
+                let tag = try uint32(end)
+                let itemLength = try uint32(end + 4)
+                end += 8
+                if tag == 0xE0DD_FFFE {
+                    break
+                }
+                end += Int(itemLength)
+            }
+        } else {
+            end += Int(length)
+        }
+        guard end < mapped.count else { return [] }
+        return try reencoder.topLevel([UInt8](mapped[end...])[...], stopAtPixelData: false).elements
+    }
+
+    private func send(_ mapped: Data, from offset: Int, count: Int, into stream: DataSetPDVStream) throws {
+        guard offset < mapped.count else { return }
+        let end = mapped.count - offset > count ? offset + count : mapped.count
+        try mapped.withUnsafeBytes { try stream.write(region: UnsafeRawBufferPointer(rebasing: $0[offset..<end])) }
+    }
+}
+
+struct TranscodeMeasurement {
+    var transferSyntax = ""
+    var result = TranscodingStoreSender.Result()
+}
+
+enum TranscodeBenchmark {
+    // 같은 인스턴스들을 전송 구문만 바꿔 루프백 비동기 SCP로 보내며 보낸 바이트와 처리량을 잼
+    static func run(urls: [URL], transferSyntaxes: [String] = [
+        TransferSyntaxKind.explicitLittleEndian, DicomheroUidRLELossless_1_2_840_10008_1_2_5,
+        TransferSyntaxKind.jpegLossless, WellKnownUID.string(for: WellKnownUID.jpeg2000Lossless)
+    ], port: Int = 11119) -> [TranscodeMeasurement] {
+        return transferSyntaxes.map { transferSyntax in
+            let scp = AssociationMultiplexer(configuration: AssociationMultiplexer.Configuration(
+                port: port, maxPDULength: 1 << 20, maxPerformedOperations: 64,
+                transferSyntaxes: [transferSyntax]))
+            do {
+                try scp.start()
+            } catch {
+                print("caught: \(error)")
+                return TranscodeMeasurement(transferSyntax: transferSyntax)
+            }
+            defer { scp.stop() }
+            let sender = TranscodingStoreSender(configuration: TranscodingStoreSender.Configuration(
+                port: port, calledAET: scp.configuration.aeTitle, transferSyntaxes: [transferSyntax]))
+            return TranscodeMeasurement(transferSyntax: transferSyntax, result: sender.send(urls: urls))
+        }
+    }
+}
+
+struct PDUFramingMeasurement {
+    var maxPDULength: UInt32 = 0
+    var scatterGather = false
+    var result = TranscodingStoreSender.Result()
+
+    var pdusPerSystemCall: Double { result.systemCalls > 0 ? Double(result.pdus) / Double(result.systemCalls) : 0 }
+}
+
+enum PDUFramingBenchmark {
+    // 같은 전송 구문으로(변환 없이) 최대 PDU 길이별로 복사해 만드는 방식과 writev 모아 쓰기를 비교
+    static func run(urls: [URL], maxPDULengths: [UInt32] = [16 << 10, 1 << 20, 4 << 20],
+                    port: Int = 11123) -> [PDUFramingMeasurement] {
+        maxPDULengths.flatMap { maxPDULength in
+            [false, true].map { scatterGather in
+                var measurement = PDUFramingMeasurement(maxPDULength: maxPDULength, scatterGather: scatterGather)
+                let scp = AssociationMultiplexer(configuration: AssociationMultiplexer.Configuration(
+                    port: port, maxPDULength: maxPDULength, maxPerformedOperations: 64,
+                    transferSyntaxes: [TransferSyntaxKind.explicitLittleEndian]))
+                do {
+                    try scp.start()
+                } catch {
+                    print("caught: \(error)")
+                    return measurement
+                }
+                defer { scp.stop() }
+                let sender = TranscodingStoreSender(configuration: TranscodingStoreSender.Configuration(
+                    port: port, calledAET: scp.configuration.aeTitle, transferSyntaxes: [TransferSyntaxKind.explicitLittleEndian],
+                    maxPDULength: maxPDULength, scatterGather: scatterGather))
+                measurement.result = sender.send(urls: urls)
+                return measurement
+            }
+        }
+    }
+}
@@ -0,0 +1,134 @@
+//
+//  StreamingVolume.swift
+//  Dicom
+//
+//  Created by hanjongwoo on 10/19/26.
+//
+
+import Foundation
+
+// 볼륨의 어느 슬라이스까지 적재되었는지 나타내는 비트맵 (슬라이스당 1비트)
+struct VolumeCoverage {
+    let depth: Int
+    private(set) var words: [UInt64]
+    private(set) var count = 0 // 적재된 슬라이스 수
+
+    init(depth: Int) {
+        self.depth = depth
+        words = [UInt64](repeating: 0, count: (depth + 63) / 64)
+    }
+
+    @inline(__always)
+    func contains(_ z: Int) -> Bool {
+        words[z >> 6] & (1 << UInt64(z & 63)) != 0
+    }
+
+    mutating func insert(_ z: Int) {
+        let bit: UInt64 = 1 << UInt64(z & 63)
+        if words[z >> 6] & bit == 0 {
+            words[z >> 6] |= bit
+            count += 1
+        }
+    }
+
+    var isComplete: Bool { count == depth }
+
+    var fraction: Double { depth == 0 ? 1 : Double(count) / Double(depth) }
+
+    // 적재된 슬라이스를 모두 포함하는 최소 구간 (없으면 nil)
+    var bounds: ClosedRange<Int>? {
+        guard let first = (0..<depth).first(where: contains),
+              let last = (0..<depth).last(where: contains) else {
+            return nil
+        }
+        return first...last
+    }
+}
+
+// 디코딩이 끝난 슬라이스부터 볼륨에 바로 넣고 적재 범위를 알려 주는 조립기
+// 전체 시리즈가 끝나기 전에도 coverage에 포함된 슬라이스로 MPR/MIP를 그릴 수 있음
+// coverage에 포함된 슬라이스는 다시 쓰이지 않으므로 렌더링 중 읽어도 안전함
+final class StreamingVolumeAssembler {
+    let headers: [DicomVolumeLoader.SliceHeader]
+    let volume: DicomVolume
+
+    // 적재 범위가 늘어날 때마다 호출 (내부 직렬 큐에서 호출되며, 밀린 알림은 하나로 합쳐짐)
+    var onProgress: ((DicomVolume, VolumeCoverage) -> Void)?
+
+    private let lock = NSLock()
+    private var coverage: VolumeCoverage
+    private var firstError: Error?
+    private var notificationPending = false
+    private let notificationQueue = DispatchQueue(label: "StreamingVolumeAssembler.progress")
+
+    init(headers: [DicomVolumeLoader.SliceHeader]) throws {
+        guard let first = headers.first else {
+            throw DicomVolumeError.emptySeries
+        }
+        guard headers.allSatisfy({ $0.rows == first.rows && $0.columns == first.columns }) else {
+            throw DicomVolumeError.inconsistentSliceSize
+        }
+        self.headers = headers
+        volume = DicomVolumeLoader.makeVolume(headers: headers)
+        coverage = VolumeCoverage(depth: headers.count)
+    }
+
+    convenience init(urls: [URL]) throws {
+        try self.init(headers: DicomVolumeLoader.sortedHeaders(urls: urls))
+    }
+
+    // 현재까지의 적재 범위
+    var currentCoverage: VolumeCoverage {
+        lock.lock()
+        defer { lock.unlock() }
+        return coverage
+    }
+
+    // 모든 슬라이스를 DecodeScheduler에 맡겨 디코딩 (다른 디코딩과 같은 메모리 예산을 나눠 씀)
+    // 허가된 슬라이스부터 디코딩되므로 완료 순서는 정해져 있지 않음
+    // completion은 마지막 진행 알림 이후 호출되며, 실패한 슬라이스가 있으면 첫 오류를 전달
+    func start(completion: @escaping (Error?) -> Void) {
+        let group = DispatchGroup()
+        let volume = self.volume
+        DicomVolumeLoader.scheduleSlices(headers[...], sliceSize: volume.sliceSize, group: group,
+                                         destination: { volume.slice($0) }) { z, error in
+            self.lock.lock()
+            if let error {
+                if self.firstError == nil {
+                    self.firstError = error
+                }
+                self.lock.unlock()
+                return
+            }
+            self.coverage.insert(z)
+            self.lock.unlock()
+            self.notifyProgress()
+        }
+        group.notify(queue: notificationQueue) {
+            self.lock.lock()
+            let error = self.firstError
+            self.lock.unlock()
+            self.onProgress?(self.volume, self.currentCoverage)
+            completion(error)
+        }
+    }
+
+    // 렌더링이 디코딩을 막지 않도록 알림은 직렬 큐로 넘기고, 처리 중인 알림이 있으면 건너뜀
+    private func notifyProgress() {
+        lock.lock()
+        if notificationPending {
+            lock.unlock()
+            return
+        }
+        notificationPending = true
+        lock.unlock()
+
+        notificationQueue.async {
+            self.lock.lock()
+            self.notificationPending = false
+            let snapshot = self.coverage
+            self.lock.unlock()
+            self.onProgress?(self.volume, snapshot)
+        }
+    }
+}
@@ -0,0 +1,612 @@
+//
+//  StudyCatalogue.swift
+//  Dicom
+//
+//  Created by hanjongwoo on 10/19/26.
+//
+
+import Foundation
+
+enum QueryLevel: String {
+    case patient = "PATIENT"
+    case study = "STUDY"
+    case series = "SERIES"
+    case image = "IMAGE"
+}
+
+// 문자열 조건: 정확히 일치 또는 와일드카드(* ?)
+enum ValueMatcher {
+    case exact(String)
+    case wildcard(prefix: String, pattern: [UInt8])
+
+    // 빈 값이나 "*"는 조건 없음(nil)
+    init?(_ value: String) {
+        guard !value.isEmpty && value != "*" else {
+            return nil
+        }
+        guard let first = value.firstIndex(where: { $0 == "*" || $0 == "?" }) else {
+            self = .exact(value)
+            return
+        }
+        self = .wildcard(prefix: String(value[..<first]), pattern: Array(value.utf8))
+    }
+
+    func matches(_ value: String) -> Bool {
+        switch self {
+        case .exact(let expected):
+            return value == expected
+        case .wildcard(let prefix, let pattern):
+            guard value.hasPrefix(prefix) else { return false }
+            return ValueMatcher.glob(Array(value.utf8), pattern)
+        }
+    }
+
+    // *는 0개 이상, ?는 정확히 한 글자 (되돌아가기는 마지막 *에서만)
+    static func glob(_ value: [UInt8], _ pattern: [UInt8]) -> Bool {
+        var v = 0, p = 0
+        var star = -1, resume = 0
+        while v < value.count {
+            if p < pattern.count && (pattern[p] == 0x3F || pattern[p] == value[v]) {
+                v += 1
+                p += 1
+            } else if p < pattern.count && pattern[p] == 0x2A {
+                star = p
+                resume = v
+                p += 1
+            } else if star >= 0 {
+                p = star + 1
+                resume += 1
+                v = resume
+            } else {
+                return false
+            }
+        }
+        while p < pattern.count && pattern[p] == 0x2A {
+            p += 1
+        }
+        return p == pattern.count
+    }
+}
+
+// C-FIND 식별자에서 읽은 검색 조건
+struct CatalogueQuery {
+    var level = QueryLevel.study
+    var patientID: ValueMatcher?
+    var patientName: ValueMatcher?
+    var studyUID: String?
+    var accessionNumber: ValueMatcher?
+    var studyDates: ClosedRange<Int32>?
+    var modality: ValueMatcher?
+    var seriesUID: String?
+    var instanceUID: String?
+
+    init(level: QueryLevel = .study) {
+        self.level = level
+    }
+
+    init(identifier: DicomheroDataSet) {
+        func value(_ tag: DicomheroTagEnum) -> String {
+            (try? identifier.getString(DicomheroTagId(id: tag), elementNumber: 0, defaultValue: "")) ?? ""
+        }
+        level = QueryLevel(rawValue: value(.enumQueryRetrieveLevel_0008_0052)) ?? .study
+        patientID = ValueMatcher(value(.enumPatientID_0010_0020))
+        patientName = ValueMatcher(value(.enumPatientName_0010_0010))
+        accessionNumber = ValueMatcher(value(.enumAccessionNumber_0008_0050))
+        modality = ValueMatcher(value(.enumModality_0008_0060)) ?? ValueMatcher(value(.enumModalitiesInStudy_0008_0061))
+        studyDates = CatalogueQuery.dateRange(value(.enumStudyDate_0008_0020))
+        let study = value(.enumStudyInstanceUID_0020_000D), series = value(.enumSeriesInstanceUID_0020_000E)
+        let instance = value(.enumSOPInstanceUID_0008_0018)
+        studyUID = study.isEmpty ? nil : study
+        seriesUID = series.isEmpty ? nil : series
+        instanceUID = instance.isEmpty ? nil : instance
+    }
+
+    // "20240101", "20240101-20241231", "-20241231", "20240101-"
+    static func dateRange(_ value: String) -> ClosedRange<Int32>? {
+        guard !value.isEmpty else { return nil }
+        let parts = value.split(separator: "-", maxSplits: 1, omittingEmptySubsequences: false)
+        let lower = Int32(parts[0]) ?? 0
+        guard parts.count == 2 else {
+            return lower...lower
+        }
+        let upper = parts[1].isEmpty ? Int32.max : Int32(parts[1]) ?? Int32.max
+        return lower <= upper ? lower...upper : nil
+    }
+}
+
+struct CatalogueMatch {
+    let study: Int32
+    var series: Int32 = -1
+    var instance: Int32 = -1
+}
+
+// 검사/시리즈/인스턴스 목록을 열 단위 배열로 들고 색인으로 검색하는 메모리 카탈로그
+// UID와 짧은 문자열 값은 모두 인터닝 테이블의 핸들로만 저장함
+// 색인: UID와 환자 ID는 해시, 검사 일자와 환자 ID/이름은 정렬 배열 (정렬 색인은 삽입 후 첫 검색 때 다시 만듦)
+final class StudyCatalogue {
+    let strings = UIDTable(capacity: 1 << 16)
+    private let lock = NSLock()
+
+    // 검사 열
+    private var studyUIDs: [UIDHandle] = []
+    private var studyPatientIDs: [UIDHandle] = []
+    private var studyPatientNames: [UIDHandle] = []
+    private var studyDates: [Int32] = []
+    private var studyAccessions: [UIDHandle] = []
+    private var seriesByStudy: [[Int32]] = []
+    private var instanceCountByStudy: [Int32] = []
+    // 시리즈 열
+    private var seriesUIDs: [UIDHandle] = []
+    private var seriesStudy: [Int32] = []
+    private var seriesModalities: [UIDHandle] = []
+    private var seriesNumbers: [Int32] = []
+    private var instancesBySeries: [[Int32]] = []
+    // 인스턴스 열
+    private var instanceUIDs: [UIDHandle] = []
+    private var instanceSeries: [Int32] = []
+    private var instanceSOPClasses: [UIDHandle] = []
+    private var instanceNumbers: [Int32] = []
+    private var instanceFiles: [UIDHandle] = [] // 저장 폴더 안의 파일 이름
+
+    // 해시 색인
+    private var studyByUID: [UIDHandle: Int32] = [:]
+    private var seriesByUID: [UIDHandle: Int32] = [:]
+    private var instanceByUID: [UIDHandle: Int32] = [:]
+    private var studiesByPatientID: [UIDHandle: [Int32]] = [:]
+    private var studiesByPatientName: [UIDHandle: [Int32]] = [:]
+
+    // 정렬 색인
+    private var sortedIndexesValid = false
+    private var studiesByDate: [Int32] = []
+    private var sortedPatientIDs: [(value: String, handle: UIDHandle)] = []
+    private var sortedPatientNames: [(value: String, handle: UIDHandle)] = []
+    // 접수 번호/모달리티의 서로 다른 값 (넣을 때 정렬된 자리에 더함)
+    private var sortedAccessions: [(value: String, handle: UIDHandle)] = []
+    private var sortedModalities: [(value: String, handle: UIDHandle)] = []
+    private var accessionHandles = Set<UIDHandle>()
+    private var modalityHandles = Set<UIDHandle>()
+
+    struct Entry {
+        var patientID = ""
+        var patientName = ""
+        var studyUID = ""
+        var studyDate = ""
+        var accessionNumber = ""
+        var seriesUID = ""
+        var modality = ""
+        var seriesNumber: Int32 = 0
+        var instanceUID = ""
+        var sopClassUID = ""
+        var instanceNumber: Int32 = 0
+        // 저장된 파일 이름 (비어 있으면 <SOP Instance UID>.dcm)
+        // 받은 명령의 Affected SOP Instance UID로 저장했으면 데이터셋의 UID와 다를 수 있으므로 따로 둠
+        var fileName = ""
+    }
+
+    var instanceCount: Int {
+        lock.lock()
+        defer { lock.unlock() }
+        return instanceUIDs.count
+    }
+
+    // 데이터셋에서 카탈로그 항목을 읽는 일괄 조회 (파일마다 태그 ID를 새로 만들지 않음)
+    private static let entryQuery = TagQuery(paths: [
+        TagPath(.enumPatientID_0010_0020), TagPath(.enumPatientName_0010_0010),
+        TagPath(.enumStudyInstanceUID_0020_000D), TagPath(.enumStudyDate_0008_0020),
+        TagPath(.enumAccessionNumber_0008_0050), TagPath(.enumSeriesInstanceUID_0020_000E),
+        TagPath(.enumModality_0008_0060), TagPath(.enumSeriesNumber_0020_0011),
+        TagPath(.enumSOPInstanceUID_0008_0018), TagPath(.enumSOPClassUID_0008_0016),
+        TagPath(.enumInstanceNumber_0020_0013)
+    ])
+
+    static func entry(dataSet: DicomheroDataSet) -> Entry {
+        var table = TagTable(columnCount: entryQuery.paths.count)
+        entryQuery.run(dataSet, into: &table)
+        func value(_ column: Int) -> String { table.string(row: 0, column: column) ?? "" }
+        return Entry(patientID: value(0), patientName: value(1), studyUID: value(2), studyDate: value(3),
+                     accessionNumber: value(4), seriesUID: value(5), modality: value(6),
+                     seriesNumber: Int32(value(7)) ?? 0, instanceUID: value(8), sopClassUID: value(9),
+                     instanceNumber: Int32(value(10)) ?? 0)
+    }
+
+    func insert(dataSet: DicomheroDataSet, fileName: String = "") {
+        var entry = StudyCatalogue.entry(dataSet: dataSet)
+        entry.fileName = fileName
+        insert(entry)
+    }
+
+    func insert(_ entry: Entry) {
+        let studyUID = strings.intern(entry.studyUID), seriesUID = strings.intern(entry.seriesUID)
+        let instanceUID = strings.intern(entry.instanceUID)
+        lock.lock()
+        defer { lock.unlock() }
+        guard instanceByUID[instanceUID] == nil else {
+            return
+        }
+        let study: Int32
+        if let existing = studyByUID[studyUID] {
+            study = existing
+        } else {
+            study = Int32(studyUIDs.count)
+            let patientID = strings.intern(entry.patientID), patientName = strings.intern(entry.patientName)
+            studyUIDs.append(studyUID)
+            studyPatientIDs.append(patientID)
+            studyPatientNames.append(patientName)
+            studyDates.append(Int32(entry.studyDate) ?? 0)
+            let accession = strings.intern(entry.accessionNumber)
+            studyAccessions.append(accession)
+            if accessionHandles.insert(accession).inserted {
+                insertSorted(&sortedAccessions, entry.accessionNumber, accession)
+            }
+            seriesByStudy.append([])
+            instanceCountByStudy.append(0)
+            studyByUID[studyUID] = study
+            studiesByPatientID[patientID, default: []].append(study)
+            studiesByPatientName[patientName, default: []].append(study)
+            sortedIndexesValid = false
+        }
+        let series: Int32
+        if let existing = seriesByUID[seriesUID] {
+            series = existing
+        } else {
+            series = Int32(seriesUIDs.count)
+            seriesUIDs.append(seriesUID)
+            seriesStudy.append(study)
+            let modality = strings.intern(entry.modality)
+            seriesModalities.append(modality)
+            if modalityHandles.insert(modality).inserted {
+                insertSorted(&sortedModalities, entry.modality, modality)
+            }
+            seriesNumbers.append(entry.seriesNumber)
+            instancesBySeries.append([])
+            seriesByStudy[Int(study)].append(series)
+            seriesByUID[seriesUID] = series
+        }
+        let instance = Int32(instanceUIDs.count)
+        instanceUIDs.append(instanceUID)
+        instanceSeries.append(series)
+        instanceSOPClasses.append(strings.intern(entry.sopClassUID))
+        instanceNumbers.append(entry.instanceNumber)
+        instanceFiles.append(strings.intern(entry.fileName.isEmpty ? entry.instanceUID + ".dcm" : entry.fileName))
+        instancesBySeries[Int(series)].append(instance)
+        instanceCountByStudy[Int(study)] += 1
+        instanceByUID[instanceUID] = instance
+    }
+
+    // 검색 한 번 동안 쓰는 조건: 문자열 조건을 만족하는 값의 핸들 집합으로 바꿔 둠 (nil이면 조건 없음)
+    // 서로 다른 값마다 한 번만 비교하므로 행을 확인할 때는 문자열을 만들거나 테이블 잠금을 잡지 않음
+    private struct HandleConditions {
+        var studyUID: Set<UIDHandle>?
+        var patientID: Set<UIDHandle>?
+        var patientName: Set<UIDHandle>?
+        var accessionNumber: Set<UIDHandle>?
+        var modality: Set<UIDHandle>?
+        var seriesUID: Set<UIDHandle>?
+    }
+
+    // 조건에 맞는 행을 색인으로 찾음 (수준에 따라 환자/검사/시리즈/인스턴스 단위 결과)
+    func search(_ query: CatalogueQuery, limit: Int = Int.max) -> [CatalogueMatch] {
+        lock.lock()
+        defer { lock.unlock() }
+        if !sortedIndexesValid {
+            rebuildSortedIndexes()
+        }
+        let conditions = resolve(query)
+
+        // 인스턴스/시리즈 UID가 주어지면 그 행에서 바로 시작
+        if query.level == .image, let uid = query.instanceUID {
+            guard let handle = strings.handle(for: uid), let instance = instanceByUID[handle] else { return [] }
+            let series = instanceSeries[Int(instance)]
+            let match = CatalogueMatch(study: seriesStudy[Int(series)], series: series, instance: instance)
+            return studyMatches(match.study, query, conditions) && seriesMatches(series, conditions) ? [match] : []
+        }
+        if query.level != .study && query.level != .patient, let uid = query.seriesUID {
+            guard let handle = strings.handle(for: uid), let series = seriesByUID[handle] else { return [] }
+            let study = seriesStudy[Int(series)]
+            guard studyMatches(study, query, conditions) && seriesMatches(series, conditions) else { return [] }
+            return expand(study: study, series: [series], query, conditions, limit: limit)
+        }
+
+        var results: [CatalogueMatch] = []
+        var patients = Set<UIDHandle>()
+        for study in candidateStudies(query, conditions) where studyMatches(study, query, conditions) {
+            // 환자 수준은 환자 ID마다 한 번만 답함 (처음 만난 검사 행이 환자 값을 대표함)
+            if query.level == .patient && !patients.insert(studyPatientIDs[Int(study)]).inserted {
+                continue
+            }
+            results += expand(study: study, series: seriesByStudy[Int(study)], query, conditions, limit: limit - results.count)
+            if results.count >= limit {
+                break
+            }
+        }
+        return results
+    }
+
+    // C-MOVE/C-GET 대상: 질의 수준과 상관없이 조건에 맞는 모든 인스턴스
+    func retrieveItems(_ query: CatalogueQuery) -> [(sopClassUID: String, sopInstanceUID: String, fileName: String)] {
+        var imageQuery = query
+        imageQuery.level = .image
+        let matches = search(imageQuery)
+        lock.lock()
+        defer { lock.unlock() }
+        return matches.map {
+            let instance = Int($0.instance)
+            return (strings.string(for: instanceSOPClasses[instance]), strings.string(for: instanceUIDs[instance]),
+                    strings.string(for: instanceFiles[instance]))
+        }
+    }
+
+    // 문자열 조건을 핸들 집합으로 바꿈
+    // 환자 ID/이름, 접수 번호/모달리티 모두 정렬 색인의 접두어 구간만 봄
+    private func resolve(_ query: CatalogueQuery) -> HandleConditions {
+        func exact(_ value: String) -> Set<UIDHandle> {
+            strings.handle(for: value).map { [$0] } ?? []
+        }
+        func matching(_ matcher: ValueMatcher?, _ sorted: @autoclosure () -> [(value: String, handle: UIDHandle)]) -> Set<UIDHandle>? {
+            guard let matcher else {
+                return nil
+            }
+            switch matcher {
+            case .exact(let value):
+                return exact(value)
+            case .wildcard(let prefix, _):
+                return Set(prefixMatches(sorted(), prefix, matcher))
+            }
+        }
+        var conditions = HandleConditions()
+        conditions.studyUID = query.studyUID.map(exact)
+        conditions.seriesUID = query.seriesUID.map(exact)
+        conditions.patientID = matching(query.patientID, sortedPatientIDs)
+        conditions.patientName = matching(query.patientName, sortedPatientNames)
+        conditions.accessionNumber = matching(query.accessionNumber, sortedAccessions)
+        conditions.modality = matching(query.modality, sortedModalities)
+        return conditions
+    }
+
+    // 가장 좁힐 수 있는 색인 하나로 후보 검사 행을 고름 (나머지 조건은 studyMatches에서 확인)
+    private func candidateStudies(_ query: CatalogueQuery, _ conditions: HandleConditions) -> [Int32] {
+        if let handles = conditions.studyUID {
+            return handles.compactMap { studyByUID[$0] }
+        }
+        if case .exact? = query.patientID, let handles = conditions.patientID {
+            return handles.flatMap { studiesByPatientID[$0] ?? [] }
+        }
+        if let range = query.studyDates {
+            let lower = lowerBound(studiesByDate) { studyDates[Int($0)] < range.lowerBound }
+            let upper = lowerBound(studiesByDate) { studyDates[Int($0)] <= range.upperBound }
+            return Array(studiesByDate[lower..<upper])
+        }
+        if let handles = conditions.patientID {
+            return handles.flatMap { studiesByPatientID[$0] ?? [] }
+        }
+        if let handles = conditions.patientName {
+            return handles.flatMap { studiesByPatientName[$0] ?? [] }
+        }
+        return Array(0..<Int32(studyUIDs.count))
+    }
+
+    // 정렬된 서로 다른 값 목록에서 접두어 구간만 보고 나머지 와일드카드를 확인
+    private func prefixMatches(_ sorted: [(value: String, handle: UIDHandle)], _ prefix: String,
+                               _ matcher: ValueMatcher) -> [UIDHandle] {
+        var index = lowerBound(sorted) { $0.value < prefix }
+        var handles: [UIDHandle] = []
+        while index < sorted.count && sorted[index].value.hasPrefix(prefix) {
+            if matcher.matches(sorted[index].value) {
+                handles.append(sorted[index].handle)
+            }
+            index += 1
+        }
+        return handles
+    }
+
+    private func studyMatches(_ study: Int32, _ query: CatalogueQuery, _ conditions: HandleConditions) -> Bool {
+        let row = Int(study)
+        if let handles = conditions.studyUID, !handles.contains(studyUIDs[row]) { return false }
+        if let range = query.studyDates, !range.contains(studyDates[row]) { return false }
+        if let handles = conditions.patientID, !handles.contains(studyPatientIDs[row]) { return false }
+        if let handles = conditions.patientName, !handles.contains(studyPatientNames[row]) { return false }
+        if let handles = conditions.accessionNumber, !handles.contains(studyAccessions[row]) { return false }
+        if query.level == .study, let handles = conditions.modality {
+            return seriesByStudy[row].contains { handles.contains(seriesModalities[Int($0)]) }
+        }
+        return true
+    }
+
+    private func seriesMatches(_ series: Int32, _ conditions: HandleConditions) -> Bool {
+        if let handles = conditions.seriesUID, !handles.contains(seriesUIDs[Int(series)]) { return false }
+        if let handles = conditions.modality, !handles.contains(seriesModalities[Int(series)]) { return false }
+        return true
+    }
+
+    private func expand(study: Int32, series: [Int32], _ query: CatalogueQuery, _ conditions: HandleConditions,
+                        limit: Int) -> [CatalogueMatch] {
+        switch query.level {
+        case .patient, .study:
+            return [CatalogueMatch(study: study)]
+        case .series:
+            return Array(series.lazy.filter { self.seriesMatches($0, conditions) }
+                .map { CatalogueMatch(study: study, series: $0) }.prefix(limit))
+        case .image:
+            var matches: [CatalogueMatch] = []
+            for s in series where seriesMatches(s, conditions) {
+                for instance in instancesBySeries[Int(s)] {
+                    matches.append(CatalogueMatch(study: study, series: s, instance: instance))
+                    if matches.count >= limit { return matches }
+                }
+            }
+            return matches
+        }
+    }
+
+    private func rebuildSortedIndexes() {
+        studiesByDate = Array(0..<Int32(studyUIDs.count)).sorted { studyDates[Int($0)] < studyDates[Int($1)] }
+        sortedPatientIDs = studiesByPatientID.keys.map { (strings.string(for: $0), $0) }.sorted { $0.value < $1.value }
+        sortedPatientNames = studiesByPatientName.keys.map { (strings.string(for: $0), $0) }.sorted { $0.value < $1.value }
+        sortedIndexesValid = true
+    }
+
+    private func insertSorted(_ sorted: inout [(value: String, handle: UIDHandle)], _ value: String, _ handle: UIDHandle) {
+        sorted.insert((value, handle), at: lowerBound(sorted) { $0.value < value })
+    }
+
+    private func lowerBound<Element>(_ array: [Element], _ isBefore: (Element) -> Bool) -> Int {
+        var low = 0, high = array.count
+        while low < high {
+            let mid = (low + high) / 2
+            if isBefore(array[mid]) {
+                low = mid + 1
+            } else {
+                high = mid
+            }
+        }
+        return low
+    }
+
+    // C-FIND 응답에 채울 값 (지원하지 않는 태그는 nil)
+    func value(_ tag: UInt32, for match: CatalogueMatch, level: QueryLevel) -> String? {
+        lock.lock()
+        defer { lock.unlock() }
+        let study = Int(match.study), series = Int(match.series), instance = Int(match.instance)
+        switch tag {
+        case DicomheroTagEnum.enumQueryRetrieveLevel_0008_0052.rawValue:
+            return level.rawValue
+        case DicomheroTagEnum.enumPatientID_0010_0020.rawValue:
+            return strings.string(for: studyPatientIDs[study])
+        case DicomheroTagEnum.enumPatientName_0010_0010.rawValue:
+            return strings.string(for: studyPatientNames[study])
+        case DicomheroTagEnum.enumStudyInstanceUID_0020_000D.rawValue:
+            return strings.string(for: studyUIDs[study])
+        case DicomheroTagEnum.enumStudyDate_0008_0020.rawValue:
+            return studyDates[study] > 0 ? String(studyDates[study]) : ""
+        case DicomheroTagEnum.enumAccessionNumber_0008_0050.rawValue:
+            return strings.string(for: studyAccessions[study])
+        case DicomheroTagEnum.enumModalitiesInStudy_0008_0061.rawValue:
+            var modalities: [String] = []
+            for s in seriesByStudy[study] {
+                let modality = strings.string(for: seriesModalities[Int(s)])
+                if !modalities.contains(modality) { modalities.append(modality) }
+            }
+            return modalities.joined(separator: "\\")
+        case DicomheroTagEnum.enumNumberOfStudyRelatedSeries_0020_1206.rawValue:
+            return String(seriesByStudy[study].count)
+        case DicomheroTagEnum.enumNumberOfStudyRelatedInstances_0020_1208.rawValue:
+            return String(instanceCountByStudy[study])
+        case DicomheroTagEnum.enumSeriesInstanceUID_0020_000E.rawValue where series >= 0:
+            return strings.string(for: seriesUIDs[series])
+        case DicomheroTagEnum.enumModality_0008_0060.rawValue where series >= 0:
+            return strings.string(for: seriesModalities[series])
+        case DicomheroTagEnum.enumSeriesNumber_0020_0011.rawValue where series >= 0:
+            return String(seriesNumbers[series])
+        case DicomheroTagEnum.enumNumberOfSeriesRelatedInstances_0020_1209.rawValue where series >= 0:
+            return String(instancesBySeries[series].count)
+        case DicomheroTagEnum.enumSOPInstanceUID_0008_0018.rawValue where instance >= 0:
+            return strings.string(for: instanceUIDs[instance])
+        case DicomheroTagEnum.enumSOPClassUID_0008_0016.rawValue where instance >= 0:
+            return strings.string(for: instanceSOPClasses[instance])
+        case DicomheroTagEnum.enumInstanceNumber_0020_0013.rawValue where instance >= 0:
+            return String(instanceNumbers[instance])
+        default:
+            return nil
+        }
+    }
+}
+
+// 질의 종류별 처리량과 응답 시간 분포
+struct CatalogueQueryStatistics {
+    var name = ""
+    var queries = 0
+    var matches = 0
+    var seconds = 0.0
+    var p50Microseconds = 0.0
+    var p99Microseconds = 0.0
+
+    var queriesPerSecond: Double { seconds > 0 ? Double(queries) / seconds : 0 }
+}
+
+enum CatalogueBenchmark {
+    // 합성 인스턴스 instanceCount개(검사당 시리즈 4개, 시리즈당 인스턴스 25개)를 넣고 질의 종류별로 잼
+    static func run(instanceCount: Int = 1_000_000, queriesPerKind: Int = 2_000) -> [CatalogueQueryStatistics] {
+        let catalogue = StudyCatalogue()
+        let seriesPerStudy = 4, instancesPerSeries = 25
+        let studies = max(1, instanceCount / (seriesPerStudy * instancesPerSeries))
+        let surnames = ["KIM", "LEE", "PARK", "CHOI", "JUNG", "KANG", "CHO", "YOON", "JANG", "LIM"]
+        let modalities = ["CT", "MR", "CR", "US"]
+        let root = "1.2.826.0.1.3680043.10.1234"
+        for study in 0..<studies {
+            let patient = study / 3
+            var entry = StudyCatalogue.Entry()
+            entry.patientID = String(format: "P%07d", patient)
+            entry.patientName = "\(surnames[patient % surnames.count])^\(patient)"
+            entry.studyUID = "\(root).1.\(study)"
+            entry.studyDate = String(20150101 + (study % 10) * 10000 + (study % 12) * 100 + study % 28)
+            entry.accessionNumber = "A\(study)"
+            for series in 0..<seriesPerStudy {
+                entry.seriesUID = "\(root).2.\(study).\(series)"
+                entry.modality = modalities[(study + series) % modalities.count]
+                entry.seriesNumber = Int32(series + 1)
+                for instance in 0..<instancesPerSeries {
+                    entry.instanceUID = "\(root).3.\(study).\(series).\(instance)"
+                    entry.sopClassUID = WellKnownUID.string(for: WellKnownUID.ctImageStorage)
+                    entry.instanceNumber = Int32(instance + 1)
+                    catalogue.insert(entry)
+                }
+            }
+        }
+
+        var random = SystemRandomNumberGenerator()
+        func anyStudy() -> Int { Int.random(in: 0..<studies, using: &random) }
+        let kinds: [(String, () -> CatalogueQuery)] = [
+            ("study by StudyInstanceUID", {
+                var query = CatalogueQuery(level: .study)
+                query.studyUID = "\(root).1.\(anyStudy())"
+                return query
+            }),
+            ("studies by PatientID", {
+                var query = CatalogueQuery(level: .study)
+                query.patientID = ValueMatcher(String(format: "P%07d", anyStudy() / 3))
+                return query
+            }),
+            ("studies by date range (1 month) + modality", {
+                var query = CatalogueQuery(level: .study)
+                let year = 2015 + Int.random(in: 0..<10)
+                query.studyDates = CatalogueQuery.dateRange("\(year)0301-\(year)0331")
+                query.modality = ValueMatcher("MR")
+                return query
+            }),
+            ("studies by PatientName wildcard", {
+                var query = CatalogueQuery(level: .study)
+                query.patientName = ValueMatcher("\(surnames[Int.random(in: 0..<surnames.count)])^1*7")
+                return query
+            }),
+            ("series of a study", {
+                var query = CatalogueQuery(level: .series)
+                query.studyUID = "\(root).1.\(anyStudy())"
+                return query
+            }),
+            ("images of a series", {
+                var query = CatalogueQuery(level: .image)
+                query.seriesUID = "\(root).2.\(anyStudy()).\(Int.random(in: 0..<seriesPerStudy))"
+                return query
+            })
+        ]
+        _ = catalogue.search(CatalogueQuery()) // 정렬 색인을 미리 만듦
+
+        return kinds.map { name, makeQuery in
+            let queries = (0..<queriesPerKind).map { _ in makeQuery() }
+            var statistics = CatalogueQueryStatistics(name: name, queries: queries.count)
+            var latencies: [Double] = []
+            latencies.reserveCapacity(queries.count)
+            let start = DispatchTime.now().uptimeNanoseconds
+            for query in queries {
+                let begin = DispatchTime.now().uptimeNanoseconds
+                statistics.matches += catalogue.search(query).count
+                latencies.append(Double(DispatchTime.now().uptimeNanoseconds - begin) / 1e3)
+            }
+            statistics.seconds = Double(DispatchTime.now().uptimeNanoseconds - start) / 1e9
+            latencies.sort()
+            statistics.p50Microseconds = latencies[latencies.count / 2]
+            statistics.p99Microseconds = latencies[min(latencies.count - 1, latencies.count * 99 / 100)]
+            return statistics
+        }
+    }
+}
@@ -0,0 +1,265 @@
+//
+//  TagQuery.swift
+//  Dicom
+//
+//  Created by hanjongwoo on 10/19/26.
+//
+
+import Foundation
+
+// 데이터셋 안의 값 하나를 가리키는 경로 (시퀀스 항목을 거쳐 내려갈 수 있음)
+// 예: TagPath(.enumPatientName_0010_0010)
+//     TagPath(through: [(.enumReferencedStudySequence_0008_1110, 0)], .enumReferencedSOPInstanceUID_0008_1155)
+struct TagPath: Hashable {
+    // 값을 결과 버퍼에 넣는 방식
+    enum Kind: Hashable {
+        case text      // 문자열 VR: 원시 바이트를 그대로 (끝의 공백/NUL 제거, 문자열 변환은 행의 문자 집합으로)
+        case unsigned  // 이진 정수 VR(US/UL 등): 10진수 문자열로
+    }
+
+    struct Step: Hashable {
+        let sequence: UInt32
+        let item: Int
+    }
+
+    let steps: [Step]
+    let tag: UInt32
+    let element: Int
+    let kind: Kind
+
+    init(_ tag: DicomheroTagEnum, element: Int = 0, kind: Kind = .text) {
+        self.init(through: [], tag, element: element, kind: kind)
+    }
+
+    init(through steps: [(DicomheroTagEnum, Int)], _ tag: DicomheroTagEnum, element: Int = 0, kind: Kind = .text) {
+        self.steps = steps.map { Step(sequence: $0.0.rawValue, item: $0.1) }
+        self.tag = tag.rawValue
+        self.element = element
+        self.kind = kind
+    }
+}
+
+// 여러 경로의 값을 데이터셋 하나당 한 번의 순회로 읽는 일괄 조회
+// 태그 ID 객체는 조회를 만들 때 한 번만 생성하고, 같은 시퀀스 항목을 거치는 경로들은 항목을 한 번만 가져옴
+final class TagQuery {
+    let paths: [TagPath]
+
+    // 경로들을 시퀀스 단계별로 묶은 트리
+    private final class Node {
+        var values: [(column: Int, tagId: DicomheroTagId, path: TagPath)] = []
+        var children: [(step: TagPath.Step, tagId: DicomheroTagId, node: Node)] = []
+
+        func child(_ step: TagPath.Step) -> Node {
+            if let existing = children.first(where: { $0.step == step }) {
+                return existing.node
+            }
+            let node = Node()
+            children.append((step, DicomheroTagId(group: UInt16(step.sequence >> 16), tag: UInt16(step.sequence & 0xFFFF)), node))
+            return node
+        }
+    }
+
+    private let root = Node()
+
+    init(paths: [TagPath]) {
+        self.paths = paths
+        for (column, path) in paths.enumerated() {
+            var node = root
+            for step in path.steps {
+                node = node.child(step)
+            }
+            node.values.append((column, DicomheroTagId(group: UInt16(path.tag >> 16), tag: UInt16(path.tag & 0xFFFF)), path))
+        }
+    }
+
+    // 데이터셋 하나의 값을 table의 새 행으로 추가
+    func run(_ dataSet: DicomheroDataSet, into table: inout TagTable) {
+        precondition(table.columnCount == paths.count)
+        table.beginRow(characterSet: SpecificCharacterSet(dataSet: dataSet))
+        visit(root, dataSet: dataSet, table: &table)
+    }
+
+    func run(_ dataSets: [DicomheroDataSet]) -> TagTable {
+        var table = TagTable(columnCount: paths.count)
+        table.reserve(rows: dataSets.count)
+        dataSets.forEach { run($0, into: &table) }
+        return table
+    }
+
+    private func visit(_ node: Node, dataSet: DicomheroDataSet, table: inout TagTable) {
+        for value in node.values {
+            switch value.path.kind {
+            case .text:
+                if let handler = try? dataSet.getReadingDataHandlerRaw(value.tagId, bufferId: 0),
+                   let bytes = try? handler.getMemory().data() {
+                    table.set(column: value.column, text: bytes, element: value.path.element)
+                }
+            case .unsigned:
+                if let number = try? dataSet.getUint32(value.tagId, elementNumber: UInt32(value.path.element)) {
+                    table.set(column: value.column, number: number)
+                }
+            }
+        }
+        for child in node.children {
+            if let item = try? dataSet.getSequenceItem(child.tagId, item: UInt32(child.step.item)) {
+                visit(child.node, dataSet: item, table: &table)
+            }
+        }
+    }
+}
+
+// 일괄 조회 결과를 담는 열 기반 버퍼
+// 모든 값의 바이트를 하나의 배열에 이어 붙이고 칸마다 (시작, 길이)만 저장하므로 값마다 String을 만들지 않음
+// 문자열 값은 원시 바이트로 저장하고, 꺼낼 때 행의 Specific Character Set으로 변환 (시퀀스 항목도 상위 값을 따름)
+struct TagTable {
+    let columnCount: Int
+    private(set) var rowCount = 0
+    private(set) var bytes: [UInt8] = []
+    private var starts: [UInt32] = []  // 행 우선: row * columnCount + column
+    private var lengths: [Int32] = []  // -1이면 값 없음
+    private var characterSets: [SpecificCharacterSet] = []
+
+    init(columnCount: Int) {
+        self.columnCount = columnCount
+    }
+
+    mutating func reserve(rows: Int) {
+        starts.reserveCapacity(rows * columnCount)
+        lengths.reserveCapacity(rows * columnCount)
+        bytes.reserveCapacity(rows * columnCount * 16)
+        characterSets.reserveCapacity(rows)
+    }
+
+    fileprivate mutating func beginRow(characterSet: SpecificCharacterSet) {
+        starts.append(contentsOf: repeatElement(0, count: columnCount))
+        lengths.append(contentsOf: repeatElement(-1, count: columnCount))
+        characterSets.append(characterSet)
+        rowCount += 1
+    }
+
+    // 백슬래시로 구분된 element번째 값을 앞뒤 공백/NUL을 제거해 저장
+    fileprivate mutating func set(column: Int, text: Data, element: Int) {
+        text.withUnsafeBytes { raw in
+            var index = 0, start = 0
+            for i in 0...raw.count where i == raw.count || raw[i] == 0x5C {
+                if index == element {
+                    var lower = start, upper = i
+                    while lower < upper && (raw[lower] == 0x20 || raw[lower] == 0) { lower += 1 }
+                    while upper > lower && (raw[upper - 1] == 0x20 || raw[upper - 1] == 0) { upper -= 1 }
+                    store(column: column, UnsafeRawBufferPointer(rebasing: raw[lower..<upper]))
+                    return
+                }
+                index += 1
+                start = i + 1
+            }
+        }
+    }
+
+    fileprivate mutating func set(column: Int, number: UInt32) {
+        var text = String(number)
+        text.withUTF8 { store(column: column, UnsafeRawBufferPointer($0)) }
+    }
+
+    private mutating func store(column: Int, _ value: UnsafeRawBufferPointer) {
+        let cell = (rowCount - 1) * columnCount + column
+        starts[cell] = UInt32(bytes.count)
+        lengths[cell] = Int32(value.count)
+        bytes.append(contentsOf: value)
+    }
+
+    func contains(row: Int, column: Int) -> Bool {
+        lengths[row * columnCount + column] >= 0
+    }
+
+    // 값의 원시 바이트를 복사 없이 넘김 (값이 없으면 nil, 문자열 값은 characterSet(row:)로 인코딩된 상태)
+    func withBytes<Result>(row: Int, column: Int, _ body: (UnsafeRawBufferPointer) -> Result) -> Result? {
+        let cell = row * columnCount + column
+        guard lengths[cell] >= 0 else {
+            return nil
+        }
+        let start = Int(starts[cell])
+        return bytes.withUnsafeBytes { body(UnsafeRawBufferPointer(rebasing: $0[start..<start + Int(lengths[cell])])) }
+    }
+
+    func characterSet(row: Int) -> SpecificCharacterSet {
+        characterSets[row]
+    }
+
+    func string(row: Int, column: Int) -> String? {
+        withBytes(row: row, column: column) { characterSets[row].decode($0) }
+    }
+}
+
+// 검사 목록에 쓰는 속성들을 태그별 API와 일괄 조회로 읽어 비교
+// 두 방식 모두 값마다 String을 만들어 같은 결과를 내도록 맞춰서 잼 (일괄 조회는 문자 집합 변환까지 포함)
+struct TagQueryStatistics {
+    var files = 0
+    var paths = 0
+    var perTagSeconds = 0.0
+    var batchSeconds = 0.0
+
+    var speedup: Double { batchSeconds > 0 ? perTagSeconds / batchSeconds : 0 }
+}
+
+enum TagQueryBenchmark {
+    static let studyListPaths: [TagPath] = [
+        TagPath(.enumPatientName_0010_0010), TagPath(.enumPatientID_0010_0020),
+        TagPath(.enumPatientBirthDate_0010_0030), TagPath(.enumPatientSex_0010_0040),
+        TagPath(.enumStudyInstanceUID_0020_000D), TagPath(.enumStudyDate_0008_0020),
+        TagPath(.enumStudyTime_0008_0030), TagPath(.enumStudyDescription_0008_1030),
+        TagPath(.enumAccessionNumber_0008_0050), TagPath(.enumSeriesInstanceUID_0020_000E),
+        TagPath(.enumSeriesNumber_0020_0011), TagPath(.enumSeriesDescription_0008_103E),
+        TagPath(.enumModality_0008_0060), TagPath(.enumSOPInstanceUID_0008_0018),
+        TagPath(.enumSOPClassUID_0008_0016), TagPath(.enumInstanceNumber_0020_0013),
+        TagPath(.enumRows_0028_0010, kind: .unsigned), TagPath(.enumColumns_0028_0011, kind: .unsigned),
+        TagPath(.enumBodyPartExamined_0018_0015), TagPath(.enumManufacturer_0008_0070),
+        TagPath(through: [(.enumReferencedStudySequence_0008_1110, 0)], .enumReferencedSOPInstanceUID_0008_1155)
+    ]
+
+    static func run(urls: [URL], repetitions: Int = 20) -> TagQueryStatistics {
+        var statistics = TagQueryStatistics(paths: studyListPaths.count)
+        let datasets = urls.compactMap { try? DicomheroCodecFactory.load(fromFileMaxSize: $0.path, maxBufferSize: 2048) }
+        statistics.files = datasets.count
+
+        var start = DispatchTime.now().uptimeNanoseconds
+        for _ in 0..<repetitions {
+            autoreleasepool {
+                for dataset in datasets {
+                    for path in studyListPaths {
+                        _ = perTagValue(dataset, path)
+                    }
+                }
+            }
+        }
+        statistics.perTagSeconds = Double(DispatchTime.now().uptimeNanoseconds - start) / 1e9
+
+        start = DispatchTime.now().uptimeNanoseconds
+        let query = TagQuery(paths: studyListPaths)
+        for _ in 0..<repetitions {
+            autoreleasepool {
+                let table = query.run(datasets)
+                for row in 0..<table.rowCount {
+                    for column in 0..<table.columnCount {
+                        _ = table.string(row: row, column: column)
+                    }
+                }
+            }
+        }
+        statistics.batchSeconds = Double(DispatchTime.now().uptimeNanoseconds - start) / 1e9
+        return statistics
+    }
+
+    // 기존 방식: 값마다 태그 ID를 만들고 시퀀스 항목도 매번 다시 찾음
+    private static func perTagValue(_ dataSet: DicomheroDataSet, _ path: TagPath) -> String? {
+        var current: DicomheroDataSet? = dataSet
+        for step in path.steps {
+            let sequence = DicomheroTagId(group: UInt16(step.sequence >> 16), tag: UInt16(step.sequence & 0xFFFF))
+            current = try? current?.getSequenceItem(sequence, item: UInt32(step.item))
+        }
+        let tagId = DicomheroTagId(group: UInt16(path.tag >> 16), tag: UInt16(path.tag & 0xFFFF))
+        switch path.kind {
+        case .text: return try? current?.getString(tagId, elementNumber: UInt32(path.element))
+        case .unsigned: return (try? current?.getUint32(tagId, elementNumber: UInt32(path.element))).map { String($0) }
+        }
+    }
+}
@@ -0,0 +1,281 @@
+//
+//  UIDTable.swift
+//  Dicom
+//
+//  Created by hanjongwoo on 10/19/26.
+//
+
+import Foundation
+
+// UID 하나를 가리키는 정수 핸들. 같은 테이블 안에서는 같은 UID가 항상 같은 핸들을 가지므로
+// 비교와 해시가 정수 연산 하나로 끝남
+struct UIDHandle: Hashable, Comparable {
+    let rawValue: Int32
+
+    static func < (lhs: UIDHandle, rhs: UIDHandle) -> Bool {
+        lhs.rawValue < rhs.rawValue
+    }
+}
+
+// UID 문자열을 한 번만 저장하고 정수 핸들을 붙여 주는 인터닝 테이블
+// 문자열은 하나의 바이트 배열에 이어 붙이고(UID는 최대 64자), 조회는 FNV-1a 해시의 개방 주소 테이블로 함
+// NSString/String 객체를 UID마다 만들지 않으므로 대량의 인스턴스 UID도 적은 메모리로 보관 가능
+final class UIDTable {
+    static let shared = UIDTable(preloadingWellKnown: true)
+
+    private let lock = NSLock()
+    private var bytes: [UInt8] = []
+    private var offsets: [UInt32] = []
+    private var lengths: [UInt32] = []
+    private var hashes: [UInt32] = []
+    private var slots: [Int32]       // 핸들 + 1, 0은 빈 칸
+    private var slotMask: Int
+
+    init(capacity: Int = 1024, preloadingWellKnown: Bool = false) {
+        var size = 16
+        while size < capacity * 2 {
+            size <<= 1
+        }
+        slots = [Int32](repeating: 0, count: size)
+        slotMask = size - 1
+        if preloadingWellKnown {
+            WellKnownUID.all.forEach { _ = intern($0) }
+        }
+    }
+
+    var count: Int {
+        lock.lock()
+        defer { lock.unlock() }
+        return offsets.count
+    }
+
+    // 테이블이 차지하는 메모리(바이트): 문자열 바이트 + UID당 12바이트 + 해시 슬롯
+    var byteCount: Int {
+        lock.lock()
+        defer { lock.unlock() }
+        return bytes.count + offsets.count * (4 + 4 + 4) + slots.count * 4
+    }
+
+    func intern(_ uid: String) -> UIDHandle {
+        var uid = uid
+        return uid.withUTF8 { intern(bytes: UnsafeRawBufferPointer($0)) }
+    }
+
+    // DICOM 값에서 읽은 바이트를 그대로 인터닝 (끝의 NUL/공백 패딩은 제거)
+    func intern(bytes raw: UnsafeRawBufferPointer) -> UIDHandle {
+        let value = UIDTable.trimmed(raw)
+        let hash = UIDTable.hash(value)
+        lock.lock()
+        defer { lock.unlock() }
+        if let existing = find(value, hash: hash) {
+            return existing
+        }
+        let handle = UIDHandle(rawValue: Int32(offsets.count))
+        offsets.append(UInt32(bytes.count))
+        lengths.append(UInt32(value.count))
+        hashes.append(hash)
+        bytes.append(contentsOf: value)
+        if offsets.count * 2 > slots.count {
+            grow()
+        } else {
+            insert(handle, hash: hash)
+        }
+        return handle
+    }
+
+    // 이미 등록된 UID이면 핸들을, 아니면 nil을 돌려줌 (테이블을 늘리지 않음)
+    func handle(for uid: String) -> UIDHandle? {
+        var uid = uid
+        return uid.withUTF8 { buffer in
+            let value = UIDTable.trimmed(UnsafeRawBufferPointer(buffer))
+            let hash = UIDTable.hash(value)
+            lock.lock()
+            defer { lock.unlock() }
+            return find(value, hash: hash)
+        }
+    }
+
+    // 잠금을 잡고 String을 새로 만드므로 자주 부르는 곳에서는 핸들끼리 비교하거나
+    // 잘 알려진 UID는 WellKnownUID.string(for:)를 씀
+    func string(for handle: UIDHandle) -> String {
+        lock.lock()
+        defer { lock.unlock() }
+        let index = Int(handle.rawValue)
+        let start = Int(offsets[index])
+        return String(decoding: bytes[start..<start + Int(lengths[index])], as: UTF8.self)
+    }
+
+    private func find(_ value: UnsafeRawBufferPointer, hash: UInt32) -> UIDHandle? {
+        var slot = Int(hash) & slotMask
+        while slots[slot] != 0 {
+            let index = Int(slots[slot] - 1)
+            if hashes[index] == hash && Int(lengths[index]) == value.count {
+                let start = Int(offsets[index])
+                if value.isEmpty || bytes.withUnsafeBytes({ memcmp($0.baseAddress! + start, value.baseAddress!, value.count) == 0 }) {
+                    return UIDHandle(rawValue: Int32(index))
+                }
+            }
+            slot = (slot + 1) & slotMask
+        }
+        return nil
+    }
+
+    private func insert(_ handle: UIDHandle, hash: UInt32) {
+        var slot = Int(hash) & slotMask
+        while slots[slot] != 0 {
+            slot = (slot + 1) & slotMask
+        }
+        slots[slot] = handle.rawValue + 1
+    }
+
+    private func grow() {
+        slots = [Int32](repeating: 0, count: slots.count * 2)
+        slotMask = slots.count - 1
+        for index in hashes.indices {
+            insert(UIDHandle(rawValue: Int32(index)), hash: hashes[index])
+        }
+    }
+
+    // UI 값의 형식 검사: 1-64자의 숫자와 점, 빈 구성 요소 없음
+    // 받은 UID로 파일 이름을 만들기 전에 확인 (경로 구분자나 ..가 들어갈 수 없음)
+    static func isValid(_ uid: String) -> Bool {
+        let utf8 = uid.utf8
+        guard (1...64).contains(utf8.count), utf8.first != 0x2E, utf8.last != 0x2E else {
+            return false
+        }
+        var previous: UInt8 = 0
+        for byte in utf8 {
+            guard (0x30...0x39).contains(byte) || (byte == 0x2E && previous != 0x2E) else {
+                return false
+            }
+            previous = byte
+        }
+        return true
+    }
+
+    private static func trimmed(_ raw: UnsafeRawBufferPointer) -> UnsafeRawBufferPointer {
+        var count = raw.count
+        while count > 0 && (raw[count - 1] == 0 || raw[count - 1] == 0x20) {
+            count -= 1
+        }
+        return UnsafeRawBufferPointer(rebasing: raw[0..<count])
+    }
+
+    private static func hash(_ value: UnsafeRawBufferPointer) -> UInt32 {
+        var hash: UInt32 = 2_166_136_261
+        for byte in value {
+            hash = (hash ^ UInt32(byte)) &* 16_777_619
+        }
+        return hash
+    }
+}
+
+// 전송 구문 검사, 표현 컨텍스트 협상 등에서 자주 비교하는 UID
+// 공유 테이블에 가장 먼저 등록되므로 핸들 값이 항상 같음
+enum WellKnownUID {
+    static let all: [String] = [
+        DicomheroUidImplicitVRLittleEndian_1_2_840_10008_1_2,
+        DicomheroUidExplicitVRLittleEndian_1_2_840_10008_1_2_1,
+        DicomheroUidDeflatedExplicitVRLittleEndian_1_2_840_10008_1_2_1_99,
+        DicomheroUidJPEGBaselineProcess1_1_2_840_10008_1_2_4_50,
+        DicomheroUidJPEG2000ImageCompressionLosslessOnly_1_2_840_10008_1_2_4_90,
+        DicomheroUidJPEG2000ImageCompression_1_2_840_10008_1_2_4_91,
+        DicomheroUidRLELossless_1_2_840_10008_1_2_5,
+        DicomheroUidVerificationSOPClass_1_2_840_10008_1_1,
+        DicomheroUidCTImageStorage_1_2_840_10008_5_1_4_1_1_2,
+        DicomheroUidEnhancedCTImageStorage_1_2_840_10008_5_1_4_1_1_2_1,
+        DicomheroUidMRImageStorage_1_2_840_10008_5_1_4_1_1_4,
+        DicomheroUidEnhancedMRImageStorage_1_2_840_10008_5_1_4_1_1_4_1,
+        DicomheroUidSecondaryCaptureImageStorage_1_2_840_10008_5_1_4_1_1_7
+    ]
+
+    static let implicitVRLittleEndian = UIDHandle(rawValue: 0)
+    static let explicitVRLittleEndian = UIDHandle(rawValue: 1)
+    static let deflatedExplicitVRLittleEndian = UIDHandle(rawValue: 2)
+    static let jpegBaseline = UIDHandle(rawValue: 3)
+    static let jpeg2000Lossless = UIDHandle(rawValue: 4)
+    static let jpeg2000 = UIDHandle(rawValue: 5)
+    static let rleLossless = UIDHandle(rawValue: 6)
+    static let verification = UIDHandle(rawValue: 7)
+    static let ctImageStorage = UIDHandle(rawValue: 8)
+    static let enhancedCTImageStorage = UIDHandle(rawValue: 9)
+    static let mrImageStorage = UIDHandle(rawValue: 10)
+    static let enhancedMRImageStorage = UIDHandle(rawValue: 11)
+    static let secondaryCaptureImageStorage = UIDHandle(rawValue: 12)
+
+    // 잘 알려진 핸들의 UID 문자열 (고정 목록에서 바로 꺼내므로 잠금과 할당이 없음)
+    static func string(for handle: UIDHandle) -> String {
+        all[Int(handle.rawValue)]
+    }
+
+    // 압축되지 않은 전송 구문인지 (정수 비교만 사용)
+    static func isUncompressed(_ transferSyntax: UIDHandle) -> Bool {
+        transferSyntax == implicitVRLittleEndian || transferSyntax == explicitVRLittleEndian
+    }
+}
+
+// 대량의 인스턴스를 검사/시리즈/인스턴스 UID 핸들로만 보관하는 색인
+// 인스턴스 하나에 핸들 4개(16바이트)만 쓰고 UID 문자열은 테이블에 한 번만 저장
+struct InstanceUIDIndex {
+    let table: UIDTable
+    private(set) var studies: [UIDHandle] = []
+    private(set) var series: [UIDHandle] = []
+    private(set) var instances: [UIDHandle] = []
+    private(set) var sopClasses: [UIDHandle] = []
+
+    // 별도 테이블도 잘 알려진 UID를 먼저 등록해 WellKnownUID 핸들과 값이 같도록 함
+    init(table: UIDTable = UIDTable(preloadingWellKnown: true)) {
+        self.table = table
+    }
+
+    var count: Int { instances.count }
+
+    mutating func append(study: String, series seriesUID: String, instance: String, sopClass: String) {
+        studies.append(table.intern(study))
+        series.append(table.intern(seriesUID))
+        instances.append(table.intern(instance))
+        sopClasses.append(table.intern(sopClass))
+    }
+
+    // 데이터셋에서 UID 네 개를 읽어 추가
+    mutating func append(dataSet: DicomheroDataSet) throws {
+        func uid(_ tag: DicomheroTagEnum) throws -> String {
+            try dataSet.getString(DicomheroTagId(id: tag), elementNumber: 0, defaultValue: "")
+        }
+        append(study: try uid(.enumStudyInstanceUID_0020_000D),
+               series: try uid(.enumSeriesInstanceUID_0020_000E),
+               instance: try uid(.enumSOPInstanceUID_0008_0018),
+               sopClass: try uid(.enumSOPClassUID_0008_0016))
+    }
+
+    // 검사 → 시리즈 → 인스턴스 번호 목록으로 묶음 (문자열 비교 없이 핸들로만)
+    func grouped() -> [UIDHandle: [UIDHandle: [Int]]] {
+        var groups: [UIDHandle: [UIDHandle: [Int]]] = [:]
+        for i in instances.indices {
+            groups[studies[i], default: [:]][series[i], default: []].append(i)
+        }
+        return groups
+    }
+
+    // 인스턴스당 메모리(바이트): 핸들 배열 + 테이블 몫
+    var bytesPerInstance: Double {
+        guard count > 0 else { return 0 }
+        let handles = count * 4 * MemoryLayout<UIDHandle>.stride
+        return Double(handles + table.byteCount) / Double(count)
+    }
+
+    // 같은 내용을 String 네 개로 들고 있을 때의 인스턴스당 메모리 추정
+    // (String 16바이트 + 15바이트를 넘는 UID는 힙 버퍼: 헤더 32바이트 + 내용)
+    var stringBytesPerInstance: Double {
+        guard count > 0 else { return 0 }
+        func size(_ handle: UIDHandle) -> Int {
+            let length = table.string(for: handle).utf8.count
+            return 16 + (length > 15 ? 32 + length : 0)
+        }
+        var total = 0
+        for i in instances.indices {
+            total += size(studies[i]) + size(series[i]) + size(instances[i]) + size(sopClasses[i])
+        }
+        return Double(total) / Double(count)
+    }
+}
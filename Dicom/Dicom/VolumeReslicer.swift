@@ -0,0 +1,186 @@
+//
+//  VolumeReslicer.swift
+//  Dicom
+//
+//  Created by hanjongwoo on 10/19/26.
+//
+
+import UIKit
+import simd
+
+// 볼륨을 자르는 직교 단면 방향
+enum VolumePlane {
+    case axial    // z 고정, 가로 x / 세로 y
+    case coronal  // y 고정, 가로 x / 세로 z
+    case sagittal // x 고정, 가로 y / 세로 z
+
+    // 단면 이미지 크기 (가로, 세로)
+    func imageSize(of volume: VolumeSampling) -> (width: Int, height: Int) {
+        switch self {
+        case .axial: return (volume.width, volume.height)
+        case .coronal: return (volume.width, volume.depth)
+        case .sagittal: return (volume.height, volume.depth)
+        }
+    }
+
+    // 이 방향으로 자를 수 있는 단면 수
+    func sliceCount(of volume: VolumeSampling) -> Int {
+        switch self {
+        case .axial: return volume.depth
+        case .coronal: return volume.height
+        case .sagittal: return volume.width
+        }
+    }
+
+    // 단면 이미지의 화소 간격(mm): 가로, 세로
+    func pixelSpacing(of volume: VolumeSampling) -> SIMD2<Float> {
+        switch self {
+        case .axial: return SIMD2(volume.spacing.x, volume.spacing.y)
+        case .coronal: return SIMD2(volume.spacing.x, volume.spacing.z)
+        case .sagittal: return SIMD2(volume.spacing.y, volume.spacing.z)
+        }
+    }
+
+    // 적재된 슬라이스가 차지하는 단면 이미지의 행 범위 (부분 렌더링 시 VOI 계산에 사용)
+    func coveredRows(of volume: VolumeSampling, coverage: VolumeCoverage) -> ClosedRange<Int>? {
+        switch self {
+        case .axial: return coverage.count > 0 ? 0...(volume.height - 1) : nil
+        case .coronal, .sagittal: return coverage.bounds
+        }
+    }
+
+    // 단면 이미지의 가로(u) 방향이 따라가는 볼륨 축 (0: x, 1: y)
+    var rowAxis: Int {
+        self == .sagittal ? 1 : 0
+    }
+
+    // 단면 이미지 좌표(u, v)와 단면 위치 s를 볼륨 인덱스로 변환
+    @inline(__always)
+    func voxel(u: Int, v: Int, s: Int) -> SIMD3<Int> {
+        switch self {
+        case .axial: return SIMD3(u, v, s)
+        case .coronal: return SIMD3(u, s, v)
+        case .sagittal: return SIMD3(s, u, v)
+        }
+    }
+}
+
+// 볼륨에서 MPR 단면과 MIP 투영 이미지를 생성
+// VolumeSampling만 사용하므로 일반 볼륨과 압축 볼륨 모두에서 동작
+enum VolumeReslicer {
+    // 직교 단면(MPR)
+    // coverage를 지정하면 아직 적재되지 않은 슬라이스의 화소는 적재된 화소의 최솟값으로 채움
+    static func slice(_ volume: VolumeSampling, plane: VolumePlane, index: Int, coverage: VolumeCoverage? = nil) throws -> DicomheroImage {
+        let (width, height) = plane.imageSize(of: volume)
+        let s = min(max(index, 0), plane.sliceCount(of: volume) - 1)
+        var pixels = [Int16](repeating: .min, count: width * height)
+        pixels.withUnsafeMutableBufferPointer { buffer in
+            let output = buffer
+            DispatchQueue.concurrentPerform(iterations: height) { v in
+                let start = plane.voxel(u: 0, v: v, s: s)
+                // 한 행 안에서는 z가 바뀌지 않으므로 적재 여부는 행마다 한 번 확인
+                if let coverage, !coverage.contains(start.z) {
+                    return
+                }
+                volume.line(from: start, axis: plane.rowAxis, count: width, into: output.baseAddress! + v * width)
+            }
+        }
+        if let coverage {
+            fillGaps(&pixels, width: width) { v in coverage.contains(plane.voxel(u: 0, v: v, s: s).z) }
+        }
+        return try makeImage(pixels, width: width, height: height)
+    }
+
+    // 최대 강도 투영(MIP), range를 지정하면 해당 범위의 단면만 투영 (slab MIP)
+    // coverage를 지정하면 적재된 슬라이스만 투영하고, 투영된 슬라이스가 없는 행은 적재된 화소의 최솟값으로 채움
+    // 출력 이미지를 브릭 크기의 타일로 나눠 타일마다 모든 단면을 훑음: 타일과 단면 하나가 브릭 하나에 들어가므로
+    // 작업 스레드마다 한 번에 브릭 하나만 읽고, 같은 브릭을 brickSize장 동안 이어서 씀
+    static func maximumIntensityProjection(_ volume: VolumeSampling, plane: VolumePlane, range: Range<Int>? = nil,
+                                           coverage: VolumeCoverage? = nil) throws -> DicomheroImage {
+        let (width, height) = plane.imageSize(of: volume)
+        let all = 0..<plane.sliceCount(of: volume)
+        let slices = (range ?? all).clamped(to: all)
+        let tile = CompressedVolume.brickSize
+        let tilesU = (width + tile - 1) / tile, tilesV = (height + tile - 1) / tile
+        var pixels = [Int16](repeating: .min, count: width * height)
+        pixels.withUnsafeMutableBufferPointer { buffer in
+            let output = buffer
+            DispatchQueue.concurrentPerform(iterations: tilesU * tilesV) { t in
+                let u0 = (t % tilesU) * tile, v0 = (t / tilesU) * tile
+                let tileWidth = min(tile, width - u0)
+                var line = [Int16](repeating: 0, count: tileWidth)
+                line.withUnsafeMutableBufferPointer { values in
+                    for s in slices {
+                        for v in v0..<min(v0 + tile, height) {
+                            let start = plane.voxel(u: u0, v: v, s: s)
+                            if let coverage, !coverage.contains(start.z) {
+                                continue
+                            }
+                            volume.line(from: start, axis: plane.rowAxis, count: tileWidth, into: values.baseAddress!)
+                            let row = output.baseAddress! + v * width + u0
+                            for u in 0..<tileWidth {
+                                row[u] = max(row[u], values[u])
+                            }
+                        }
+                    }
+                }
+            }
+        }
+        if let coverage {
+            fillGaps(&pixels, width: width) { v in
+                slices.contains { s in coverage.contains(plane.voxel(u: 0, v: v, s: s).z) }
+            }
+        }
+        return try makeImage(pixels, width: width, height: height)
+    }
+
+    // 적재되지 않은 행을 적재된 행의 최솟값으로 채움
+    // Int16.min으로 남겨 두면 적재 범위 안의 빈 슬라이스가 getOptimalVOI의 최솟값을 끌어내려 창이 넓어짐
+    private static func fillGaps(_ pixels: inout [Int16], width: Int, isCovered: (Int) -> Bool) {
+        let height = width == 0 ? 0 : pixels.count / width
+        let covered = (0..<height).map(isCovered)
+        guard covered.contains(false) else {
+            return
+        }
+        var minimum = Int16.max
+        for v in 0..<height where covered[v] {
+            for value in pixels[(v * width)..<((v + 1) * width)] where value < minimum {
+                minimum = value
+            }
+        }
+        let fill = covered.contains(true) ? minimum : 0
+        for v in 0..<height where !covered[v] {
+            pixels.replaceSubrange((v * width)..<((v + 1) * width), with: repeatElement(fill, count: width))
+        }
+    }
+
+    // 단면 이미지를 화면에 표시할 수 있도록 변환
+    // VOI를 지정하지 않으면 이미지에서 최적의 VOI를 계산 (rows를 지정하면 해당 행 범위에서만 계산)
+    static func render(_ image: DicomheroImage, voi: DicomheroVOIDescription? = nil, rows: ClosedRange<Int>? = nil) throws -> UIImage? {
+        let chain = DicomheroTransformsChain()
+        let top = UInt32(rows?.lowerBound ?? 0)
+        let rowCount = rows.map { UInt32($0.count) } ?? image.height
+        let voiDescription = try voi ?? DicomheroVOILUT.getOptimalVOI(image, inputTopLeftX: 0, inputTopLeftY: top, inputWidth: image.width, inputHeight: rowCount)
+        chain!.add(DicomheroVOILUT(voiDescription: voiDescription))
+        let draw = DicomheroDrawBitmap(transform: chain)
+        // RGBA 비트맵 변환 중 사용하는 메모리를 기록
+        return try MemoryGovernor.shared.track(Int(image.width) * Int(image.height) * 4, in: .bitmaps) {
+            try draw?.getDicomheroImage(image)
+        }
+    }
+
+    // Int16 화소 배열로 MONOCHROME2 S16 이미지를 만듦
+    static func makeImage(_ pixels: [Int16], width: Int, height: Int) throws -> DicomheroImage {
+        let image: DicomheroImage = DicomheroImage(width: UInt32(width), height: UInt32(height), depth: .s16, colorSpace: "MONOCHROME2", highBit: 15)
+        try writePixels(pixels, to: image)
+        return image
+    }
+
+    private static func writePixels(_ pixels: [Int16], to image: DicomheroImage) throws {
+        let handler = try image.getWritingDataHandler()
+        try pixels.withUnsafeBytes { bytes in
+            try handler.assign(Data(bytes))
+        }
+        handler.commit()
+    }
+}
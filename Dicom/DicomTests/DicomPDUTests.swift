@@ -0,0 +1,55 @@
+//
+//  DicomPDUTests.swift
+//  DicomTests
+//
+//  Created by hanjongwoo on 10/19/26.
+//
+
+import XCTest
+@testable import Dicom
+
+final class DicomPDUTests: XCTestCase {
+    private let command = [UInt8](repeating: 0xC0, count: 20)
+    private let dataSet = (0..<100).map { UInt8($0) }
+
+    // PDU 본문(PDV 머리 6바이트 + 조각)이 최대 길이를 넘지 않고, 조각을 이으면 원래 바이트가 되어야 함
+    func testFragmentsFitMaxPDULength() throws {
+        for maxPDULength in [7, 8, 26, 50, 106] {
+            let pdus = try PDataTransfer.encode(contextID: 1, command: command, dataSet: dataSet, maxPDULength: maxPDULength)
+            var commandBytes: [UInt8] = [], dataSetBytes: [UInt8] = []
+            for (index, pdu) in pdus.enumerated() {
+                let body = Array(pdu.dropFirst(6))
+                XCTAssertLessThanOrEqual(body.count, maxPDULength)
+                let pdvs = try PDataTransfer.pdvs(in: body)
+                XCTAssertEqual(pdvs.count, 1)
+                for pdv in pdvs {
+                    XCTAssertEqual(pdv.contextID, 1)
+                    if pdv.isCommand {
+                        commandBytes += pdv.data
+                    } else {
+                        dataSetBytes += pdv.data
+                    }
+                    // 명령과 데이터셋 각각의 마지막 조각에만 isLast
+                    let lastOfKind = index == pdus.count - 1 || (pdv.isCommand && commandBytes.count == command.count)
+                    XCTAssertEqual(pdv.isLast, lastOfKind, "maxPDULength \(maxPDULength), PDU \(index)")
+                }
+            }
+            XCTAssertEqual(commandBytes, command)
+            XCTAssertEqual(dataSetBytes, dataSet)
+        }
+    }
+
+    func testZeroMaxPDULengthIsUnlimited() throws {
+        let pdus = try PDataTransfer.encode(contextID: 3, command: command, dataSet: dataSet, maxPDULength: 0)
+        XCTAssertEqual(pdus.count, 2)
+    }
+
+    func testMaxPDULengthWithoutRoomForDataIsRejected() {
+        for maxPDULength in 1...6 {
+            XCTAssertFalse(PDataTransfer.canFragment(maxPDULength: maxPDULength))
+            XCTAssertThrowsError(try PDataTransfer.encode(contextID: 1, command: command, dataSet: nil, maxPDULength: maxPDULength))
+        }
+        XCTAssertTrue(PDataTransfer.canFragment(maxPDULength: 0))
+        XCTAssertTrue(PDataTransfer.canFragment(maxPDULength: 7))
+    }
+}
@@ -0,0 +1,155 @@
+//
+//  DimseTests.swift
+//  DicomTests
+//
+//  Created by hanjongwoo on 10/19/26.
+//
+
+import XCTest
+@testable import Dicom
+
+final class DimseTests: XCTestCase {
+    private var directory: URL!
+
+    override func setUpWithError() throws {
+        directory = try TestFixtures.temporaryDirectory("DimseTests")
+    }
+
+    override func tearDownWithError() throws {
+        try? FileManager.default.removeItem(at: directory)
+    }
+
+    private func associate(port: Int, calledAET: String) throws -> (stream: DicomheroTCPStream, association: DicomheroAssociationSCU) {
+        let stream = try DicomheroTCPStream(address: DicomheroTCPActiveAddress(node: "127.0.0.1", service: String(port)))
+        let association = try DicomheroAssociationSCU(
+            thisAET: "TESTSCU", otherAET: calledAET,
+            maxInvokedOperations: 1, maxPerformedOperations: 1,
+            presentationContexts: StorageSCP.presentationContexts(),
+            reader: DicomheroStreamReader(inputStream: stream.getStreamInput()),
+            writer: DicomheroStreamWriter(outputStream: stream.getStreamOutput()),
+            dimseTimeoutSeconds: 10)
+        return (stream, association)
+    }
+
+    private func find(_ service: DicomheroDimseService, level: QueryLevel,
+                      _ keys: [(DicomheroTagEnum, String)]) throws -> (status: DicomheroDimseStatus, identifiers: [DicomheroDataSet]) {
+        let identifier = DicomheroDataSet(transferSyntax: TransferSyntaxKind.explicitLittleEndian)
+        try identifier.setString(DicomheroTagId(id: .enumQueryRetrieveLevel_0008_0052), newValue: level.rawValue)
+        for (tag, value) in keys {
+            try identifier.setString(DicomheroTagId(id: tag), newValue: value)
+        }
+        let abstractSyntax = DicomheroUidStudyRootQueryRetrieveInformationModelFIND_1_2_840_10008_5_1_4_1_2_2_1
+        let command = DicomheroCFindCommand(abstractSyntax: abstractSyntax, messageID: service.getNextCommandID(),
+                                            priority: .medium, affectedSopClassUid: abstractSyntax, identifier: identifier)
+        try service.sendCommandOrResponse(command)
+        var identifiers: [DicomheroDataSet] = []
+        while true {
+            let response = try service.getCFindResponse(command)
+            guard response.status == .pending else {
+                return (response.status, identifiers)
+            }
+            identifiers.append(try response.getPayloadDataSet())
+        }
+    }
+
+    // C-ECHO, C-STORE 뒤 같은 연결에서 C-FIND로 저장한 인스턴스를 찾음
+    func testEchoStoreAndFindRoundTrip() throws {
+        let received = directory.appendingPathComponent("received")
+        try FileManager.default.createDirectory(at: received, withIntermediateDirectories: true)
+        let scp = StorageSCP(configuration: StorageSCP.Configuration(port: 11136, directory: received, maxAssociations: 2),
+                             catalogue: StudyCatalogue())
+        try scp.start()
+        defer { scp.stop() }
+
+        let connection = try associate(port: 11136, calledAET: scp.configuration.aeTitle)
+        let service = DicomheroDimseService(association: connection.association)
+
+        let verification = WellKnownUID.string(for: WellKnownUID.verification)
+        let echo = DicomheroCEchoCommand(abstractSyntax: verification, messageID: service.getNextCommandID(),
+                                         priority: .medium, affectedSopClassUid: verification)
+        try service.sendCommandOrResponse(echo)
+        XCTAssertEqual(try service.getCEchoResponse(echo).status, .success)
+
+        for instance in 0..<2 {
+            let dataSet = try TestFixtures.dataSet(instance: instance, patientID: "ROUNDTRIP")
+            let sopClassUID = WellKnownUID.string(for: WellKnownUID.ctImageStorage)
+            let store = DicomheroCStoreCommand(
+                abstractSyntax: sopClassUID, messageID: service.getNextCommandID(), priority: .medium,
+                affectedSopClassUid: sopClassUID, affectedSopInstanceUid: TestFixtures.instanceUID(instance),
+                originatorAET: "", originatorMessageID: 0, payload: dataSet)
+            try service.sendCommandOrResponse(store)
+            XCTAssertEqual(try service.getCStoreResponse(store).status, .success)
+        }
+
+        let studies = try find(service, level: .study, [
+            (.enumPatientID_0010_0020, "ROUNDTRIP"), (.enumStudyInstanceUID_0020_000D, ""),
+            (.enumModalitiesInStudy_0008_0061, ""), (.enumNumberOfStudyRelatedInstances_0020_1208, "")
+        ])
+        XCTAssertEqual(studies.status, .success)
+        XCTAssertEqual(studies.identifiers.count, 1)
+        if let study = studies.identifiers.first {
+            XCTAssertEqual(try TestFixtures.string(study, .enumStudyInstanceUID_0020_000D), "\(TestFixtures.uidRoot).1.1")
+            XCTAssertEqual(try TestFixtures.string(study, .enumModalitiesInStudy_0008_0061), "CT")
+            XCTAssertEqual(try TestFixtures.string(study, .enumNumberOfStudyRelatedInstances_0020_1208), "2")
+        }
+
+        let images = try find(service, level: .image, [
+            (.enumStudyInstanceUID_0020_000D, "\(TestFixtures.uidRoot).1.1"), (.enumSOPInstanceUID_0008_0018, "")
+        ])
+        XCTAssertEqual(images.status, .success)
+        XCTAssertEqual(try images.identifiers.map { try TestFixtures.string($0, .enumSOPInstanceUID_0008_0018) }.sorted(),
+                       [TestFixtures.instanceUID(0), TestFixtures.instanceUID(1)])
+
+        let none = try find(service, level: .study, [(.enumPatientID_0010_0020, "NOBODY")])
+        XCTAssertEqual(none.status, .success)
+        XCTAssertTrue(none.identifiers.isEmpty)
+
+        try connection.association.release()
+        withExtendedLifetime(connection.stream) {}
+    }
+
+    // 카탈로그가 없는 SCP는 C-FIND를 지원하지 않는다고 답하고, 연결은 그대로 써야 함
+    func testFindWithoutCatalogueIsRefused() throws {
+        let received = directory.appendingPathComponent("received")
+        try FileManager.default.createDirectory(at: received, withIntermediateDirectories: true)
+        let scp = StorageSCP(configuration: StorageSCP.Configuration(port: 11137, directory: received, maxAssociations: 2))
+        try scp.start()
+        defer { scp.stop() }
+
+        let connection = try associate(port: 11137, calledAET: scp.configuration.aeTitle)
+        let service = DicomheroDimseService(association: connection.association)
+        let result = try find(service, level: .study, [(.enumPatientID_0010_0020, "")])
+        XCTAssertNotEqual(result.status, .success)
+        XCTAssertTrue(result.identifiers.isEmpty)
+
+        let verification = WellKnownUID.string(for: WellKnownUID.verification)
+        let echo = DicomheroCEchoCommand(abstractSyntax: verification, messageID: service.getNextCommandID(),
+                                         priority: .medium, affectedSopClassUid: verification)
+        try service.sendCommandOrResponse(echo)
+        XCTAssertEqual(try service.getCEchoResponse(echo).status, .success)
+        try connection.association.release()
+        withExtendedLifetime(connection.stream) {}
+    }
+
+    // 하네스의 각 작업이 두 전송 방식 모두에서 실패 없이 끝나야 함
+    func testBenchmarkWorkloadsSucceed() throws {
+        let source = directory.appendingPathComponent("source")
+        try FileManager.default.createDirectory(at: source, withIntermediateDirectories: true)
+        let urls = try (0..<2).map { try TestFixtures.write(instance: $0, to: source) }
+
+        for (transport, port) in [(DimseTransport.tcp, 11140), (DimseTransport.pipe, 11142)] {
+            var configuration = DimseBenchmark.Configuration()
+            configuration.transport = transport
+            configuration.concurrency = 2
+            configuration.operationsPerClient = 5
+            configuration.port = port
+            configuration.syntheticStudies = 100
+            let results = DimseBenchmark.run(urls: urls, configuration: configuration)
+            XCTAssertEqual(results.map(\.workload), [.echo, .store, .find, .move], transport.rawValue)
+            for result in results {
+                XCTAssertEqual(result.operations, 10, "\(transport.rawValue) \(result.workload.rawValue)")
+                XCTAssertEqual(result.failures, 0, "\(transport.rawValue) \(result.workload.rawValue)")
+            }
+        }
+    }
+}
@@ -0,0 +1,89 @@
+//
+//  StorageSCPTests.swift
+//  DicomTests
+//
+//  Created by hanjongwoo on 10/19/26.
+//
+
+import XCTest
+@testable import Dicom
+
+final class StorageSCPTests: XCTestCase {
+    private var directory: URL!
+
+    override func setUpWithError() throws {
+        directory = try TestFixtures.temporaryDirectory("StorageSCPTests")
+    }
+
+    override func tearDownWithError() throws {
+        try? FileManager.default.removeItem(at: directory)
+    }
+
+    private func makeSource(instances: Int) throws -> [URL] {
+        let source = directory.appendingPathComponent("source")
+        try FileManager.default.createDirectory(at: source, withIntermediateDirectories: true)
+        return try (0..<instances).map { try TestFixtures.write(instance: $0, to: source) }
+    }
+
+    private func makeSCP(port: Int, catalogue: StudyCatalogue? = nil) throws -> StorageSCP {
+        let received = directory.appendingPathComponent("received")
+        try FileManager.default.createDirectory(at: received, withIntermediateDirectories: true)
+        return StorageSCP(configuration: StorageSCP.Configuration(port: port, directory: received, maxAssociations: 4),
+                          catalogue: catalogue)
+    }
+
+    // 연결마다 UID를 바꿔 보낸 인스턴스가 모두 저장되고, 저장된 파일의 (0008,0018)과 화소가 보낸 것과 같아야 함
+    func testStoredInstancesReadBackWithTheirOwnUID() throws {
+        let urls = try makeSource(instances: 2)
+        let catalogue = StudyCatalogue()
+        let scp = try makeSCP(port: 11131, catalogue: catalogue)
+        try scp.start()
+        let instances = StorageLoadGenerator.load(urls: urls)
+        XCTAssertEqual(instances.count, 2)
+
+        let stored = StorageLoadGenerator.send(instances, port: 11131, calledAET: scp.configuration.aeTitle,
+                                               associations: 2, instancesPerAssociation: 3)
+        scp.stop()
+        XCTAssertEqual(stored, 6)
+        XCTAssertEqual(scp.writeBehind.writtenFiles, 6)
+        XCTAssertEqual(scp.writeBehind.failedWrites, 0)
+        XCTAssertEqual(catalogue.instanceCount, 6)
+
+        for association in 0..<2 {
+            for i in 0..<3 {
+                let instance = i % instances.count
+                let uid = "\(TestFixtures.instanceUID(instance)).\(association).\(i)"
+                let url = scp.configuration.directory.appendingPathComponent(uid + ".dcm")
+                let dataSet = try DicomheroCodecFactory.load(fromFile: url.path)
+                XCTAssertEqual(try TestFixtures.string(dataSet, .enumSOPInstanceUID_0008_0018), uid)
+                XCTAssertEqual(try TestFixtures.string(dataSet, .enumSOPClassUID_0008_0016),
+                               WellKnownUID.string(for: WellKnownUID.ctImageStorage))
+                let pixels = try dataSet.getImage(0).getReadingDataHandler()
+                for index in [0, 9, TestFixtures.size * TestFixtures.size - 1] {
+                    XCTAssertEqual(try pixels.getUnsignedLong(UInt32(index)), TestFixtures.pixel(instance: instance, index: index))
+                }
+            }
+        }
+    }
+
+    // 저장된 인스턴스는 카탈로그에서 받은 UID와 파일 이름으로 찾을 수 있어야 함
+    func testStoredInstancesAreCatalogued() throws {
+        let urls = try makeSource(instances: 3)
+        let catalogue = StudyCatalogue()
+        let scp = try makeSCP(port: 11132, catalogue: catalogue)
+        try scp.start()
+        let stored = StorageLoadGenerator.send(StorageLoadGenerator.load(urls: urls), port: 11132,
+                                               calledAET: scp.configuration.aeTitle, associations: 1, instancesPerAssociation: 3)
+        scp.stop()
+        XCTAssertEqual(stored, 3)
+
+        var query = CatalogueQuery(level: .image)
+        query.studyUID = "\(TestFixtures.uidRoot).1.1"
+        let items = catalogue.retrieveItems(query)
+        XCTAssertEqual(items.count, 3)
+        for item in items {
+            XCTAssertEqual(item.fileName, item.sopInstanceUID + ".dcm")
+            XCTAssertTrue(FileManager.default.fileExists(atPath: scp.configuration.directory.appendingPathComponent(item.fileName).path))
+        }
+    }
+}
@@ -0,0 +1,192 @@
+//
+//  StudyCatalogueTests.swift
+//  DicomTests
+//
+//  Created by hanjongwoo on 10/19/26.
+//
+
+import XCTest
+@testable import Dicom
+
+final class StudyCatalogueTests: XCTestCase {
+    private var catalogue: StudyCatalogue!
+
+    // 환자 3명, 검사 4개, 시리즈 5개, 인스턴스 9개
+    // P1: 검사 1(20240105, ACC100, CT 2장 + MR 1장), 검사 2(20240310, ACC200, CT 1장)
+    // P2: 검사 3(20250101, XACC300, MR 2장)
+    // P3: 검사 4(날짜 없음, 접수 번호 없음, US 3장)
+    override func setUp() {
+        catalogue = StudyCatalogue()
+        let rows: [(patient: String, name: String, study: Int, date: String, accession: String,
+                    series: Int, modality: String, instances: Int)] = [
+            ("P1", "KIM^MINSU", 1, "20240105", "ACC100", 1, "CT", 2),
+            ("P1", "KIM^MINSU", 1, "20240105", "ACC100", 2, "MR", 1),
+            ("P1", "KIM^MINSU", 2, "20240310", "ACC200", 3, "CT", 1),
+            ("P2", "LEE^JIHO", 3, "20250101", "XACC300", 4, "MR", 2),
+            ("P3", "PARK^SORA", 4, "", "", 5, "US", 3)
+        ]
+        var instance = 0
+        for row in rows {
+            for number in 0..<row.instances {
+                var entry = StudyCatalogue.Entry()
+                entry.patientID = row.patient
+                entry.patientName = row.name
+                entry.studyUID = "2.25.1.\(row.study)"
+                entry.studyDate = row.date
+                entry.accessionNumber = row.accession
+                entry.seriesUID = "2.25.2.\(row.series)"
+                entry.modality = row.modality
+                entry.seriesNumber = Int32(row.series)
+                entry.instanceUID = "2.25.3.\(instance)"
+                entry.sopClassUID = WellKnownUID.string(for: WellKnownUID.ctImageStorage)
+                entry.instanceNumber = Int32(number + 1)
+                catalogue.insert(entry)
+                instance += 1
+            }
+        }
+    }
+
+    private func studyUIDs(_ query: CatalogueQuery) -> [String] {
+        catalogue.search(query).compactMap {
+            catalogue.value(DicomheroTagEnum.enumStudyInstanceUID_0020_000D.rawValue, for: $0, level: query.level)
+        }.sorted()
+    }
+
+    func testInsertIgnoresDuplicateInstances() {
+        var entry = StudyCatalogue.Entry()
+        entry.studyUID = "2.25.1.1"
+        entry.seriesUID = "2.25.2.1"
+        entry.instanceUID = "2.25.3.0"
+        catalogue.insert(entry)
+        XCTAssertEqual(catalogue.instanceCount, 9)
+    }
+
+    func testExactPatientID() {
+        var query = CatalogueQuery()
+        query.patientID = ValueMatcher("P1")
+        XCTAssertEqual(studyUIDs(query), ["2.25.1.1", "2.25.1.2"])
+        query.patientID = ValueMatcher("P")
+        XCTAssertEqual(studyUIDs(query), [])
+    }
+
+    func testWildcardPatientName() {
+        var query = CatalogueQuery()
+        query.patientName = ValueMatcher("*SO?A")
+        XCTAssertEqual(studyUIDs(query), ["2.25.1.4"])
+        query.patientName = ValueMatcher("KIM*")
+        XCTAssertEqual(studyUIDs(query), ["2.25.1.1", "2.25.1.2"])
+        query.patientName = ValueMatcher("*")
+        XCTAssertEqual(studyUIDs(query).count, 4)
+    }
+
+    func testAccessionNumber() {
+        var query = CatalogueQuery()
+        query.accessionNumber = ValueMatcher("ACC200")
+        XCTAssertEqual(studyUIDs(query), ["2.25.1.2"])
+        // 접두어가 없는 와일드카드도 정렬 목록 전체에서 찾아야 함
+        query.accessionNumber = ValueMatcher("*ACC?00")
+        XCTAssertEqual(studyUIDs(query), ["2.25.1.1", "2.25.1.2", "2.25.1.3"])
+        query.accessionNumber = ValueMatcher("ACC*")
+        XCTAssertEqual(studyUIDs(query), ["2.25.1.1", "2.25.1.2"])
+        query.accessionNumber = ValueMatcher("NONE")
+        XCTAssertEqual(studyUIDs(query), [])
+    }
+
+    // 검사 수준의 모달리티 조건은 검사 안의 시리즈 하나라도 맞으면 됨
+    func testModalitiesInStudy() {
+        var query = CatalogueQuery()
+        query.modality = ValueMatcher("MR")
+        XCTAssertEqual(studyUIDs(query), ["2.25.1.1", "2.25.1.3"])
+        query.modality = ValueMatcher("?S")
+        XCTAssertEqual(studyUIDs(query), ["2.25.1.4"])
+        let match = catalogue.search(CatalogueQuery())
+            .first { catalogue.value(DicomheroTagEnum.enumStudyInstanceUID_0020_000D.rawValue, for: $0, level: .study) == "2.25.1.1" }
+        XCTAssertEqual(match.flatMap { catalogue.value(DicomheroTagEnum.enumModalitiesInStudy_0008_0061.rawValue, for: $0, level: .study) },
+                       "CT\\MR")
+    }
+
+    func testStudyDateRange() {
+        var query = CatalogueQuery()
+        query.studyDates = CatalogueQuery.dateRange("20240101-20241231")
+        XCTAssertEqual(studyUIDs(query), ["2.25.1.1", "2.25.1.2"])
+        query.studyDates = CatalogueQuery.dateRange("20240310")
+        XCTAssertEqual(studyUIDs(query), ["2.25.1.2"])
+        query.studyDates = CatalogueQuery.dateRange("20240311-")
+        XCTAssertEqual(studyUIDs(query), ["2.25.1.3"])
+        query.studyDates = CatalogueQuery.dateRange("-20240105")
+        XCTAssertEqual(studyUIDs(query), ["2.25.1.1", "2.25.1.4"])
+        XCTAssertNil(CatalogueQuery.dateRange("20250101-20240101"))
+    }
+
+    // 환자 수준은 검사가 여러 개여도 환자마다 한 번만 답함
+    func testPatientLevelAnswersEachPatientOnce() {
+        let query = CatalogueQuery(level: .patient)
+        let patients = catalogue.search(query).compactMap {
+            catalogue.value(DicomheroTagEnum.enumPatientID_0010_0020.rawValue, for: $0, level: .patient)
+        }
+        XCTAssertEqual(patients.sorted(), ["P1", "P2", "P3"])
+    }
+
+    func testSeriesLevel() {
+        var query = CatalogueQuery(level: .series)
+        query.studyUID = "2.25.1.1"
+        let matches = catalogue.search(query)
+        XCTAssertEqual(matches.count, 2)
+        XCTAssertEqual(matches.compactMap { catalogue.value(DicomheroTagEnum.enumNumberOfSeriesRelatedInstances_0020_1209.rawValue, for: $0, level: .series) }.sorted(),
+                       ["1", "2"])
+        query.modality = ValueMatcher("CT")
+        XCTAssertEqual(catalogue.search(query).compactMap { catalogue.value(DicomheroTagEnum.enumSeriesInstanceUID_0020_000E.rawValue, for: $0, level: .series) },
+                       ["2.25.2.1"])
+    }
+
+    func testImageLevel() {
+        var query = CatalogueQuery(level: .image)
+        query.seriesUID = "2.25.2.5"
+        XCTAssertEqual(catalogue.search(query).count, 3)
+        XCTAssertEqual(catalogue.search(query, limit: 2).count, 2)
+
+        query = CatalogueQuery(level: .image)
+        query.instanceUID = "2.25.3.3"
+        let matches = catalogue.search(query)
+        XCTAssertEqual(matches.count, 1)
+        XCTAssertEqual(matches.first.flatMap { catalogue.value(DicomheroTagEnum.enumStudyInstanceUID_0020_000D.rawValue, for: $0, level: .image) },
+                       "2.25.1.2")
+        // 인스턴스 UID가 있어도 다른 조건이 맞지 않으면 답하지 않음
+        query.patientID = ValueMatcher("P2")
+        XCTAssertEqual(catalogue.search(query).count, 0)
+    }
+
+    // 삽입 뒤에 들어온 값도 다음 검색의 와일드카드 결과에 들어가야 함
+    func testValuesInsertedAfterSearchAreFound() {
+        var query = CatalogueQuery()
+        query.accessionNumber = ValueMatcher("B*")
+        XCTAssertEqual(studyUIDs(query), [])
+        var entry = StudyCatalogue.Entry()
+        entry.patientID = "P4"
+        entry.studyUID = "2.25.1.5"
+        entry.accessionNumber = "B1"
+        entry.seriesUID = "2.25.2.6"
+        entry.modality = "CR"
+        entry.instanceUID = "2.25.3.100"
+        catalogue.insert(entry)
+        XCTAssertEqual(studyUIDs(query), ["2.25.1.5"])
+        query = CatalogueQuery()
+        query.patientID = ValueMatcher("P?")
+        XCTAssertEqual(studyUIDs(query).count, 5)
+    }
+
+    // C-FIND 식별자에서 조건을 읽음 (빈 값과 *는 조건 없음)
+    func testQueryFromIdentifier() throws {
+        let identifier = DicomheroDataSet(transferSyntax: TransferSyntaxKind.explicitLittleEndian)
+        try identifier.setString(DicomheroTagId(id: .enumQueryRetrieveLevel_0008_0052), newValue: "SERIES")
+        try identifier.setString(DicomheroTagId(id: .enumPatientID_0010_0020), newValue: "P1")
+        try identifier.setString(DicomheroTagId(id: .enumPatientName_0010_0010), newValue: "*")
+        try identifier.setString(DicomheroTagId(id: .enumModality_0008_0060), newValue: "MR")
+        let query = CatalogueQuery(identifier: identifier)
+        XCTAssertEqual(query.level, .series)
+        XCTAssertNil(query.patientName)
+        XCTAssertNil(query.studyUID)
+        XCTAssertEqual(catalogue.search(query).compactMap { catalogue.value(DicomheroTagEnum.enumSeriesInstanceUID_0020_000E.rawValue, for: $0, level: .series) },
+                       ["2.25.2.2"])
+    }
+}
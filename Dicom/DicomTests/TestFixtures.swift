@@ -0,0 +1,70 @@
+//
+//  TestFixtures.swift
+//  DicomTests
+//
+//  Created by hanjongwoo on 10/19/26.
+//
+
+import Foundation
+@testable import Dicom
+
+// 테스트에서 쓰는 작은 CT 인스턴스 (8x8, 16비트 MONOCHROME2)
+// 화소 값은 instance * 100 + 화소 순번이라 읽어 온 파일이 어느 인스턴스인지 화소로도 확인할 수 있음
+enum TestFixtures {
+    static let uidRoot = "1.2.826.0.1.3680043.10.1234.99"
+    static let size = 8
+
+    static func temporaryDirectory(_ name: String) throws -> URL {
+        let directory = FileManager.default.temporaryDirectory.appendingPathComponent("\(name)-\(UUID().uuidString)")
+        try FileManager.default.createDirectory(at: directory, withIntermediateDirectories: true)
+        return directory
+    }
+
+    static func instanceUID(_ instance: Int) -> String {
+        "\(uidRoot).3.\(instance)"
+    }
+
+    static func pixel(instance: Int, index: Int) -> UInt32 {
+        UInt32(instance * 100 + index)
+    }
+
+    static func dataSet(instance: Int, patientID: String = "TEST0001", studyUID: String = "\(uidRoot).1.1",
+                        seriesUID: String = "\(uidRoot).2.1", modality: String = "CT") throws -> DicomheroDataSet {
+        let dataSet = DicomheroDataSet(transferSyntax: TransferSyntaxKind.explicitLittleEndian)
+        let values: [(DicomheroTagEnum, String)] = [
+            (.enumSOPClassUID_0008_0016, WellKnownUID.string(for: WellKnownUID.ctImageStorage)),
+            (.enumSOPInstanceUID_0008_0018, instanceUID(instance)),
+            (.enumPatientID_0010_0020, patientID),
+            (.enumPatientName_0010_0010, "TEST^\(patientID)"),
+            (.enumStudyInstanceUID_0020_000D, studyUID),
+            (.enumStudyDate_0008_0020, "20260101"),
+            (.enumAccessionNumber_0008_0050, "A1"),
+            (.enumSeriesInstanceUID_0020_000E, seriesUID),
+            (.enumModality_0008_0060, modality),
+            (.enumSeriesNumber_0020_0011, "1"),
+            (.enumInstanceNumber_0020_0013, String(instance + 1))
+        ]
+        for (tag, value) in values {
+            try dataSet.setString(DicomheroTagId(id: tag), newValue: value)
+        }
+        let image = DicomheroImage(width: UInt32(size), height: UInt32(size), depth: .u16, colorSpace: "MONOCHROME2", highBit: 15)
+        let handler = try image.getWritingDataHandler()
+        let values16 = (0..<size * size).map { UInt16(pixel(instance: instance, index: $0)) }
+        try values16.withUnsafeBytes { try handler.assign(Data($0)) }
+        handler.commit()
+        try dataSet.setImage(0, image: image, quality: .veryHigh)
+        return dataSet
+    }
+
+    // 인스턴스 파일을 directory/<SOP Instance UID>.dcm로 씀
+    static func write(instance: Int, to directory: URL, patientID: String = "TEST0001") throws -> URL {
+        let url = directory.appendingPathComponent(instanceUID(instance) + ".dcm")
+        try DicomheroCodecFactory.save(toFile: url.path, dataSet: try dataSet(instance: instance, patientID: patientID),
+                                       codecType: .dicom)
+        return url
+    }
+
+    static func string(_ dataSet: DicomheroDataSet, _ tag: DicomheroTagEnum) throws -> String {
+        try dataSet.getString(DicomheroTagId(id: tag), elementNumber: 0)
+    }
+}